@@ -206,6 +206,12 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
       cmdline.get_value("symex-complexity-failed-child-loops-limit"));
   }
 
+  if(cmdline.isset("symex-memory-limit"))
+  {
+    options.set_option(
+      "symex-memory-limit", cmdline.get_value("symex-memory-limit"));
+  }
+
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
@@ -272,6 +278,8 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("arrays-uf", "always");
   else if(cmdline.isset("arrays-uf-never"))
     options.set_option("arrays-uf", "never");
+  else if(cmdline.isset("arrays-uf-lazy"))
+    options.set_option("arrays-uf", "lazy");
 
   if(cmdline.isset("dimacs"))
     options.set_option("dimacs", true);
@@ -288,6 +296,12 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("refine-arithmetic", true);
   }
 
+  if(cmdline.isset("refine-floatbv"))
+  {
+    options.set_option("refine", true);
+    options.set_option("refine-floatbv", true);
+  }
+
   if(cmdline.isset("refine"))
   {
     options.set_option("refine", true);
@@ -424,6 +438,9 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
   options.set_option(
     "symex-cache-dereferences", cmdline.isset("symex-cache-dereferences"));
 
+  if(cmdline.isset("symex-guards"))
+    options.set_option("symex-guards", cmdline.get_value("symex-guards"));
+
   PARSE_OPTIONS_GOTO_TRACE(cmdline, options);
 
   if(cmdline.isset("no-lazy-methods"))
@@ -456,6 +473,44 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
 
   if(cmdline.isset("show-goto-symex-steps"))
     options.set_option("show-goto-symex-steps", true);
+
+  if(cmdline.isset("profile-symex"))
+    options.set_option("profile-symex", true);
+
+  if(cmdline.isset("checkpoint") || cmdline.isset("resume"))
+  {
+    if(cmdline.isset("paths"))
+    {
+      log.error() << "--checkpoint and --resume are not supported with --paths"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(cmdline.isset("symex-driven-lazy-loading"))
+    {
+      log.error() << "--checkpoint and --resume are not supported with "
+                  << "--symex-driven-lazy-loading" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(cmdline.isset("checkpoint"))
+      options.set_option("checkpoint", cmdline.get_value("checkpoint"));
+
+    if(cmdline.isset("checkpoint-interval"))
+    {
+      if(!cmdline.isset("checkpoint"))
+      {
+        log.error() << "--checkpoint-interval requires --checkpoint"
+                    << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+      options.set_option(
+        "checkpoint-interval", cmdline.get_value("checkpoint-interval"));
+    }
+
+    if(cmdline.isset("resume"))
+      options.set_option("resume", cmdline.get_value("resume"));
+  }
 }
 
 /// invoke main modules
@@ -1119,10 +1174,14 @@ void jbmc_parse_optionst::help()
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
     " --refine                     use refinement procedure (experimental)\n"
+    " --refine-floatbv             use refinement procedure for floating-point\n"
+    "                              arithmetic only (experimental)\n"
     HELP_STRING_REFINEMENT
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
     " --arrays-uf-always           always turn arrays into uninterpreted functions\n" // NOLINT(*)
+    " --arrays-uf-lazy             always turn arrays into uninterpreted functions,\n" // NOLINT(*)
+    "                              adding array axioms lazily\n"
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
@@ -60,6 +60,7 @@ class optionst;
   "(no-sat-preprocessor)" \
   "(beautify)" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
+  "(refine-floatbv)" \
   OPT_STRING_REFINEMENT \
   "(16)(32)(64)(LP64)(ILP64)(LLP64)(ILP32)(LP32)" \
   OPT_SHOW_GOTO_FUNCTIONS \
@@ -79,7 +80,7 @@ class optionst;
   OPT_TIMESTAMP \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)" \
   "(ppc-macos)" \
-  "(arrays-uf-always)(arrays-uf-never)" \
+  "(arrays-uf-always)(arrays-uf-never)(arrays-uf-lazy)" \
   "(no-arch)(arch):" \
   OPT_FLUSH \
   JAVA_BYTECODE_LANGUAGE_OPTIONS \
@@ -0,0 +1,79 @@
+#!/usr/bin/env bash
+
+# Usage:
+#   chain.sh cbmc [options] [--from-state|--empty] [-- resume options] main.c
+#
+# Runs cbmc on main.c once without and once with --checkpoint, then resumes
+# from the checkpoint and reports whether the verdicts of the resumed run match
+# those of the first run. With --from-state, the finished equation is removed
+# before resuming, so that symex continues from the last periodic snapshot of
+# its state. With --empty, both are removed. The resumed run uses the options
+# after -- if given, and the same options otherwise.
+
+cbmc=$1
+shift
+
+name=${*:$#}
+options=()
+resume_options=()
+from_state=false
+empty=false
+in_resume_options=false
+for arg in "${@:1:$#-1}"; do
+  if [[ "${in_resume_options}" == "true" ]]; then
+    resume_options+=("${arg}")
+  elif [[ "${arg}" == "--from-state" ]]; then
+    from_state=true
+  elif [[ "${arg}" == "--empty" ]]; then
+    empty=true
+  elif [[ "${arg}" == "--" ]]; then
+    in_resume_options=true
+  else
+    options+=("${arg}")
+  fi
+done
+if [[ "${in_resume_options}" == "false" ]]; then
+  resume_options=("${options[@]}")
+fi
+
+checkpoint_dir=$(mktemp -d)
+trap 'rm -rf "${checkpoint_dir}"' EXIT
+reference_out="${checkpoint_dir}/reference.out"
+checkpoint_out="${checkpoint_dir}/checkpoint.out"
+resume_out="${checkpoint_dir}/resume.out"
+
+verdicts() {
+  grep -E '^\[.*\] .*: (SUCCESS|FAILURE)$|^VERIFICATION' "$1"
+}
+
+"${cbmc}" "${name}" "${options[@]}" > "${reference_out}" 2>&1
+
+"${cbmc}" "${name}" "${options[@]}" \
+  --checkpoint "${checkpoint_dir}" --checkpoint-interval 0 \
+  > "${checkpoint_out}" 2>&1
+if [[ ! -f "${checkpoint_dir}/state.bin" ]]; then
+  echo "no snapshot of the symex state was written"
+fi
+
+if [[ "${from_state}" == "true" || "${empty}" == "true" ]]; then
+  rm -f "${checkpoint_dir}/equation.bin"
+fi
+if [[ "${empty}" == "true" ]]; then
+  rm -f "${checkpoint_dir}/state.bin"
+fi
+
+"${cbmc}" "${name}" "${resume_options[@]}" --resume "${checkpoint_dir}" \
+  > "${resume_out}" 2>&1
+exit_code=$?
+cat "${resume_out}"
+
+if diff <(verdicts "${reference_out}") <(verdicts "${checkpoint_out}") \
+     > /dev/null &&
+   diff <(verdicts "${reference_out}") <(verdicts "${resume_out}") > /dev/null
+then
+  echo "resumed verdicts match"
+else
+  echo "resumed verdicts differ"
+fi
+
+exit ${exit_code}
@@ -0,0 +1,23 @@
+#include <assert.h>
+#include <stdlib.h>
+
+int sum(int *a, int n)
+{
+  int s = 0;
+  for(int i = 0; i < n; ++i)
+    s += a[i];
+  return s;
+}
+
+int main()
+{
+  int n;
+  __CPROVER_assume(n > 0 && n <= 3);
+  int *a = malloc(n * sizeof(int));
+  for(int i = 0; i < n; ++i)
+    a[i] = i;
+  assert(sum(a, n) >= 0);
+  assert(sum(a, n) != 3);
+  free(a);
+  return 0;
+}
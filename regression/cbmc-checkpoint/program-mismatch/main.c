@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int main()
+{
+  int x;
+#ifdef CHANGED
+  __CPROVER_assume(x > 0);
+#endif
+  assert(x != 0);
+  return 0;
+}
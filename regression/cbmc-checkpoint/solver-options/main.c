@@ -0,0 +1,16 @@
+#include <assert.h>
+#include <stdlib.h>
+
+int main()
+{
+  int n;
+  __CPROVER_assume(n > 0 && n <= 3);
+  int *a = malloc(n * sizeof(int));
+  a[0] = n;
+  if(n > 1)
+    a[1] = a[0] + 1;
+  assert(a[0] > 0);
+  assert(n == 1 || a[1] != 3);
+  free(a);
+  return 0;
+}
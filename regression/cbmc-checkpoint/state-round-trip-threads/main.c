@@ -0,0 +1,26 @@
+#include <assert.h>
+#include <pthread.h>
+
+int shared;
+
+void *worker(void *arg)
+{
+  (void)arg;
+  __CPROVER_atomic_begin();
+  shared += 1;
+  __CPROVER_atomic_end();
+  return 0;
+}
+
+int main()
+{
+  pthread_t t;
+  pthread_create(&t, 0, worker, 0);
+  __CPROVER_atomic_begin();
+  shared += 2;
+  __CPROVER_atomic_end();
+  pthread_join(t, 0);
+  assert(shared == 3);
+  assert(shared != 3);
+  return 0;
+}
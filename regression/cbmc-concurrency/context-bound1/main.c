@@ -0,0 +1,21 @@
+int x;
+_Bool done;
+
+void increment()
+{
+  int tmp = x;
+  x = tmp + 1;
+  done = 1;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: increment();
+
+  int tmp = x;
+  x = tmp + 1;
+
+  __CPROVER_assume(done);
+  // an update may be lost
+  __CPROVER_assert(x == 2, "both increments");
+}
@@ -0,0 +1,22 @@
+int x;
+_Bool done;
+
+void increment()
+{
+  __CPROVER_atomic_begin();
+  x = x + 1;
+  __CPROVER_atomic_end();
+  done = 1;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: increment();
+
+  __CPROVER_atomic_begin();
+  x = x + 1;
+  __CPROVER_atomic_end();
+
+  __CPROVER_assume(done);
+  __CPROVER_assert(x == 2, "both increments");
+}
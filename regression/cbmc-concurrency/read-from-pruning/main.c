@@ -0,0 +1,30 @@
+#include <assert.h>
+#include <pthread.h>
+
+int x;
+
+void *writer(void *arg)
+{
+  x = 2;
+  return 0;
+}
+
+int main()
+{
+  // the write of the thread spawned below cannot be read here
+  int r1 = x;
+
+  x = 1;
+  // the initial value has been overwritten unconditionally
+  int r2 = x;
+
+  pthread_t id;
+  pthread_create(&id, 0, writer, 0);
+  int r3 = x;
+
+  assert(r1 == 0);
+  assert(r2 == 1);
+  assert(r3 == 1);
+
+  return 0;
+}
@@ -0,0 +1,20 @@
+int main()
+{
+  int a[100];
+  int b[100] = {1, 2, 3};
+  unsigned i, j;
+  _Bool c;
+
+  __CPROVER_assume(i < 100 && j < 100);
+
+  a[i] = 42;
+  int *p = c ? a : b;
+
+  __CPROVER_assert(a[i] == 42, "stored value");
+  __CPROVER_assert(i == j || a[j] != 42 || b[j] == 42, "other index");
+  __CPROVER_assert(b[1] == 2, "array constant");
+  __CPROVER_assert(!c || p[i] == 42, "conditional array");
+  __CPROVER_assert(c || p[2] == 4, "wrong constant");
+
+  return 0;
+}
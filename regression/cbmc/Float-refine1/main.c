@@ -0,0 +1,34 @@
+#include <assert.h>
+#include <math.h>
+
+float nondet_float(void);
+
+int main(void)
+{
+  float x = nondet_float();
+  float y = nondet_float();
+
+  if(isinf(x) && !isnan(y) && y != 0.0f)
+    assert(isinf(x * y));
+
+  if(x == 0.0f && isfinite(y))
+    assert(x * y == 0.0f);
+
+  if(isnan(x))
+    assert(isnan(x + y) && isnan(x / y));
+
+  if(isinf(x) && isinf(y) && !signbit(x) != !signbit(y))
+    assert(isnan(x + y));
+
+  if(isfinite(x) && y != 0.0f && isfinite(y))
+    assert(!signbit(x / y) == (!signbit(x) == !signbit(y)));
+
+  if(x > 1.0f && y > 1.0f)
+    assert(x * y > 1.0f);
+
+  // fails: 2^24+1 is not representable in single precision
+  if(x == 16777216.0f && y == 1.0f)
+    assert(x + y != x);
+
+  return 0;
+}
@@ -0,0 +1,17 @@
+int main()
+{
+  unsigned a, b;
+
+  // the same value computed in two different ways
+  unsigned sum1 = a + b;
+  unsigned sum2 = (a ^ b) + ((a & b) << 1);
+  __CPROVER_assert(sum1 == sum2, "sums agree");
+
+  unsigned max1 = a < b ? b : a;
+  unsigned max2 = b > a ? b : a;
+  __CPROVER_assert(max1 == max2, "maxima agree");
+
+  __CPROVER_assert(a + b != 10, "sum is not ten");
+
+  return 0;
+}
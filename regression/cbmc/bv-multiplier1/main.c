@@ -0,0 +1,15 @@
+int main()
+{
+  unsigned char x, y;
+
+  // the operands are promoted to int
+  int product = x * y;
+  __CPROVER_assert(product <= 255 * 255, "product is bounded");
+
+  if(y != 0)
+    __CPROVER_assert((x / y) * y + x % y == x, "division is exact");
+
+  __CPROVER_assert(product != 143, "product is not 143");
+
+  return 0;
+}
@@ -0,0 +1,13 @@
+int main()
+{
+  unsigned a, b;
+  __CPROVER_assume(a < 100 && b == a * 3);
+
+  // the trace shows the values of variables that preprocessing eliminated
+  unsigned c = a + b;
+  __CPROVER_assert(c != 40, "c is not 40");
+
+  __CPROVER_assert(b % 3 == 0, "b is a multiple of three");
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+int f(int x)
+{
+  return x * x;
+}
+
+int main()
+{
+  int n;
+  int sum = 0;
+  for(int i = 0; i < 4; ++i)
+    sum += f(n + i);
+  __CPROVER_assert(sum >= 0, "may overflow");
+  return 0;
+}
@@ -0,0 +1,19 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = 0;
+
+  if(x > 0)
+    y = 1;
+  else if(x < 0)
+    y = -1;
+
+  if(x == 0)
+    __CPROVER_assert(y == 0, "zero");
+  else
+    __CPROVER_assert(y != 0, "nonzero");
+
+  __CPROVER_assert(y == 1, "only positive");
+}
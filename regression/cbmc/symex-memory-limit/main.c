@@ -0,0 +1,20 @@
+#include <assert.h>
+
+#define N 1000
+
+int a[N];
+
+int main()
+{
+  int sum = 0;
+  for(int i = 0; i < N; ++i)
+  {
+    int x;
+    if(x == i)
+      return 0;
+    a[i] = x;
+    sum += a[(i * 7) % N];
+  }
+  assert(sum != 42);
+  return 0;
+}
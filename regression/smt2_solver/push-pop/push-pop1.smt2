@@ -0,0 +1,30 @@
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(assert (bvugt a #x10))
+
+(push 1)
+(assert (bvult a #x05))
+(check-sat)
+(pop 1)
+
+(check-sat)
+
+(push 1)
+(declare-fun b () (_ BitVec 8))
+(assert (= b a))
+(assert (= b #x20))
+(check-sat)
+(get-value (a))
+(pop 1)
+
+; b is undeclared again, and may be declared with the same sort
+(push 1)
+(declare-fun b () (_ BitVec 8))
+(assert (= a b))
+(push 1)
+(assert (= b #x01))
+(check-sat)
+(pop 2)
+
+(check-sat-assuming ((= a #x30)))
+(get-value (a))
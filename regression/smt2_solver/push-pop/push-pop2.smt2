@@ -0,0 +1,7 @@
+(set-logic QF_BV)
+(push 1)
+(declare-fun x () (_ BitVec 8))
+(pop 1)
+(declare-fun x () Bool)
+(pop 1)
+(exit)
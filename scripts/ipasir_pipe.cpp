@@ -0,0 +1,97 @@
+/*******************************************************************\
+
+Module: IPASIR solver behind the incremental external SAT protocol
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Serves the line-based protocol of `--external-sat-incremental` (see
+/// src/solvers/sat/external_sat_incremental.h) with any SAT solver that
+/// implements the IPASIR interface. Build it against the solver library,
+/// for example:
+///
+///     g++ -O2 -I<dir of ipasir.h> ipasir_pipe.cpp -o ipasir_pipe \
+///       <path to libipasir.a>
+///
+/// and run `cbmc --external-sat-solver ipasir_pipe --external-sat-incremental`
+
+extern "C"
+{
+#include <ipasir.h>
+}
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Reads literals up to and including the terminating 0
+static std::vector<int> read_literals()
+{
+  std::vector<int> literals;
+  int literal;
+  while(std::cin >> literal && literal != 0)
+    literals.push_back(literal);
+  return literals;
+}
+
+int main()
+{
+  void *solver = ipasir_init();
+  std::ios::sync_with_stdio(false);
+
+  std::string command;
+  while(std::cin >> command)
+  {
+    if(command == "add")
+    {
+      for(const int literal : read_literals())
+        ipasir_add(solver, literal);
+      ipasir_add(solver, 0);
+    }
+    else if(command == "assume")
+    {
+      for(const int literal : read_literals())
+        ipasir_assume(solver, literal);
+    }
+    else if(command == "solve")
+    {
+      const int result = ipasir_solve(solver);
+      std::cout << (result == 10 ? "s SATISFIABLE"
+                                 : result == 20 ? "s UNSATISFIABLE"
+                                                : "s UNKNOWN")
+                << std::endl;
+    }
+    else if(command == "value")
+    {
+      std::cout << 'v';
+      for(const int variable : read_literals())
+      {
+        // variables that are irrelevant to the model are reported as true
+        const int value = ipasir_val(solver, variable);
+        std::cout << ' ' << (value < 0 ? -variable : variable);
+      }
+      std::cout << " 0" << std::endl;
+    }
+    else if(command == "failed")
+    {
+      std::cout << 'f';
+      for(const int literal : read_literals())
+      {
+        if(ipasir_failed(solver, literal))
+          std::cout << ' ' << literal;
+      }
+      std::cout << " 0" << std::endl;
+    }
+    else
+    {
+      std::cerr << "ipasir_pipe: unknown command " << command << '\n';
+      return 1;
+    }
+  }
+
+  ipasir_release(solver);
+  return 0;
+}
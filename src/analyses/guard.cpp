@@ -0,0 +1,142 @@
+/*******************************************************************\
+
+Module: Guard Data Structure
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Guards whose representation is selected at runtime
+
+#include "guard.h"
+
+#include <util/invariant.h>
+
+#include <algorithm>
+
+void guard_managert::output_statistics(messaget &log) const
+{
+  if(!collect_statistics)
+    return;
+
+  messaget::mstreamt &out = log.statistics();
+  out << "Guards: " << statistics.merges << " merges";
+  if(statistics.merges != 0)
+  {
+    out << ", size at most " << statistics.max_size << ", on average "
+        << statistics.total_size / statistics.merges;
+  }
+  out << messaget::eom;
+}
+
+guardt::guardt(const exprt &e, guard_managert &manager) : manager(&manager)
+{
+  if(manager.kind == guard_managert::kindt::BDD)
+    bdd_guard.emplace(e, manager.bdd_manager);
+  else
+    expr_guard.emplace(e, manager.expr_manager);
+}
+
+void guardt::add(const exprt &expr)
+{
+  if(bdd_guard)
+    bdd_guard->add(expr);
+  else
+    expr_guard->add(expr);
+}
+
+void guardt::append(const guardt &guard)
+{
+  PRECONDITION(manager == guard.manager);
+
+  if(bdd_guard)
+    bdd_guard->append(*guard.bdd_guard);
+  else
+    expr_guard->append(*guard.expr_guard);
+}
+
+exprt guardt::as_expr() const
+{
+  return bdd_guard ? bdd_guard->as_expr() : expr_guard->as_expr();
+}
+
+exprt guardt::guard_expr(exprt expr) const
+{
+  return bdd_guard ? bdd_guard->guard_expr(std::move(expr))
+                   : expr_guard->guard_expr(std::move(expr));
+}
+
+bool guardt::is_true() const
+{
+  return bdd_guard ? bdd_guard->is_true() : expr_guard->is_true();
+}
+
+bool guardt::is_false() const
+{
+  return bdd_guard ? bdd_guard->is_false() : expr_guard->is_false();
+}
+
+guardt &operator-=(guardt &g1, const guardt &g2)
+{
+  PRECONDITION(g1.manager == g2.manager);
+
+  if(g1.bdd_guard)
+    *g1.bdd_guard -= *g2.bdd_guard;
+  else
+    *g1.expr_guard -= *g2.expr_guard;
+
+  return g1;
+}
+
+guardt &operator|=(guardt &g1, const guardt &g2)
+{
+  PRECONDITION(g1.manager == g2.manager);
+
+  if(g1.bdd_guard)
+    *g1.bdd_guard |= *g2.bdd_guard;
+  else
+    *g1.expr_guard |= *g2.expr_guard;
+
+  if(g1.manager->collect_statistics)
+  {
+    guard_managert::statisticst &statistics = g1.manager->statistics;
+    const std::size_t size = g1.size();
+    statistics.merges++;
+    statistics.total_size += size;
+    statistics.max_size = std::max(statistics.max_size, size);
+  }
+
+  return g1;
+}
+
+bool guardt::disjunction_may_simplify(const guardt &other_guard)
+{
+  PRECONDITION(manager == other_guard.manager);
+
+  return bdd_guard
+           ? bdd_guard->disjunction_may_simplify(*other_guard.bdd_guard)
+           : expr_guard->disjunction_may_simplify(*other_guard.expr_guard);
+}
+
+guard_exprt guardt::as_guard_expr() const
+{
+  if(expr_guard)
+    return *expr_guard;
+  else
+    return guard_exprt(bdd_guard->as_expr(), manager->expr_manager);
+}
+
+std::size_t guardt::size() const
+{
+  if(bdd_guard)
+    return bdd_guard->size();
+
+  const exprt expr = expr_guard->as_expr();
+  if(expr.is_true())
+    return 0;
+  else if(expr.id() == ID_and)
+    return expr.operands().size();
+  else
+    return 1;
+}
@@ -12,20 +12,130 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_GUARD_H
 #define CPROVER_ANALYSES_GUARD_H
 
-#ifdef BDD_GUARDS
+#include <util/message.h>
+#include <util/optional.h>
+
+#include <solvers/prop/bdd_expr.h>
 
 #include "guard_bdd.h"
+#include "guard_expr.h"
 
-using guard_managert = bdd_exprt;
-using guardt = guard_bddt;
+class guardt;
 
-#else
+/// Holds what the guards of one symbolic execution share, and selects the
+/// representation of these guards at runtime
+class guard_managert
+{
+public:
+  /// Representations of guards
+  enum class kindt
+  {
+    /// Expressions, see \ref guard_exprt
+    EXPR,
+    /// BDDs over the conditions, see \ref guard_bddt
+    BDD
+  };
 
-#include "guard_expr.h"
+  explicit guard_managert(kindt kind = kindt::EXPR) : kind(kind)
+  {
+  }
+
+  guard_managert(const guard_managert &) = delete;
+
+  kindt get_kind() const
+  {
+    return kind;
+  }
+
+  /// Sizes of the guards that result from merging guards, which is where
+  /// guards grow. The size of a guard is the number of conjuncts of an
+  /// expression guard, and the number of nodes of a BDD guard.
+  struct statisticst
+  {
+    std::size_t merges = 0;
+    std::size_t total_size = 0;
+    std::size_t max_size = 0;
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
+  }
+
+  /// Start collecting \ref statisticst, which costs a traversal of each
+  /// merged guard
+  void enable_statistics()
+  {
+    collect_statistics = true;
+  }
+
+  /// Report the \ref statisticst, if they have been collected. Without
+  /// merges, as when paths are explored one at a time, only the number of
+  /// merges is reported.
+  void output_statistics(messaget &log) const;
+
+protected:
+  const kindt kind;
+  guard_expr_managert expr_manager;
+  bdd_exprt bdd_manager;
+  bool collect_statistics = false;
+  statisticst statistics;
+
+  friend class guardt;
+  friend guardt &operator|=(guardt &g1, const guardt &g2);
+};
+
+/// A guard, represented as selected by its \ref guard_managert. All guards
+/// that are combined must have the same manager.
+class guardt
+{
+public:
+  guardt(const exprt &e, guard_managert &manager);
+
+  void add(const exprt &expr);
+  void append(const guardt &guard);
+  exprt as_expr() const;
+
+  /// Whether the result of \ref as_expr is always in a simplified form
+  bool is_always_simplified() const
+  {
+    return bdd_guard.has_value();
+  }
+
+  /// Return `guard => dest` or a simplified variant thereof if either guard or
+  /// dest are trivial.
+  exprt guard_expr(exprt expr) const;
+
+  bool is_true() const;
+  bool is_false() const;
+
+  /// Transforms \p g1 into \c g1' such that `g1' & g2 => g1 => g1'`
+  /// and returns a reference to g1.
+  friend guardt &operator-=(guardt &g1, const guardt &g2);
+
+  friend guardt &operator|=(guardt &g1, const guardt &g2);
+
+  /// Returns true if `operator|=` with \p other_guard may result in a simpler
+  /// expression.
+  bool disjunction_may_simplify(const guardt &other_guard);
+
+  bool is_bdd() const
+  {
+    return bdd_guard.has_value();
+  }
+
+  /// The guard as an expression guard, whose conjuncts are the conditions
+  /// that lead to it only if the guard is represented as an expression
+  guard_exprt as_guard_expr() const;
+
+private:
+  guard_managert *manager;
 
-using guard_managert = guard_expr_managert;
-using guardt = guard_exprt;
+  // exactly one of these is set, according to the kind of the manager
+  optionalt<guard_exprt> expr_guard;
+  optionalt<guard_bddt> bdd_guard;
 
-#endif // BDD_GUARDS
+  std::size_t size() const;
+};
 
 #endif // CPROVER_ANALYSES_GUARD_H
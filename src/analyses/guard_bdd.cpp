@@ -81,6 +81,11 @@ guard_bddt &operator|=(guard_bddt &g1, const guard_bddt &g2)
   return g1;
 }
 
+std::size_t guard_bddt::size() const
+{
+  return manager.size(bdd);
+}
+
 exprt guard_bddt::as_expr() const
 {
   return manager.as_expr(bdd);
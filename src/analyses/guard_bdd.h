@@ -51,6 +51,9 @@ public:
     return bdd.is_false();
   }
 
+  /// The number of nodes of the BDD, including the terminals
+  std::size_t size() const;
+
   /// Transforms \p g1 into \c g1' such that `g1' & g2 => g1 => g1'`
   /// and returns a reference to g1.
   friend guard_bddt &operator-=(guard_bddt &g1, const guard_bddt &g2);
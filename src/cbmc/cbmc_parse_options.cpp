@@ -17,9 +17,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <memory>
 
 #include <util/config.h>
+#include <util/exception_utils.h>
 #include <util/exit_codes.h>
 #include <util/invariant.h>
 #include <util/make_unique.h>
+#include <util/string2int.h>
 #include <util/version.h>
 
 #ifdef _MSC_VER
@@ -52,6 +54,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/add_malloc_may_fail_variable_initializations.h>
 #include <goto-programs/initialize_goto_model.h>
+#include <goto-programs/lazy_sequentialization.h>
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
 #include <goto-programs/process_goto_program.h>
@@ -203,6 +206,28 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("mm"))
     options.set_option("mm", cmdline.get_value("mm"));
 
+  if(cmdline.isset("context-bound"))
+  {
+    if(cmdline.isset("mm") && cmdline.get_value("mm") != "sc")
+    {
+      log.error() << "--context-bound is only supported with --mm sc"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    const auto context_bound =
+      string2optional_unsigned(cmdline.get_value("context-bound"));
+    if(!context_bound.has_value() || *context_bound < 1)
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "the number of contexts must be a positive integer",
+        "--context-bound",
+        "a positive integer such as 2");
+    }
+
+    options.set_option("context-bound", cmdline.get_value("context-bound"));
+  }
+
   if(cmdline.isset("symex-complexity-limit"))
     options.set_option(
       "symex-complexity-limit", cmdline.get_value("symex-complexity-limit"));
@@ -212,6 +237,10 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
       "symex-complexity-failed-child-loops-limit",
       cmdline.get_value("symex-complexity-failed-child-loops-limit"));
 
+  if(cmdline.isset("symex-memory-limit"))
+    options.set_option(
+      "symex-memory-limit", cmdline.get_value("symex-memory-limit"));
+
   if(cmdline.isset("property"))
     options.set_option("property", cmdline.get_values("property"));
 
@@ -305,6 +334,8 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("arrays-uf", "always");
   else if(cmdline.isset("arrays-uf-never"))
     options.set_option("arrays-uf", "never");
+  else if(cmdline.isset("arrays-uf-lazy"))
+    options.set_option("arrays-uf", "lazy");
 
   if(cmdline.isset("dimacs"))
     options.set_option("dimacs", true);
@@ -324,6 +355,12 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("refine-arithmetic", true);
   }
 
+  if(cmdline.isset("refine-floatbv"))
+  {
+    options.set_option("refine", true);
+    options.set_option("refine-floatbv", true);
+  }
+
   if(cmdline.isset("refine"))
   {
     options.set_option("refine", true);
@@ -345,6 +382,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   options.set_option(
     "symex-cache-dereferences", cmdline.isset("symex-cache-dereferences"));
 
+  if(cmdline.isset("symex-guards"))
+    options.set_option("symex-guards", cmdline.get_value("symex-guards"));
+
   if(cmdline.isset("incremental-loop"))
   {
     options.set_option(
@@ -421,6 +461,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option(
       "external-sat-solver", cmdline.get_value("external-sat-solver")),
       solver_set = true;
+
+    if(cmdline.isset("external-sat-incremental"))
+      options.set_option("external-sat-incremental", true);
   }
 
   if(cmdline.isset("yices"))
@@ -461,6 +504,36 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("no-sat-preprocessor"))
     options.set_option("sat-preprocessor", false);
 
+  if(cmdline.isset("cnf-preprocessor"))
+    options.set_option("cnf-preprocessor", true);
+
+  if(cmdline.isset("polarity-aware-cnf"))
+    options.set_option("polarity-aware-cnf", true);
+
+  if(cmdline.isset("aig"))
+    options.set_option("aig", true);
+
+  if(cmdline.isset("aig-sweep"))
+    options.set_option("aig-sweep", true);
+
+  if(cmdline.isset("aig-sweep-time-limit"))
+  {
+    options.set_option(
+      "aig-sweep-time-limit", cmdline.get_value("aig-sweep-time-limit"));
+  }
+
+  if(cmdline.isset("bv-multiplier"))
+    options.set_option("bv-multiplier", cmdline.get_value("bv-multiplier"));
+
+  if(cmdline.isset("bv-divider"))
+    options.set_option("bv-divider", cmdline.get_value("bv-divider"));
+
+  if(cmdline.isset("bv-encoding-min-width"))
+  {
+    options.set_option(
+      "bv-encoding-min-width", cmdline.get_value("bv-encoding-min-width"));
+  }
+
   if(cmdline.isset("no-pretty-names"))
     options.set_option("pretty-names", false);
 
@@ -495,6 +568,37 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("show-goto-symex-steps"))
     options.set_option("show-goto-symex-steps", true);
 
+  if(cmdline.isset("profile-symex"))
+    options.set_option("profile-symex", true);
+
+  if(cmdline.isset("checkpoint") || cmdline.isset("resume"))
+  {
+    if(cmdline.isset("paths"))
+    {
+      log.error() << "--checkpoint and --resume are not supported with --paths"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(cmdline.isset("checkpoint"))
+      options.set_option("checkpoint", cmdline.get_value("checkpoint"));
+
+    if(cmdline.isset("checkpoint-interval"))
+    {
+      if(!cmdline.isset("checkpoint"))
+      {
+        log.error() << "--checkpoint-interval requires --checkpoint"
+                    << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+      options.set_option(
+        "checkpoint-interval", cmdline.get_value("checkpoint-interval"));
+    }
+
+    if(cmdline.isset("resume"))
+      options.set_option("resume", cmdline.get_value("resume"));
+  }
+
   if(cmdline.isset("show-points-to-sets"))
     options.set_option("show-points-to-sets", true);
 
@@ -940,6 +1044,19 @@ bool cbmc_parse_optionst::process_goto_program(
   // this would cause the property identifiers to change.
   label_properties(goto_model);
 
+  // replace threads by bounded context switches
+  if(options.is_set("context-bound"))
+  {
+    log.status() << "Lazy sequentialization" << messaget::eom;
+    if(lazy_sequentialization(
+         goto_model,
+         options.get_unsigned_int_option("context-bound"),
+         log.get_message_handler()))
+    {
+      return true;
+    }
+  }
+
   // reachability slice?
   if(options.get_bool_option("reachability-slice-fb"))
   {
@@ -1020,6 +1137,8 @@ void cbmc_parse_optionst::help()
     HELP_GOTO_CHECK
     HELP_COVER
     " --mm MM                      memory consistency model for concurrent programs (default: sc)\n" // NOLINT(*)
+    " --context-bound K            sequentialize concurrent programs, considering\n" // NOLINT(*)
+    "                              K round-robin rounds of context switches\n" // NOLINT(*)
     HELP_CONFIG_LIBRARY
     HELP_REACHABILITY_SLICER
     HELP_REACHABILITY_SLICER_FB
@@ -1049,14 +1168,38 @@ void cbmc_parse_optionst::help()
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
     " --refine                     use refinement procedure (experimental)\n"
+    " --refine-floatbv             use refinement procedure for floating-point\n"
+    "                              arithmetic only (experimental)\n"
     " --incremental-smt2-solver cmd\n"
     "                              command to invoke external SMT solver for\n"
     "                              incremental solving (experimental)\n"
     " --external-sat-solver cmd    command to invoke SAT solver process\n"
+    " --external-sat-incremental   keep the external SAT solver running and\n"
+    "                              send it the formula incrementally, see\n"
+    "                              scripts/ipasir_pipe.cpp\n"
+    " --cnf-preprocessor           simplify the CNF by variable elimination,\n"
+    "                              subsumption and equivalence substitution\n"
+    "                              before passing it to a SAT solver without\n"
+    "                              a simplifier, e.g., an external solver\n"
+    " --polarity-aware-cnf         only encode gates in the polarities in which\n"
+    "                              they are used (Plaisted-Greenbaum)\n"
+    " --aig                        share equivalent gates via a structurally\n"
+    "                              hashed and-inverter graph before SAT solving\n"
+    " --aig-sweep                  like --aig, and merge gates that random\n"
+    "                              simulation and SAT checks prove equivalent\n"
+    " --aig-sweep-time-limit s     time budget for --aig-sweep (default: 10)\n"
+    " --bv-multiplier encoding     encoding of multiplication: shift-add\n"
+    "                              (default), wallace, dadda, booth or karatsuba\n" // NOLINT(*)
+    " --bv-divider encoding        encoding of division: constraints (default)\n"
+    "                              or non-restoring\n"
+    " --bv-encoding-min-width n    use the default encodings for operands with\n"
+    "                              fewer than n bits\n"
     HELP_STRING_REFINEMENT_CBMC
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
     " --arrays-uf-always           always turn arrays into uninterpreted functions\n" // NOLINT(*)
+    " --arrays-uf-lazy             always turn arrays into uninterpreted functions,\n" // NOLINT(*)
+    "                              adding array axioms lazily\n"
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
@@ -59,9 +59,15 @@ class optionst;
   "(cprover-smt2)" \
   "(incremental-smt2-solver):" \
   "(external-sat-solver):" \
+  "(external-sat-incremental)" \
   "(no-sat-preprocessor)" \
+  "(cnf-preprocessor)" \
+  "(polarity-aware-cnf)" \
+  "(aig)(aig-sweep)(aig-sweep-time-limit):" \
+  "(bv-multiplier):(bv-divider):(bv-encoding-min-width):" \
   "(beautify)" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
+  "(refine-floatbv)" \
   OPT_STRING_REFINEMENT_CBMC \
   OPT_SHOW_GOTO_FUNCTIONS \
   OPT_SHOW_PROPERTIES \
@@ -75,8 +81,9 @@ class optionst;
   OPT_COVER \
   "(symex-coverage-report):" \
   "(mm):" \
+  "(context-bound):" \
   OPT_TIMESTAMP \
-  "(arrays-uf-always)(arrays-uf-never)" \
+  "(arrays-uf-always)(arrays-uf-never)(arrays-uf-lazy)" \
   OPT_FLUSH \
   "(localize-faults)" \
   OPT_GOTO_TRACE \
@@ -25,7 +25,10 @@ Author: Daniel Kroening, Peter Schrammel
 #include <linking/static_lifetime_init.h>
 
 #include <solvers/decision_procedure.h>
+#include <solvers/flattening/bv_pointers.h>
 
+#include <util/config.h>
+#include <util/exception_utils.h>
 #include <util/json_stream.h>
 #include <util/make_unique.h>
 #include <util/ui_message.h>
@@ -159,6 +162,35 @@ void convert_symex_target_equation(
   equation.convert(decision_procedure);
 }
 
+void set_object_bits_from_equation(
+  const symex_target_equationt &equation,
+  decision_proceduret &decision_procedure,
+  message_handlert &message_handler)
+{
+  auto bv_pointers = dynamic_cast<bv_pointerst *>(&decision_procedure);
+  if(bv_pointers == nullptr)
+    return;
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    bv_pointers->number_objects(step.guard);
+    bv_pointers->number_objects(step.cond_expr);
+
+    for(const auto &argument : step.ssa_function_arguments)
+      bv_pointers->number_objects(argument);
+
+    for(const auto &argument : step.io_args)
+      bv_pointers->number_objects(argument);
+  }
+
+  const std::size_t object_bits = bv_pointers->set_object_bits_from_objects();
+
+  messaget log(message_handler);
+  log.status() << "Running with " << object_bits << " object bits, "
+               << config.ansi_c.pointer_width - object_bits
+               << " offset bits (automatic)" << messaget::eom;
+}
+
 std::unique_ptr<memory_model_baset>
 get_memory_model(const optionst &options, const namespacet &ns)
 {
@@ -176,6 +208,23 @@ get_memory_model(const optionst &options, const namespacet &ns)
   }
 }
 
+guard_managert::kindt get_guard_kind(const optionst &options)
+{
+  const std::string guards = options.get_option("symex-guards");
+
+  if(guards.empty() || guards == "expr")
+    return guard_managert::kindt::EXPR;
+  else if(guards == "bdd")
+    return guard_managert::kindt::BDD;
+  else
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "unknown guard representation '" + guards + "'",
+      "--symex-guards",
+      "use one of bdd or expr");
+  }
+}
+
 void setup_symex(
   symex_bmct &symex,
   const namespacet &ns,
@@ -321,6 +370,35 @@ void output_coverage_report(
   }
 }
 
+void output_symex_profile(
+  const optionst &options,
+  const symex_bmct &symex,
+  ui_message_handlert &ui_message_handler)
+{
+  if(!options.get_bool_option("profile-symex"))
+    return;
+
+  messaget log(ui_message_handler);
+
+  switch(ui_message_handler.get_ui())
+  {
+  case ui_message_handlert::uit::PLAIN:
+    log.result() << "Symex profile:\n";
+    symex.get_profile().output_annotated_source(log.result());
+    log.result() << messaget::eom;
+    break;
+
+  case ui_message_handlert::uit::XML_UI:
+    log.error() << "XML UI not supported by --profile-symex" << messaget::eom;
+    break;
+
+  case ui_message_handlert::uit::JSON_UI:
+    ui_message_handler.get_json_stream().push_back(
+      symex.get_profile().to_json());
+    break;
+  }
+}
+
 void postprocess_equation(
   symex_bmct &symex,
   symex_target_equationt &equation,
@@ -370,6 +448,12 @@ std::chrono::duration<double> prepare_property_decider(
     << property_decider.get_decision_procedure().decision_procedure_text()
     << messaget::eom;
 
+  if(config.bv_encoding.is_object_bits_auto)
+  {
+    set_object_bits_from_equation(
+      equation, property_decider.get_decision_procedure(), ui_message_handler);
+  }
+
   convert_symex_target_equation(
     equation, property_decider.get_decision_procedure(), ui_message_handler);
   property_decider.update_properties_goals_from_symex_target_equation(
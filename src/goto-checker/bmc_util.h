@@ -15,6 +15,8 @@ Author: Daniel Kroening, Peter Schrammel
 #include <chrono>
 #include <memory>
 
+#include <analyses/guard.h>
+
 #include <goto-symex/build_goto_trace.h>
 
 #include "incremental_goto_checker.h"
@@ -38,6 +40,15 @@ void convert_symex_target_equation(
   decision_proceduret &decision_procedure,
   message_handlert &message_handler);
 
+/// Sets the number of bits encoding the object part of pointers in
+/// \p decision_procedure, if it uses \ref bv_pointerst, to the least number
+/// that can encode all objects whose address is taken in \p equation.
+/// This needs to be done before \p equation is converted.
+void set_object_bits_from_equation(
+  const symex_target_equationt &equation,
+  decision_proceduret &decision_procedure,
+  message_handlert &message_handler);
+
 /// Returns a function that checks whether an SSA step is an assertion
 /// with \p property_id. Usually used for `build_goto_trace`.
 ssa_step_predicatet
@@ -68,6 +79,9 @@ void output_graphml(
 std::unique_ptr<memory_model_baset>
 get_memory_model(const optionst &options, const namespacet &);
 
+/// The representation of guards selected by the `symex-guards` option
+guard_managert::kindt get_guard_kind(const optionst &options);
+
 void setup_symex(
   symex_bmct &,
   const namespacet &,
@@ -106,6 +120,17 @@ void output_coverage_report(
   const symex_bmct &symex,
   ui_message_handlert &ui_message_handler);
 
+/// Output the per-source-location profile collected by \ref symex_profilert
+/// if `--profile-symex` is set: an annotated-source view in plain-text mode,
+/// or JSON with `--json-ui`.
+/// \param options: options to check for `profile-symex`
+/// \param symex: symbolic execution run to report the profile for
+/// \param ui_message_handler: status/warning message handler
+void output_symex_profile(
+  const optionst &options,
+  const symex_bmct &symex,
+  ui_message_handlert &ui_message_handler);
+
 /// Sets property status to PASS for properties whose
 /// conditions are constant true in the \p equation.
 /// \param [in,out] properties: The status is updated in this data structure
@@ -194,11 +219,17 @@ void run_property_decider(
   "(unwindset):" \
   "(symex-complexity-limit):" \
   "(symex-complexity-failed-child-loops-limit):" \
+  "(symex-memory-limit):" \
   "(incremental-loop):" \
   "(unwind-min):" \
   "(unwind-max):" \
   "(ignore-properties-before-unwind-min)" \
   "(symex-cache-dereferences)" \
+  "(symex-guards):" \
+  "(profile-symex)" \
+  "(checkpoint):" \
+  "(checkpoint-interval):" \
+  "(resume):" \
 
 #define HELP_BMC \
   " --paths [strategy]           explore paths one at a time\n" \
@@ -252,8 +283,23 @@ void run_property_decider(
   "                              iteration are allowed to fail due to\n" \
   "                              complexity violations before the loop\n" \
   "                              gets blacklisted\n" \
+  " --symex-memory-limit M       adaptively limit path complexity so that\n" \
+  "                              the memory allocated by symex stays within\n" \
+  "                              M MiB\n" \
   " --graphml-witness filename   write the witness in GraphML format to filename\n" /* NOLINT(*) */ \
-  " --symex-cache-dereferences   enable caching of repeated dereferences" \
+  " --symex-cache-dereferences   enable caching of repeated dereferences\n" \
+  " --symex-guards bdd|expr      represent the path conditions of symex as\n" \
+  "                              BDDs or as expressions (default: expr)\n" \
+  " --checkpoint dir             save the equation generated by symex to dir\n" \
+  " --checkpoint-interval s      with --checkpoint, also save the state of\n" \
+  "                              symex to dir every s seconds\n" \
+  " --resume dir                 continue from the equation or, failing\n" \
+  "                              that, from the symex state saved in dir by\n" \
+  "                              --checkpoint; the program and options must\n" \
+  "                              be the same\n" \
+  " --profile-symex              report symex steps, expression sizes, symex\n" \
+  "                              time and CNF sizes per source location and\n" \
+  "                              function (as JSON with --json-ui)" \
 // clang-format on
 
 #endif // CPROVER_GOTO_CHECKER_BMC_UTIL_H
@@ -62,6 +62,16 @@ operator()(propertiest &properties)
 
     solver_runtime += prepare_property_decider(properties);
 
+    if(options.get_bool_option("profile-symex"))
+    {
+      with_solver_hardness(
+        property_decider.get_decision_procedure(),
+        [this](solver_hardnesst &hardness) {
+          symex.get_profile().record_solver_hardness(hardness);
+        });
+      output_symex_profile(options, symex, ui_message_handler);
+    }
+
     equation_generated = true;
   }
 
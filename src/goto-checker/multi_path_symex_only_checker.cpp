@@ -11,6 +11,8 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "multi_path_symex_only_checker.h"
 
+#include <util/exception_utils.h>
+#include <util/make_unique.h>
 #include <util/ui_message.h>
 
 #include <goto-symex/show_program.h>
@@ -28,6 +30,7 @@ multi_path_symex_only_checkert::multi_path_symex_only_checkert(
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
     equation(ui_message_handler),
+    guard_manager(get_guard_kind(options)),
     symex(
       ui_message_handler,
       goto_model.get_symbol_table(),
@@ -66,6 +69,8 @@ operator()(propertiest &properties)
     show_byte_ops(options, ui_message_handler, ns, equation);
   }
 
+  output_symex_profile(options, symex, ui_message_handler);
+
   resultt result(resultt::progresst::DONE);
   update_properties(properties, result.updated_properties);
   return result;
@@ -73,12 +78,56 @@ operator()(propertiest &properties)
 
 void multi_path_symex_only_checkert::generate_equation()
 {
+  if(options.is_set("checkpoint") || options.is_set("resume"))
+  {
+    fingerprint = symex_checkpoint_fingerprint(
+      goto_model.get_symbol_table(), goto_model.get_goto_functions(), options);
+  }
+
   const auto symex_start = std::chrono::steady_clock::now();
 
-  symex.symex_from_entry_point_of(
-    goto_model.get_goto_functions(),
-    goto_symext::get_goto_function(goto_model),
-    symex_symbol_table);
+  if(options.is_set("resume"))
+  {
+    const symex_checkpointt resume(
+      options.get_option("resume"), fingerprint, ui_message_handler);
+
+    switch(resume.content())
+    {
+    case symex_checkpointt::contentt::EQUATION:
+      // the equation is already post-processed
+      if(resume.read_equation(
+           goto_model.get_goto_functions(), equation, symex_symbol_table))
+      {
+        throw deserialization_exceptiont(
+          "failed to resume from symex checkpoint '" +
+          resume.get_directory() + "'");
+      }
+      return;
+
+    case symex_checkpointt::contentt::STATE:
+      if(options.is_set("checkpoint"))
+        set_checkpoint();
+      symex.symex_from_checkpoint(
+        resume,
+        goto_model.get_goto_functions(),
+        goto_symext::get_goto_function(goto_model),
+        symex_symbol_table);
+      break;
+
+    case symex_checkpointt::contentt::NONE:
+      throw deserialization_exceptiont(
+        "no symex checkpoint found in '" + resume.get_directory() + "'");
+    }
+  }
+  else
+  {
+    if(options.is_set("checkpoint"))
+      set_checkpoint();
+    symex.symex_from_entry_point_of(
+      goto_model.get_goto_functions(),
+      goto_symext::get_goto_function(goto_model),
+      symex_symbol_table);
+  }
 
   const auto symex_stop = std::chrono::steady_clock::now();
   std::chrono::duration<double> symex_runtime =
@@ -87,6 +136,23 @@ void multi_path_symex_only_checkert::generate_equation()
                << messaget::eom;
 
   postprocess_equation(symex, equation, options, ns, ui_message_handler);
+
+  if(checkpoint_writer)
+    (void)checkpoint_writer->write_equation(equation, symex_symbol_table);
+}
+
+void multi_path_symex_only_checkert::set_checkpoint()
+{
+  checkpoint_writer = util_make_unique<symex_checkpointt>(
+    options.get_option("checkpoint"), fingerprint, ui_message_handler);
+
+  if(options.is_set("checkpoint-interval"))
+  {
+    symex.set_checkpoint(
+      *checkpoint_writer,
+      std::chrono::seconds(
+        options.get_unsigned_int_option("checkpoint-interval")));
+  }
 }
 
 void multi_path_symex_only_checkert::update_properties(
@@ -15,6 +15,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include "incremental_goto_checker.h"
 
 #include <goto-symex/path_storage.h>
+#include <goto-symex/symex_checkpoint.h>
 
 #include "symex_bmc.h"
 
@@ -37,9 +38,18 @@ protected:
   path_fifot path_storage; // should go away
   symex_bmct symex;
 
+  /// Fingerprint of the goto model and options, only computed when
+  /// checkpointing or resuming
+  std::size_t fingerprint = 0;
+  std::unique_ptr<symex_checkpointt> checkpoint_writer;
+
   /// Generates the equation by running goto-symex
   virtual void generate_equation();
 
+  /// Sets up writing checkpoints to the directory given by `--checkpoint`,
+  /// periodically during symex if `--checkpoint-interval` is given
+  void set_checkpoint();
+
   /// Updates the \p properties from the `equation` and
   /// adds their property IDs to \p updated_properties.
   virtual void update_properties(
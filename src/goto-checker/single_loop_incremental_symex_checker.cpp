@@ -30,6 +30,7 @@ single_loop_incremental_symex_checkert::single_loop_incremental_symex_checkert(
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
     equation(ui_message_handler),
+    guard_manager(get_guard_kind(options)),
     symex(
       ui_message_handler,
       goto_model.get_symbol_table(),
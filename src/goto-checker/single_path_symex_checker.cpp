@@ -78,6 +78,7 @@ operator()(propertiest &properties)
     worklist->pop();
   }
 
+  guard_manager.output_statistics(log);
   log.status() << "Runtime Symex: " << symex_runtime.count() << "s"
                << messaget::eom;
 
@@ -29,6 +29,7 @@ single_path_symex_only_checkert::single_path_symex_only_checkert(
   : incremental_goto_checkert(options, ui_message_handler),
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
+    guard_manager(get_guard_kind(options)),
     worklist(get_path_strategy(options.get_option("exploration-strategy"))),
     symex_runtime(0)
 {
@@ -52,6 +53,7 @@ operator()(propertiest &properties)
     worklist->pop();
   }
 
+  guard_manager.output_statistics(log);
   log.status() << "Runtime Symex: " << symex_runtime.count() << "s"
                << messaget::eom;
 
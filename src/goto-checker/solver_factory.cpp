@@ -26,11 +26,14 @@ Author: Daniel Kroening, Peter Schrammel
 #include <solvers/stack_decision_procedure.h>
 
 #include <solvers/flattening/bv_dimacs.h>
+#include <solvers/prop/aig_prop.h>
 #include <solvers/prop/prop.h>
 #include <solvers/prop/solver_resource_limits.h>
 #include <solvers/refinement/bv_refinement.h>
+#include <solvers/sat/cnf_preprocessor.h>
 #include <solvers/sat/dimacs_cnf.h>
 #include <solvers/sat/external_sat.h>
+#include <solvers/sat/external_sat_incremental.h>
 #include <solvers/sat/satcheck.h>
 #include <solvers/smt2_incremental/smt2_incremental_decision_procedure.h>
 #include <solvers/strings/string_refinement.h>
@@ -111,6 +114,61 @@ void solver_factoryt::set_decision_procedure_time_limit(
   }
 }
 
+void solver_factoryt::set_lazy_arrays(boolbvt &boolbv)
+{
+  boolbv.unbounded_array = boolbvt::unbounded_arrayt::U_ALL;
+  boolbv.set_array_theory(boolbvt::array_theoryt::WEAK_EQUIVALENCE);
+
+  // lemmas are added after solving, so variables must not be eliminated
+  boolbv.set_all_frozen();
+}
+
+void solver_factoryt::set_arithmetic_encodings(boolbvt &boolbv)
+{
+  const std::string multiplier_option = options.get_option("bv-multiplier");
+  bv_utilst::multipliert multiplier;
+
+  if(multiplier_option.empty() || multiplier_option == "shift-add")
+    multiplier = bv_utilst::multipliert::SHIFT_ADD;
+  else if(multiplier_option == "wallace")
+    multiplier = bv_utilst::multipliert::WALLACE;
+  else if(multiplier_option == "dadda")
+    multiplier = bv_utilst::multipliert::DADDA;
+  else if(multiplier_option == "booth")
+    multiplier = bv_utilst::multipliert::BOOTH_RADIX4;
+  else if(multiplier_option == "karatsuba")
+    multiplier = bv_utilst::multipliert::KARATSUBA;
+  else
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "unknown multiplier encoding '" + multiplier_option + "'",
+      "--bv-multiplier",
+      "use one of shift-add, wallace, dadda, booth or karatsuba");
+  }
+
+  const std::string divider_option = options.get_option("bv-divider");
+  bv_utilst::dividert divider;
+
+  if(divider_option.empty() || divider_option == "constraints")
+    divider = bv_utilst::dividert::CONSTRAINTS;
+  else if(divider_option == "non-restoring")
+    divider = bv_utilst::dividert::NON_RESTORING;
+  else
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "unknown divider encoding '" + divider_option + "'",
+      "--bv-divider",
+      "use one of constraints or non-restoring");
+  }
+
+  const std::size_t min_width =
+    options.is_set("bv-encoding-min-width")
+      ? options.get_unsigned_int_option("bv-encoding-min-width")
+      : 0;
+
+  boolbv.set_arithmetic_encodings(multiplier, divider, min_width);
+}
+
 void solver_factoryt::solvert::set_decision_procedure(
   std::unique_ptr<decision_proceduret> p)
 {
@@ -203,13 +261,73 @@ make_satcheck_prop(message_handlert &message_handler, const optionst &options)
         << "Solver stats will not be written." << messaget::eom;
     }
   }
+  else if(options.get_bool_option("profile-symex"))
+  {
+    // the profiler attributes CNF sizes to source locations via the
+    // per-SSA-step statistics of the hardness collector
+    if(
+      auto hardness_collector = dynamic_cast<hardness_collectort *>(&*satcheck))
+    {
+      hardness_collector->enable_hardness_collection();
+    }
+    else
+    {
+      messaget log(message_handler);
+      log.warning() << "Configured solver does not support collecting CNF "
+                    << "statistics for --profile-symex" << messaget::eom;
+    }
+  }
+  if(options.get_bool_option("polarity-aware-cnf"))
+  {
+    auto cnf = dynamic_cast<cnft *>(&*satcheck);
+    if(cnf && cnf->has_polarity_aware_encoding())
+      cnf->set_polarity_aware_encoding(true);
+    else
+    {
+      messaget log(message_handler);
+      log.warning() << "Configured solver does not support "
+                    << "--polarity-aware-cnf" << messaget::eom;
+    }
+  }
   return satcheck;
 }
 
 std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
 {
   auto solver = util_make_unique<solvert>();
-  if(
+  if(options.get_bool_option("aig") || options.get_bool_option("aig-sweep"))
+  {
+    // the AIG layer converts incrementally, so variables must not be
+    // eliminated by the solver
+    auto aig_prop = util_make_unique<aig_prop_solvert>(
+      make_satcheck_prop<satcheck_no_simplifiert>(message_handler, options),
+      message_handler);
+
+    if(options.get_bool_option("aig-sweep"))
+    {
+      const std::chrono::seconds time_budget(
+        options.is_set("aig-sweep-time-limit")
+          ? options.get_unsigned_int_option("aig-sweep-time-limit")
+          : 10);
+
+      aig_prop->enable_sweeping(
+        [](message_handlert &sweep_message_handler) {
+          return util_make_unique<satcheck_no_simplifiert>(
+            sweep_message_handler);
+        },
+        time_budget);
+    }
+
+    solver->set_prop(std::move(aig_prop));
+  }
+  else if(options.get_bool_option("cnf-preprocessor"))
+  {
+    // our own preprocessing replaces that of the solver
+    solver->set_prop(util_make_unique<cnf_preprocessort>(
+      make_satcheck_prop<satcheck_no_simplifiert>(message_handler, options),
+      message_handler));
+  }
+  else if(
     options.get_bool_option("beautify") ||
     !options.get_bool_option("sat-preprocessor")) // no simplifier
   {
@@ -231,7 +349,10 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
     bv_pointers->unbounded_array = bv_pointerst::unbounded_arrayt::U_NONE;
   else if(options.get_option("arrays-uf") == "always")
     bv_pointers->unbounded_array = bv_pointerst::unbounded_arrayt::U_ALL;
+  else if(options.get_option("arrays-uf") == "lazy")
+    set_lazy_arrays(*bv_pointers);
 
+  set_arithmetic_encodings(*bv_pointers);
   set_decision_procedure_time_limit(*bv_pointers);
   solver->set_decision_procedure(std::move(bv_pointers));
 
@@ -243,26 +364,69 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_dimacs()
   no_beautification();
   no_incremental_check();
 
-  auto prop = util_make_unique<dimacs_cnft>(message_handler);
+  const std::string &filename = options.get_option("outfile");
+
+  // the clauses are written as they are generated
+  if(filename.empty() || filename == "-")
+  {
+    auto prop =
+      util_make_unique<dimacs_cnf_streamt>(std::cout, message_handler);
+    auto bv_dimacs =
+      util_make_unique<bv_dimacst>(ns, *prop, message_handler, std::cout);
+    return util_make_unique<solvert>(std::move(bv_dimacs), std::move(prop));
+  }
+
+#ifdef _MSC_VER
+  auto out = util_make_unique<std::ofstream>(widen(filename));
+#else
+  auto out = util_make_unique<std::ofstream>(filename);
+#endif
 
-  std::string filename = options.get_option("outfile");
+  if(!*out)
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "failed to open file: " + filename, "--outfile");
+  }
 
+  auto prop = util_make_unique<dimacs_cnf_streamt>(*out, message_handler);
   auto bv_dimacs =
-    util_make_unique<bv_dimacst>(ns, *prop, message_handler, filename);
+    util_make_unique<bv_dimacst>(ns, *prop, message_handler, *out);
 
-  return util_make_unique<solvert>(std::move(bv_dimacs), std::move(prop));
+  auto solver =
+    util_make_unique<solvert>(std::move(bv_dimacs), std::move(prop));
+  solver->set_ofstream(std::move(out));
+  return solver;
 }
 
 std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_external_sat()
 {
   no_beautification();
-  no_incremental_check();
 
   std::string external_sat_solver = options.get_option("external-sat-solver");
-  auto prop =
-    util_make_unique<external_satt>(message_handler, external_sat_solver);
+  std::unique_ptr<propt> prop;
+
+  // the incremental protocol keeps the solver process, and with it the
+  // formula, across calls
+  if(options.get_bool_option("external-sat-incremental"))
+  {
+    prop = util_make_unique<external_sat_incrementalt>(
+      message_handler, external_sat_solver);
+  }
+  else
+  {
+    no_incremental_check();
+    prop =
+      util_make_unique<external_satt>(message_handler, external_sat_solver);
+  }
+
+  if(options.get_bool_option("cnf-preprocessor"))
+  {
+    prop =
+      util_make_unique<cnf_preprocessort>(std::move(prop), message_handler);
+  }
 
   auto bv_pointers = util_make_unique<bv_pointerst>(ns, *prop, message_handler);
+  set_arithmetic_encodings(*bv_pointers);
 
   return util_make_unique<solvert>(std::move(bv_pointers), std::move(prop));
 }
@@ -292,9 +456,14 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_bv_refinement()
 
   info.refine_arrays = options.get_bool_option("refine-arrays");
   info.refine_arithmetic = options.get_bool_option("refine-arithmetic");
+  info.refine_floatbv = options.get_bool_option("refine-arithmetic") ||
+                        options.get_bool_option("refine-floatbv");
   info.message_handler = &message_handler;
 
   auto decision_procedure = util_make_unique<bv_refinementt>(info);
+  if(options.get_option("arrays-uf") == "lazy")
+    set_lazy_arrays(*decision_procedure);
+  set_arithmetic_encodings(*decision_procedure);
   set_decision_procedure_time_limit(*decision_procedure);
   return util_make_unique<solvert>(
     std::move(decision_procedure), std::move(prop));
@@ -318,6 +487,8 @@ solver_factoryt::get_string_refinement()
       options.get_unsigned_int_option("max-node-refinement");
   info.refine_arrays = options.get_bool_option("refine-arrays");
   info.refine_arithmetic = options.get_bool_option("refine-arithmetic");
+  info.refine_floatbv = options.get_bool_option("refine-arithmetic") ||
+                        options.get_bool_option("refine-floatbv");
   info.message_handler = &message_handler;
 
   auto decision_procedure = util_make_unique<string_refinementt>(info);
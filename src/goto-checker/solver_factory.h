@@ -16,6 +16,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <solvers/smt2/smt2_dec.h>
 
+class boolbvt;
 class message_handlert;
 class namespacet;
 class optionst;
@@ -86,6 +87,15 @@ protected:
   void
   set_decision_procedure_time_limit(decision_proceduret &decision_procedure);
 
+  /// Turns all arrays of \p boolbv into uninterpreted functions, with the
+  /// array axioms added lazily via a weak equivalence graph
+  void set_lazy_arrays(boolbvt &boolbv);
+
+  /// Selects the encodings of multiplication and division of \p boolbv
+  /// according to the `bv-multiplier`, `bv-divider` and
+  /// `bv-encoding-min-width` options
+  void set_arithmetic_encodings(boolbvt &boolbv);
+
   // consistency checks during solver creation
   void no_beautification();
   void no_incremental_check();
@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "symex_bmc.h"
 
+#include <chrono>
 #include <limits>
 
 #include <util/simplify_expr.h>
@@ -31,6 +32,7 @@ symex_bmct::symex_bmct(
       path_storage,
       guard_manager),
     record_coverage(!options.get_option("symex-coverage-report").empty()),
+    record_profile(options.get_bool_option("profile-symex")),
     havoc_bodyless_functions(
       options.get_bool_option("havoc-undefined-functions")),
     symex_coverage(ns)
@@ -70,8 +72,35 @@ void symex_bmct::symex_step(
     log.statistics() << log.eom;
   }
 
+  const irep_idt cur_function_id = state.source.function_id;
+  const std::size_t ssa_steps_before = target.SSA_steps.size();
+  const auto step_start = std::chrono::steady_clock::now();
+
   goto_symext::symex_step(get_goto_function, state);
 
+  if(record_profile)
+  {
+    const auto step_stop = std::chrono::steady_clock::now();
+    const std::size_t new_ssa_steps =
+      target.SSA_steps.size() - ssa_steps_before;
+
+    // the steps added by this instruction are at the end of the equation
+    std::size_t expression_size = 0;
+    auto ssa_step_it = target.SSA_steps.rbegin();
+    for(std::size_t i = 0; i < new_ssa_steps; ++i, ++ssa_step_it)
+    {
+      expression_size += symex_profilert::expression_size(ssa_step_it->guard) +
+                         symex_profilert::expression_size(ssa_step_it->cond_expr);
+    }
+
+    symex_profile.record_step(
+      cur_pc,
+      cur_function_id,
+      new_ssa_steps,
+      expression_size,
+      step_stop - step_start);
+  }
+
   if(
     record_coverage &&
     // avoid an invalid iterator in state.source.pc
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-instrument/unwindset.h>
 
 #include "symex_coverage.h"
+#include "symex_profiler.h"
 
 class symex_bmct : public goto_symext
 {
@@ -78,7 +79,20 @@ public:
     return symex_coverage.generate_report(goto_functions, path);
   }
 
+  /// Profile of the cost of symbolic execution per instruction, only
+  /// collected if `record_profile` is set
+  symex_profilert &get_profile()
+  {
+    return symex_profile;
+  }
+
+  const symex_profilert &get_profile() const
+  {
+    return symex_profile;
+  }
+
   const bool record_coverage;
+  const bool record_profile;
   const bool havoc_bodyless_functions;
 
   unwindsett unwindset;
@@ -114,6 +128,7 @@ protected:
   std::unordered_set<irep_idt> body_warnings;
 
   symex_coveraget symex_coverage;
+  symex_profilert symex_profile;
 };
 
 #endif // CPROVER_GOTO_CHECKER_SYMEX_BMC_H
@@ -0,0 +1,258 @@
+/*******************************************************************\
+
+Module: Per-source-location cost profile of symbolic execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Per-source-location cost profile of symbolic execution
+
+#include "symex_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+#include <util/json.h>
+#include <util/string2int.h>
+
+#include <goto-symex/complexity_limiter.h>
+
+#include <solvers/solver_hardness.h>
+
+symex_profilert::costt &symex_profilert::costt::operator+=(const costt &other)
+{
+  steps += other.steps;
+  ssa_steps += other.ssa_steps;
+  expression_size += other.expression_size;
+  symex_time += other.symex_time;
+  cnf_variables += other.cnf_variables;
+  cnf_clauses += other.cnf_clauses;
+  return *this;
+}
+
+void symex_profilert::record_step(
+  goto_programt::const_targett pc,
+  const irep_idt &function_id,
+  std::size_t ssa_steps,
+  std::size_t expression_size,
+  std::chrono::duration<double> symex_time)
+{
+  instruction_profilet &entry = profile[pc];
+  if(entry.function_id.empty())
+    entry.function_id = function_id;
+
+  ++entry.cost.steps;
+  entry.cost.ssa_steps += ssa_steps;
+  entry.cost.expression_size += expression_size;
+  entry.cost.symex_time += symex_time;
+}
+
+void symex_profilert::record_solver_hardness(const solver_hardnesst &hardness)
+{
+  hardness.for_each_ssa_hardness(
+    [this](
+      goto_programt::const_targett pc,
+      const solver_hardnesst::sat_hardnesst &sat_hardness) {
+      instruction_profilet &entry = profile[pc];
+      if(entry.function_id.empty())
+        entry.function_id = pc->source_location.get_function();
+
+      entry.cost.cnf_variables += sat_hardness.variables.size();
+      entry.cost.cnf_clauses += sat_hardness.clauses;
+    });
+}
+
+std::size_t symex_profilert::expression_size(const exprt &expr)
+{
+  // large enough to tell expensive steps apart, small enough to not dominate
+  // the run time of symex itself
+  const std::size_t limit = 1 << 16;
+  return complexity_limitert::bounded_expr_size(expr, limit);
+}
+
+static std::size_t line_number(const source_locationt &source_location)
+{
+  return unsafe_string2size_t(id2string(source_location.get_line()));
+}
+
+std::map<symex_profilert::linet, symex_profilert::costt>
+symex_profilert::per_line() const
+{
+  std::map<linet, costt> result;
+
+  for(const auto &entry : profile)
+  {
+    const source_locationt &source_location = entry.first->source_location;
+    if(source_location.get_file().empty() || source_location.get_line().empty())
+      continue;
+
+    result[{source_location.get_file(), line_number(source_location)}] +=
+      entry.second.cost;
+  }
+
+  return result;
+}
+
+std::map<irep_idt, symex_profilert::costt>
+symex_profilert::per_function() const
+{
+  std::map<irep_idt, costt> result;
+
+  for(const auto &entry : profile)
+    result[entry.second.function_id] += entry.second.cost;
+
+  return result;
+}
+
+static json_objectt json(const symex_profilert::costt &cost)
+{
+  return json_objectt{
+    {"steps", json_numbert{std::to_string(cost.steps)}},
+    {"ssaSteps", json_numbert{std::to_string(cost.ssa_steps)}},
+    {"expressionSize", json_numbert{std::to_string(cost.expression_size)}},
+    {"symexTime", json_numbert{std::to_string(cost.symex_time.count())}},
+    {"cnfVariables", json_numbert{std::to_string(cost.cnf_variables)}},
+    {"cnfClauses", json_numbert{std::to_string(cost.cnf_clauses)}}};
+}
+
+json_objectt symex_profilert::to_json() const
+{
+  // remember which function each source line belongs to
+  std::map<linet, irep_idt> line_functions;
+  for(const auto &entry : profile)
+  {
+    const source_locationt &source_location = entry.first->source_location;
+    line_functions.insert(
+      {{source_location.get_file(), line_number(source_location)},
+       entry.second.function_id});
+  }
+
+  json_arrayt json_locations;
+  for(const auto &line : per_line())
+  {
+    json_objectt json_location = json(line.second);
+    json_location["file"] = json_stringt{line.first.first};
+    json_location["line"] = json_numbert{std::to_string(line.first.second)};
+    json_location["function"] = json_stringt{line_functions[line.first]};
+    json_locations.push_back(std::move(json_location));
+  }
+
+  json_arrayt json_functions;
+  for(const auto &function : per_function())
+  {
+    json_objectt json_function = json(function.second);
+    json_function["function"] = json_stringt{function.first};
+    json_functions.push_back(std::move(json_function));
+  }
+
+  json_objectt json_result;
+  json_result["symexProfile"] = json_objectt{
+    {"locations", std::move(json_locations)},
+    {"functions", std::move(json_functions)}};
+  return json_result;
+}
+
+static void output_cost(std::ostream &out, const symex_profilert::costt &cost)
+{
+  out << std::setw(8) << cost.steps << ' ' << std::setw(8) << cost.ssa_steps
+      << ' ' << std::setw(10) << cost.expression_size << ' ' << std::setw(10)
+      << std::fixed << std::setprecision(4) << cost.symex_time.count() << ' '
+      << std::setw(10) << cost.cnf_variables << ' ' << std::setw(10)
+      << cost.cnf_clauses;
+}
+
+static void output_header(std::ostream &out)
+{
+  out << std::setw(8) << "steps" << ' ' << std::setw(8) << "SSA" << ' '
+      << std::setw(10) << "expr-size" << ' ' << std::setw(10) << "time (s)"
+      << ' ' << std::setw(10) << "variables" << ' ' << std::setw(10)
+      << "clauses";
+}
+
+void symex_profilert::output_annotated_source(std::ostream &out) const
+{
+  // the full path to open for each file name used in source locations
+  std::map<irep_idt, std::string> full_paths;
+  for(const auto &entry : profile)
+  {
+    const source_locationt &source_location = entry.first->source_location;
+    if(source_location.get_file().empty())
+      continue;
+
+    auto full_path = source_location.full_path();
+    if(full_path.has_value())
+      full_paths.insert({source_location.get_file(), *full_path});
+  }
+
+  const std::map<linet, costt> lines = per_line();
+
+  auto line_it = lines.begin();
+  while(line_it != lines.end())
+  {
+    const irep_idt file = line_it->first.first;
+
+    out << "==== " << file << " ====\n";
+    output_header(out);
+    out << " | source\n";
+
+    std::ifstream in;
+    auto full_path_it = full_paths.find(file);
+    if(full_path_it != full_paths.end())
+      in.open(full_path_it->second);
+
+    if(in)
+    {
+      std::string source_line;
+      for(std::size_t line_no = 1; std::getline(in, source_line); ++line_no)
+      {
+        if(
+          line_it != lines.end() && line_it->first.first == file &&
+          line_it->first.second == line_no)
+        {
+          output_cost(out, line_it->second);
+          ++line_it;
+        }
+        else
+          out << std::string(63, ' ');
+
+        out << " | " << std::setw(5) << line_no << ": " << source_line << '\n';
+      }
+    }
+
+    // any lines not found in the file (or the file was not readable)
+    for(; line_it != lines.end() && line_it->first.first == file; ++line_it)
+    {
+      output_cost(out, line_it->second);
+      out << " | " << std::setw(5) << line_it->first.second << '\n';
+    }
+
+    out << '\n';
+  }
+
+  // functions sorted by decreasing symex time
+  std::map<irep_idt, costt> functions = per_function();
+  std::vector<std::pair<irep_idt, costt>> sorted_functions(
+    functions.begin(), functions.end());
+  std::stable_sort(
+    sorted_functions.begin(),
+    sorted_functions.end(),
+    [](
+      const std::pair<irep_idt, costt> &a,
+      const std::pair<irep_idt, costt> &b) {
+      return a.second.symex_time > b.second.symex_time;
+    });
+
+  out << "==== functions ====\n";
+  output_header(out);
+  out << " | function\n";
+  for(const auto &function : sorted_functions)
+  {
+    output_cost(out, function.second);
+    out << " | " << function.first << '\n';
+  }
+}
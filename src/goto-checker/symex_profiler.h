@@ -0,0 +1,100 @@
+/*******************************************************************\
+
+Module: Per-source-location cost profile of symbolic execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Per-source-location cost profile of symbolic execution
+
+#ifndef CPROVER_GOTO_CHECKER_SYMEX_PROFILER_H
+#define CPROVER_GOTO_CHECKER_SYMEX_PROFILER_H
+
+#include <chrono>
+#include <iosfwd>
+#include <map>
+
+#include <goto-programs/goto_program.h>
+
+class json_objectt;
+struct solver_hardnesst;
+
+/// Attributes the cost of symbolic execution and of the subsequent conversion
+/// to CNF to the GOTO instructions (and thus source locations and functions)
+/// that caused it. The symex costs are recorded by \ref symex_bmct for each
+/// call to `symex_step`, the CNF costs are taken from the per-SSA-step
+/// statistics of a \ref solver_hardnesst.
+class symex_profilert
+{
+public:
+  struct costt
+  {
+    /// Number of times symex executed the instruction
+    std::size_t steps = 0;
+    /// Number of SSA steps added to the equation
+    std::size_t ssa_steps = 0;
+    /// Approximate number of expression nodes in the SSA steps added
+    std::size_t expression_size = 0;
+    /// Time spent in `symex_step`
+    std::chrono::duration<double> symex_time{0};
+    /// Number of distinct CNF variables used by the clauses generated when
+    /// converting the SSA steps
+    std::size_t cnf_variables = 0;
+    /// Number of CNF clauses generated when converting the SSA steps
+    std::size_t cnf_clauses = 0;
+
+    costt &operator+=(const costt &other);
+  };
+
+  /// Record the cost of one call to `symex_step`.
+  /// \param pc: the instruction that was executed
+  /// \param function_id: the function \p pc belongs to
+  /// \param ssa_steps: number of SSA steps that were added to the equation
+  /// \param expression_size: size of the expressions in those SSA steps
+  /// \param symex_time: time taken to execute the instruction
+  void record_step(
+    goto_programt::const_targett pc,
+    const irep_idt &function_id,
+    std::size_t ssa_steps,
+    std::size_t expression_size,
+    std::chrono::duration<double> symex_time);
+
+  /// Add the CNF sizes registered per SSA step in \p hardness.
+  void record_solver_hardness(const solver_hardnesst &hardness);
+
+  /// Profile aggregated by source location, as JSON
+  json_objectt to_json() const;
+
+  /// Write the annotated-source view: each profiled source file is printed
+  /// with the cost of each line in front of it, followed by a per-function
+  /// summary.
+  void output_annotated_source(std::ostream &out) const;
+
+  bool empty() const
+  {
+    return profile.empty();
+  }
+
+  /// Approximate number of nodes in \p expr, bounded to avoid blowing up on
+  /// expressions with much sharing.
+  static std::size_t expression_size(const exprt &expr);
+
+protected:
+  struct instruction_profilet
+  {
+    irep_idt function_id;
+    costt cost;
+  };
+
+  std::map<goto_programt::const_targett, instruction_profilet> profile;
+
+  /// Key of a source line: file name and line number
+  typedef std::pair<irep_idt, std::size_t> linet;
+
+  std::map<linet, costt> per_line() const;
+  std::map<irep_idt, costt> per_function() const;
+};
+
+#endif // CPROVER_GOTO_CHECKER_SYMEX_PROFILER_H
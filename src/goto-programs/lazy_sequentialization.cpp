@@ -0,0 +1,644 @@
+/*******************************************************************\
+
+Module: Lazy Sequentialization of Concurrent Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Lazy Sequentialization of Concurrent Programs
+
+#include "lazy_sequentialization.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/expr_initializer.h>
+#include <util/expr_iterator.h>
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/message.h>
+#include <util/replace_symbol.h>
+#include <util/std_code.h>
+
+#include "goto_inline.h"
+#include "goto_model.h"
+
+class lazy_sequentializationt
+{
+public:
+  lazy_sequentializationt(
+    goto_modelt &_goto_model,
+    std::size_t _rounds,
+    message_handlert &message_handler)
+    : goto_model(_goto_model),
+      ns(_goto_model.symbol_table),
+      rounds(_rounds),
+      log(message_handler)
+  {
+  }
+
+  bool operator()();
+
+protected:
+  goto_modelt &goto_model;
+  const namespacet ns;
+  const std::size_t rounds;
+  messaget log;
+
+  struct threadt
+  {
+    /// The thread that creates this one; unused for the main thread
+    std::size_t parent = 0;
+    /// The START_THREAD instruction (in the body of the parent)
+    goto_programt::targett spawn;
+    /// First instruction and END_THREAD instruction of the thread body
+    goto_programt::targett begin, end;
+
+    goto_programt body;
+    /// Instructions that get a context switch point
+    std::vector<goto_programt::targett> switch_points;
+    /// Local and thread-local variables used by the thread or any of the
+    /// threads it creates
+    std::set<irep_idt> variables;
+    /// Maps the variables to the static copy of this thread
+    replace_symbolt rename;
+  };
+
+  std::vector<threadt> threads;
+
+  bool find_threads(goto_programt &entry_body);
+  void analyse_thread(threadt &thread);
+  void add_variable_copies(std::size_t t);
+  void replace_spawn(std::size_t t);
+  void instrument_thread(std::size_t t);
+  goto_programt scheduler(const source_locationt &source_location);
+
+  bool is_local(const symbolt &symbol) const
+  {
+    return !symbol.is_static_lifetime && !symbol.is_type &&
+           !symbol.is_macro && symbol.type.id() != ID_code;
+  }
+
+  bool is_shared(const symbolt &symbol) const
+  {
+    return symbol.is_static_lifetime && !symbol.is_thread_local &&
+           symbol.type.id() != ID_code;
+  }
+
+  bool may_access_shared_memory(const goto_programt::instructiont &) const;
+
+  static std::string suffix(std::size_t t)
+  {
+    return "$thread" + std::to_string(t);
+  }
+
+  static irep_idt function_id(std::size_t t)
+  {
+    return CPROVER_PREFIX "lazy_thread" + std::to_string(t);
+  }
+
+  symbol_exprt pc(std::size_t t) const
+  {
+    return ns.lookup(CPROVER_PREFIX "cs_pc" + suffix(t)).symbol_expr();
+  }
+
+  symbol_exprt active(std::size_t t) const
+  {
+    return ns.lookup(CPROVER_PREFIX "cs_active" + suffix(t)).symbol_expr();
+  }
+
+  symbol_exprt started(std::size_t t) const
+  {
+    return ns.lookup(CPROVER_PREFIX "cs_started" + suffix(t)).symbol_expr();
+  }
+
+  symbol_exprt context_end() const
+  {
+    return ns.lookup(CPROVER_PREFIX "cs_next").symbol_expr();
+  }
+
+  void add_control_symbol(const irep_idt &identifier, const typet &type);
+};
+
+bool lazy_sequentializationt::may_access_shared_memory(
+  const goto_programt::instructiont &instruction) const
+{
+  // calls that remain after inlining are executed atomically
+  if(instruction.is_function_call())
+    return true;
+
+  if(
+    !instruction.is_assign() && !instruction.is_assume() &&
+    !instruction.is_assert() && !instruction.is_goto() &&
+    !instruction.is_other())
+  {
+    return false;
+  }
+
+  bool result = false;
+  instruction.apply([this, &result](const exprt &expr) {
+    for(auto it = expr.depth_cbegin(); !result && it != expr.depth_cend(); ++it)
+    {
+      if(it->id() == ID_dereference)
+        result = true;
+      else if(it->id() == ID_symbol)
+      {
+        const symbolt *symbol =
+          ns.get_symbol_table().lookup(to_symbol_expr(*it).get_identifier());
+        result = symbol != nullptr && is_shared(*symbol);
+      }
+    }
+  });
+
+  return result;
+}
+
+bool lazy_sequentializationt::find_threads(goto_programt &entry_body)
+{
+  // the main thread
+  threads.resize(1);
+
+  // thread bodies start at the target of START_THREAD and end with an
+  // END_THREAD, with the bodies of threads they create nested inside
+  std::map<goto_programt::const_targett, std::size_t> thread_begins;
+  std::vector<std::size_t> stack{0};
+
+  for(auto it = entry_body.instructions.begin();
+      it != entry_body.instructions.end();
+      ++it)
+  {
+    const auto begin_entry = thread_begins.find(it);
+    if(begin_entry != thread_begins.end())
+      stack.push_back(begin_entry->second);
+
+    if(it->is_start_thread())
+    {
+      INVARIANT(it->targets.size() == 1, "start_thread expects one target");
+
+      if(it->get_target()->location_number <= it->location_number)
+      {
+        log.error() << "thread body preceding START_THREAD is not supported"
+                    << messaget::eom;
+        return true;
+      }
+
+      threadt thread;
+      thread.parent = stack.back();
+      thread.spawn = it;
+      thread.begin = it->get_target();
+      thread_begins.emplace(thread.begin, threads.size());
+      threads.push_back(std::move(thread));
+    }
+    else if(it->is_end_thread())
+    {
+      if(stack.size() == 1)
+      {
+        log.error() << "END_THREAD outside of a thread body" << messaget::eom;
+        return true;
+      }
+
+      threads[stack.back()].end = it;
+      stack.pop_back();
+    }
+  }
+
+  if(stack.size() != 1)
+  {
+    log.error() << "thread body without END_THREAD" << messaget::eom;
+    return true;
+  }
+
+  // thread creation in loops would need one slot per iteration
+  for(const auto &instruction : entry_body.instructions)
+  {
+    if(!instruction.is_backwards_goto())
+      continue;
+
+    for(std::size_t t = 1; t < threads.size(); ++t)
+    {
+      const unsigned spawn = threads[t].spawn->location_number;
+      if(
+        instruction.get_target()->location_number <= spawn &&
+        spawn <= instruction.location_number)
+      {
+        log.warning() << "thread creation at "
+                      << threads[t].spawn->source_location
+                      << " is in a loop: only the first iteration will start "
+                         "a thread"
+                      << messaget::eom;
+      }
+    }
+  }
+
+  return false;
+}
+
+void lazy_sequentializationt::analyse_thread(threadt &thread)
+{
+  std::size_t atomic_depth = 0;
+
+  for(auto it = thread.body.instructions.begin();
+      it != thread.body.instructions.end();
+      ++it)
+  {
+    if(it->is_atomic_begin())
+    {
+      // other threads may run before an atomic section
+      if(atomic_depth == 0)
+        thread.switch_points.push_back(it);
+      ++atomic_depth;
+    }
+    else if(it->is_atomic_end() && atomic_depth > 0)
+      --atomic_depth;
+    else if(atomic_depth == 0 && may_access_shared_memory(*it))
+      thread.switch_points.push_back(it);
+
+    find_symbols_sett identifiers;
+    it->apply([&identifiers](const exprt &expr) {
+      find_symbols(expr, identifiers, true, false);
+    });
+
+    for(const auto &identifier : identifiers)
+    {
+      const symbolt *symbol = ns.get_symbol_table().lookup(identifier);
+      if(
+        symbol != nullptr &&
+        (is_local(*symbol) ||
+         (symbol->is_static_lifetime && symbol->is_thread_local)))
+      {
+        thread.variables.insert(identifier);
+      }
+    }
+  }
+}
+
+void lazy_sequentializationt::add_control_symbol(
+  const irep_idt &identifier,
+  const typet &type)
+{
+  symbolt symbol;
+  symbol.name = identifier;
+  symbol.base_name = identifier;
+  symbol.pretty_name = identifier;
+  symbol.type = type;
+  symbol.mode = ID_C;
+  symbol.is_lvalue = true;
+  symbol.is_static_lifetime = true;
+  symbol.is_state_var = true;
+  symbol.is_file_local = true;
+  goto_model.symbol_table.insert(std::move(symbol));
+}
+
+void lazy_sequentializationt::add_variable_copies(std::size_t t)
+{
+  threadt &thread = threads[t];
+
+  for(const auto &identifier : thread.variables)
+  {
+    const symbolt &symbol = ns.lookup(identifier);
+
+    // the main thread keeps its instances of thread-local variables
+    if(t == 0 && symbol.is_static_lifetime)
+      continue;
+
+    symbolt copy = symbol;
+    copy.name = id2string(identifier) + suffix(t);
+    copy.is_static_lifetime = true;
+    copy.is_thread_local = false;
+    copy.is_file_local = true;
+    copy.is_parameter = false;
+    if(!symbol.is_static_lifetime)
+      copy.value.make_nil();
+
+    thread.rename.insert(symbol.symbol_expr(), copy.symbol_expr());
+    goto_model.symbol_table.insert(std::move(copy));
+  }
+
+  add_control_symbol(CPROVER_PREFIX "cs_pc" + suffix(t), unsigned_int_type());
+  add_control_symbol(CPROVER_PREFIX "cs_active" + suffix(t), bool_typet());
+  add_control_symbol(CPROVER_PREFIX "cs_started" + suffix(t), bool_typet());
+}
+
+void lazy_sequentializationt::replace_spawn(std::size_t t)
+{
+  threadt &thread = threads[t];
+  const source_locationt &source_location = thread.spawn->source_location;
+
+  goto_programt spawn;
+
+  // each thread creation site provides a single thread
+  spawn.add(goto_programt::make_assumption(
+    not_exprt(started(t)), source_location));
+  spawn.add(goto_programt::make_assignment(
+    started(t), true_exprt(), source_location));
+  spawn.add(goto_programt::make_assignment(
+    active(t), true_exprt(), source_location));
+
+  // the new thread starts with a copy of the local variables of its parent,
+  // and with freshly initialised thread-local variables
+  for(const auto &identifier : thread.variables)
+  {
+    const symbolt &symbol = ns.lookup(identifier);
+    const symbol_exprt copy(id2string(identifier) + suffix(t), symbol.type);
+
+    if(!symbol.is_static_lifetime)
+    {
+      spawn.add(goto_programt::make_assignment(
+        copy, symbol.symbol_expr(), source_location));
+    }
+    else if(symbol.value.is_not_nil())
+    {
+      spawn.add(
+        goto_programt::make_assignment(copy, symbol.value, source_location));
+    }
+    else
+    {
+      const auto zero =
+        zero_initializer(symbol.type, symbol.location, ns);
+      spawn.add(goto_programt::make_assignment(
+        copy,
+        zero.has_value()
+          ? *zero
+          : side_effect_expr_nondett(symbol.type, source_location),
+        source_location));
+    }
+  }
+
+  goto_programt &parent_body = threads[thread.parent].body;
+  parent_body.insert_before_swap(thread.spawn, spawn);
+
+  // the START_THREAD instruction has been moved behind the new code
+  goto_programt::targett start_thread = thread.spawn;
+  while(!start_thread->is_start_thread())
+    ++start_thread;
+  start_thread->turn_into_skip();
+}
+
+/// Replace \p instruction by \p replacement, keeping the labels of
+/// \p instruction
+static void replace_instruction(
+  goto_programt::instructiont &instruction,
+  goto_programt::instructiont replacement)
+{
+  replacement.labels.swap(instruction.labels);
+  instruction = std::move(replacement);
+}
+
+void lazy_sequentializationt::instrument_thread(std::size_t t)
+{
+  threadt &thread = threads[t];
+  goto_programt &body = thread.body;
+
+  if(t != 0)
+    body.add(goto_programt::make_end_function(thread.end->source_location));
+
+  goto_programt::targett end_function = std::prev(body.instructions.end());
+
+  for(auto &instruction : body.instructions)
+  {
+    if(instruction.is_decl())
+    {
+      // static copies do not get declared, but havoced instead
+      const symbol_exprt symbol = instruction.decl_symbol();
+      replace_instruction(
+        instruction,
+        goto_programt::make_assignment(
+          symbol,
+          side_effect_expr_nondett(symbol.type(), instruction.source_location),
+          instruction.source_location));
+    }
+    else if(
+      instruction.is_dead() || instruction.is_atomic_begin() ||
+      instruction.is_atomic_end())
+    {
+      instruction.turn_into_skip();
+    }
+    else if(instruction.is_end_thread())
+    {
+      replace_instruction(
+        instruction,
+        goto_programt::make_assignment(
+          active(t), false_exprt(), instruction.source_location));
+    }
+  }
+
+  // the main thread is done once it returns
+  if(t == 0)
+  {
+    auto done = goto_programt::make_assignment(
+      active(t), false_exprt(), end_function->source_location);
+    body.insert_before_swap(end_function, done);
+    ++end_function;
+  }
+
+  for(auto &instruction : body.instructions)
+  {
+    instruction.transform([&thread](exprt expr) -> optionalt<exprt> {
+      if(thread.rename.replace(expr))
+        return {};
+      return std::move(expr);
+    });
+  }
+
+  // context switch points: leave the thread if the point is at or beyond the
+  // end of the current context, and record where to resume
+  goto_programt resume;
+  std::size_t point = 0;
+  for(const auto &target : thread.switch_points)
+  {
+    ++point;
+    const exprt point_expr = from_integer(point, unsigned_int_type());
+    const source_locationt &source_location = target->source_location;
+
+    body.insert_before_swap(target);
+    goto_programt::targett instruction = std::next(target);
+
+    *target = goto_programt::make_goto(
+      instruction,
+      binary_relation_exprt(context_end(), ID_gt, point_expr),
+      source_location);
+    goto_programt::targett save = body.insert_after(
+      target,
+      goto_programt::make_assignment(pc(t), point_expr, source_location));
+    body.insert_after(
+      save, goto_programt::make_goto(end_function, source_location));
+
+    resume.add(goto_programt::make_goto(
+      target, equal_exprt(pc(t), point_expr), source_location));
+  }
+
+  body.destructive_insert(body.instructions.begin(), resume);
+
+  log.statistics() << "Thread " << t << ": " << thread.switch_points.size()
+                   << " context switch points" << messaget::eom;
+}
+
+goto_programt
+lazy_sequentializationt::scheduler(const source_locationt &source_location)
+{
+  goto_programt result;
+
+  for(std::size_t t = 0; t < threads.size(); ++t)
+  {
+    result.add(goto_programt::make_assignment(
+      pc(t), from_integer(0, unsigned_int_type()), source_location));
+    result.add(goto_programt::make_assignment(
+      active(t), make_boolean_expr(t == 0), source_location));
+    result.add(goto_programt::make_assignment(
+      started(t), make_boolean_expr(t == 0), source_location));
+  }
+
+  const code_typet thread_type({}, empty_typet());
+
+  for(std::size_t round = 0; round < rounds; ++round)
+  {
+    for(std::size_t t = 0; t < threads.size(); ++t)
+    {
+      goto_programt::targett skip_thread =
+        result.add(goto_programt::make_incomplete_goto(
+          not_exprt(active(t)), source_location));
+
+      result.add(goto_programt::make_assignment(
+        context_end(),
+        side_effect_expr_nondett(unsigned_int_type(), source_location),
+        source_location));
+      result.add(goto_programt::make_function_call(
+        code_function_callt(symbol_exprt(function_id(t), thread_type)),
+        source_location));
+
+      skip_thread->complete_goto(
+        result.add(goto_programt::make_skip(source_location)));
+    }
+  }
+
+  result.add(goto_programt::make_end_function(source_location));
+
+  return result;
+}
+
+bool lazy_sequentializationt::operator()()
+{
+  const irep_idt entry_point = goto_functionst::entry_point();
+  auto entry = goto_model.goto_functions.function_map.find(entry_point);
+  if(entry == goto_model.goto_functions.function_map.end())
+  {
+    log.error() << "lazy sequentialization requires an entry point"
+                << messaget::eom;
+    return true;
+  }
+
+  goto_function_inline(goto_model, entry_point, log.get_message_handler());
+  goto_model.goto_functions.update();
+
+  for(const auto &instruction : entry->second.body.instructions)
+  {
+    if(!instruction.is_function_call())
+      continue;
+
+    const exprt &callee = instruction.get_function_call().function();
+    if(callee.id() != ID_symbol)
+      continue;
+
+    auto function = goto_model.goto_functions.function_map.find(
+      to_symbol_expr(callee).get_identifier());
+    if(function == goto_model.goto_functions.function_map.end())
+      continue;
+
+    for(const auto &callee_instruction : function->second.body.instructions)
+    {
+      if(callee_instruction.is_start_thread())
+      {
+        log.error() << "thread creation in " << function->first
+                    << ", which cannot be inlined, is not supported"
+                    << messaget::eom;
+        return true;
+      }
+    }
+  }
+
+  goto_programt &entry_body = entry->second.body;
+  if(find_threads(entry_body))
+    return true;
+
+  if(threads.size() == 1)
+  {
+    log.status() << "No threads found, nothing to sequentialize"
+                 << messaget::eom;
+    return false;
+  }
+
+  const source_locationt source_location =
+    entry_body.instructions.front().source_location;
+
+  // nested threads have a higher index than the thread that creates them
+  for(std::size_t t = threads.size() - 1; t > 0; --t)
+  {
+    threads[t].body.instructions.splice(
+      threads[t].body.instructions.end(),
+      entry_body.instructions,
+      threads[t].begin,
+      std::next(threads[t].end));
+  }
+  threads[0].body.instructions.splice(
+    threads[0].body.instructions.end(), entry_body.instructions);
+
+  for(auto &thread : threads)
+    analyse_thread(thread);
+
+  // a thread passes copies of its locals to the threads it creates
+  for(std::size_t t = threads.size() - 1; t > 0; --t)
+  {
+    for(const auto &identifier : threads[t].variables)
+    {
+      if(is_local(ns.lookup(identifier)))
+        threads[threads[t].parent].variables.insert(identifier);
+    }
+  }
+
+  for(std::size_t t = 0; t < threads.size(); ++t)
+    add_variable_copies(t);
+  add_control_symbol(CPROVER_PREFIX "cs_next", unsigned_int_type());
+
+  for(std::size_t t = 1; t < threads.size(); ++t)
+    replace_spawn(t);
+
+  for(std::size_t t = 0; t < threads.size(); ++t)
+  {
+    instrument_thread(t);
+
+    symbolt symbol;
+    symbol.name = function_id(t);
+    symbol.base_name = symbol.name;
+    symbol.pretty_name = symbol.name;
+    symbol.type = code_typet({}, empty_typet());
+    symbol.mode = ID_C;
+    symbol.location = source_location;
+    goto_model.symbol_table.insert(std::move(symbol));
+
+    goto_model.goto_functions.function_map[function_id(t)].body.swap(
+      threads[t].body);
+  }
+
+  goto_programt driver = scheduler(source_location);
+  entry_body.swap(driver);
+
+  goto_model.goto_functions.update();
+
+  log.status() << "Sequentialized " << threads.size() << " threads with "
+               << rounds << " rounds of context switches" << messaget::eom;
+
+  return false;
+}
+
+bool lazy_sequentialization(
+  goto_modelt &goto_model,
+  std::size_t rounds,
+  message_handlert &message_handler)
+{
+  return lazy_sequentializationt(goto_model, rounds, message_handler)();
+}
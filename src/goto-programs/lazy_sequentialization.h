@@ -0,0 +1,47 @@
+/*******************************************************************\
+
+Module: Lazy Sequentialization of Concurrent Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Lazy Sequentialization of Concurrent Programs
+
+#ifndef CPROVER_GOTO_PROGRAMS_LAZY_SEQUENTIALIZATION_H
+#define CPROVER_GOTO_PROGRAMS_LAZY_SEQUENTIALIZATION_H
+
+#include <cstddef>
+
+class goto_modelt;
+class message_handlert;
+
+/// Replace the threads of a concurrent program by a sequential program that
+/// simulates all executions with at most \p rounds round-robin rounds of
+/// context switches, in the style of Lazy-CSeq.
+///
+/// The entry point is inlined and each thread body (START_THREAD ...
+/// END_THREAD) is moved into a function of its own. Local and thread-local
+/// variables become one static variable per thread, so that their values
+/// survive context switches. Before each instruction that may access shared
+/// memory (outside atomic sections) a context switch point is inserted: the
+/// thread returns to the scheduler if the point is at or beyond the
+/// nondeterministically chosen end of the current context, and resumes at
+/// the same point when it is scheduled again. The new entry point schedules
+/// the active threads in creation order for \p rounds rounds.
+///
+/// Each thread creation site starts at most one thread; executions that
+/// would start further threads from the same site are not considered, just
+/// like executions that need more than \p rounds rounds.
+/// \param goto_model: model to transform; function pointers must have been
+///   removed already
+/// \param rounds: number of round-robin rounds
+/// \param message_handler: for status and error messages
+/// \return true on error
+bool lazy_sequentialization(
+  goto_modelt &goto_model,
+  std::size_t rounds,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_PROGRAMS_LAZY_SEQUENTIALIZATION_H
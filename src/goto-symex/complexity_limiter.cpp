@@ -10,17 +10,23 @@ Author: John Dumbell
 #include "goto_symex_state.h"
 #include <cmath>
 
+#include <util/memory_info.h>
+
 complexity_limitert::complexity_limitert(
   message_handlert &message_handler,
   const optionst &options)
   : log(message_handler)
 {
   std::size_t limit = options.get_signed_int_option("symex-complexity-limit");
-  if((complexity_active = limit > 0))
+  memory_budget = static_cast<std::size_t>(
+                    options.get_unsigned_int_option("symex-memory-limit")) *
+                  1024 * 1024;
+  if((complexity_active = limit > 0 || memory_budget > 0))
   {
     // This gives a curve that allows low limits to be rightly restrictive,
     // while larger numbers are very large.
-    max_complexity = static_cast<std::size_t>((limit * limit) * 25);
+    if(limit > 0)
+      max_complexity = static_cast<std::size_t>((limit * limit) * 25);
 
     const std::size_t failed_child_loops_limit = options.get_signed_int_option(
       "symex-complexity-failed-child-loops-limit");
@@ -35,8 +41,128 @@ complexity_limitert::complexity_limitert(
       max_loops_complexity = failed_child_loops_limit;
     else if(unwind > 0)
       max_loops_complexity = std::max(static_cast<int>(floor(unwind / 3)), 1);
-    else
+    else if(limit > 0)
       max_loops_complexity = limit;
+    else
+    {
+      // Only limited by memory: cancelling a single branch under memory
+      // pressure should not already stop a loop from being unwound.
+      max_loops_complexity = memory_only_max_loops_complexity;
+    }
+  }
+}
+
+std::size_t complexity_limitert::effective_max_complexity() const
+{
+  if(memory_max_complexity == 0)
+    return max_complexity;
+  if(max_complexity == 0)
+    return memory_max_complexity;
+  return std::min(max_complexity, memory_max_complexity);
+}
+
+static std::size_t to_mib(std::size_t bytes)
+{
+  return bytes / (1024 * 1024);
+}
+
+void complexity_limitert::adapt_to_memory_usage(const goto_symex_statet &state)
+{
+  if(baseline_resident_memory == 0)
+  {
+    baseline_resident_memory = resident_set_size();
+    // not supported on this platform
+    if(baseline_resident_memory == 0)
+    {
+      memory_budget = 0;
+      return;
+    }
+  }
+
+  if(++steps_since_memory_check < memory_check_interval)
+    return;
+  steps_since_memory_check = 0;
+
+  // Only the memory symex has allocated since it started counts against the
+  // budget, not the goto model and whatever else was loaded before.
+  const std::size_t resident_memory = resident_set_size();
+  const std::size_t used_memory =
+    resident_memory > baseline_resident_memory
+      ? resident_memory - baseline_resident_memory
+      : 0;
+
+  const std::size_t equation_size =
+    state.symex_target == nullptr ? 0 : state.symex_target->SSA_steps.size();
+
+  // Project the memory usage at the next sample by extrapolating both the
+  // growth of memory and the growth of the equation (at the current average
+  // cost per SSA step) since the last sample.
+  std::size_t projected_memory = used_memory;
+  const bool growing = used_memory > last_used_memory;
+  if(growing)
+  {
+    projected_memory =
+      std::max(projected_memory, 2 * used_memory - last_used_memory);
+  }
+  if(equation_size > last_equation_size && equation_size != 0)
+  {
+    const std::size_t bytes_per_step = used_memory / equation_size;
+    projected_memory = std::max(
+      projected_memory,
+      used_memory + (equation_size - last_equation_size) * bytes_per_step);
+  }
+
+  last_used_memory = used_memory;
+  last_equation_size = equation_size;
+
+  // Limit imposed when memory pressure first occurs, and the lowest limit
+  // tightening may go down to.
+  const std::size_t initial_memory_max_complexity = 100000;
+  const std::size_t min_memory_max_complexity = 16;
+
+  // The limit only changes when the projection leaves the band between
+  // three quarters of the budget and the budget, and is only tightened
+  // further while memory is still growing: a previous tightening needs a few
+  // samples to take effect, and halving again in the meantime would cut far
+  // more than necessary.
+  const std::size_t low_watermark = memory_budget / 4 * 3;
+
+  if(
+    projected_memory > memory_budget &&
+    (growing || memory_max_complexity == 0))
+  {
+    const std::size_t current_limit = effective_max_complexity();
+    const std::size_t new_limit =
+      current_limit == 0
+        ? initial_memory_max_complexity
+        : std::max(current_limit / 2, min_memory_max_complexity);
+    if(new_limit == memory_max_complexity)
+      return;
+    memory_max_complexity = new_limit;
+
+    log.warning() << "[symex-complexity] projected memory usage of "
+                  << to_mib(projected_memory) << " MiB exceeds the budget of "
+                  << to_mib(memory_budget)
+                  << " MiB, limiting branch complexity to "
+                  << memory_max_complexity << messaget::eom;
+  }
+  else if(memory_max_complexity != 0 && projected_memory < low_watermark)
+  {
+    memory_max_complexity *= 2;
+    if(
+      memory_max_complexity >= initial_memory_max_complexity ||
+      (max_complexity != 0 && memory_max_complexity >= max_complexity))
+    {
+      memory_max_complexity = 0;
+    }
+
+    log.status() << "[symex-complexity] memory usage of "
+                 << to_mib(used_memory) << " MiB is within the budget, "
+                 << (memory_max_complexity == 0
+                       ? std::string("lifting memory-based limit")
+                       : "relaxing branch complexity limit to " +
+                           std::to_string(memory_max_complexity))
+                 << messaget::eom;
   }
 }
 
@@ -136,8 +262,14 @@ complexity_limitert::check_complexity(goto_symex_statet &state)
   if(!complexity_limits_active() || !state.reachable)
     return complexity_violationt::NONE;
 
-  std::size_t complexity =
-    bounded_expr_size(state.guard.as_expr(), max_complexity);
+  if(memory_budget != 0)
+    adapt_to_memory_usage(state);
+
+  const std::size_t limit = effective_max_complexity();
+  if(limit == 0)
+    return complexity_violationt::NONE;
+
+  std::size_t complexity = bounded_expr_size(state.guard.as_expr(), limit);
   if(complexity == 1)
     return complexity_violationt::NONE;
 
@@ -145,7 +277,7 @@ complexity_limitert::check_complexity(goto_symex_statet &state)
 
   // Check if this branch is too complicated to continue.
   auto active_loop = get_current_active_loop(current_call_stack);
-  if(complexity >= max_complexity)
+  if(complexity >= limit)
   {
     // If we're too complex, add a counter to the current loop we're in and
     // check if we've violated child-loop complexity limits.
@@ -202,10 +334,62 @@ complexity_limitert::check_complexity(goto_symex_statet &state)
   return complexity_violationt::NONE;
 }
 
+void complexity_limitert::record_pruned(
+  complexity_violationt complexity_violation,
+  const goto_symex_statet &state)
+{
+  const source_locationt &source_location = state.source.pc->source_location;
+  pruned_countt &count =
+    pruned[source_location.is_not_nil()
+             ? source_location.as_string()
+             : "location number " +
+                 std::to_string(state.source.pc->location_number)];
+
+  switch(complexity_violation)
+  {
+  case complexity_violationt::BRANCH:
+    ++count.branches;
+    break;
+  case complexity_violationt::LOOP:
+    ++count.loops;
+    break;
+  case complexity_violationt::NONE:
+    break;
+  }
+}
+
+void complexity_limitert::output_report() const
+{
+  if(pruned.empty())
+    return;
+
+  std::size_t branches = 0;
+  std::size_t loops = 0;
+  for(const auto &entry : pruned)
+  {
+    branches += entry.second.branches;
+    loops += entry.second.loops;
+  }
+
+  log.status() << "[symex-complexity] cancelled " << branches
+               << " branches and " << loops << " loop executions"
+               << messaget::eom;
+
+  for(const auto &entry : pruned)
+  {
+    log.statistics() << "[symex-complexity]   " << entry.first << ": "
+                     << entry.second.branches << " branches, "
+                     << entry.second.loops << " loop executions"
+                     << messaget::eom;
+  }
+}
+
 void complexity_limitert::run_transformations(
   complexity_violationt complexity_violation,
   goto_symex_statet &current_state)
 {
+  record_pruned(complexity_violation, current_state);
+
   if(violation_transformations.empty())
     default_transformation.transform(complexity_violation, current_state);
   else
@@ -15,6 +15,9 @@ Author: John Dumbell
 #include "complexity_violation.h"
 #include "symex_complexity_limit_exceeded_action.h"
 
+#include <map>
+#include <string>
+
 class optionst;
 
 /// Symex complexity module.
@@ -34,6 +37,15 @@ class optionst;
 /// as the loop iteration ends and the context in which the code is being
 /// executed changes it'll be able to be run again.
 ///
+/// With a memory budget (`--symex-memory-limit`) the limiter additionally
+/// samples the memory allocated since symex started and the growth of the
+/// equation at regular intervals. While the projected memory usage exceeds the
+/// budget and keeps growing, the complexity limit is tightened step by step,
+/// so that increasingly simpler branches are cancelled and their loops
+/// blacklisted; once usage has dropped below three quarters of the budget the
+/// limit is relaxed again. All cancelled branches and loops are summarised by
+/// \ref output_report.
+///
 /// Example of loop blacklisting:
 ///
 ///     loop A: (complexity: 5070)
@@ -70,6 +82,10 @@ public:
     complexity_violationt complexity_violation,
     goto_symex_statet &current_state);
 
+  /// Log a summary of the branches and loops that were cancelled, per
+  /// source location.
+  void output_report() const;
+
   /// Amount of nodes in \p expr approximately bounded by limit.
   /// This is the size of the actual tree, ignoring memory/sub-tree sharing.
   /// Expressions that make substantial use of sharing may result in excessive
@@ -100,6 +116,48 @@ protected:
   /// before the entire loop is abandoned.
   std::size_t max_loops_complexity = 0;
 
+  /// Memory budget in bytes, 0 if memory usage is not being monitored.
+  std::size_t memory_budget = 0;
+
+  /// Complexity limit imposed due to memory pressure, 0 while there is none.
+  std::size_t memory_max_complexity = 0;
+
+  /// Symex steps between two samples of the memory usage.
+  static const std::size_t memory_check_interval = 1000;
+
+  std::size_t steps_since_memory_check = 0;
+
+  /// Resident memory when symex started, which is not part of the budget.
+  std::size_t baseline_resident_memory = 0;
+
+  /// Memory used by symex and equation size at the last sample.
+  std::size_t last_used_memory = 0;
+  std::size_t last_equation_size = 0;
+
+  /// Default for max_loops_complexity when only a memory budget is set.
+  static const std::size_t memory_only_max_loops_complexity = 10;
+
+  /// Number of cancelled branches and loops per source location.
+  struct pruned_countt
+  {
+    std::size_t branches = 0;
+    std::size_t loops = 0;
+  };
+  std::map<std::string, pruned_countt> pruned;
+
+  friend class symex_checkpointt;
+
+  /// The complexity limit currently in force, 0 if there is none.
+  std::size_t effective_max_complexity() const;
+
+  /// Sample memory usage every `memory_check_interval` steps and tighten or
+  /// relax `memory_max_complexity` accordingly.
+  void adapt_to_memory_usage(const goto_symex_statet &state);
+
+  void record_pruned(
+    complexity_violationt complexity_violation,
+    const goto_symex_statet &state);
+
   /// Checks whether the current loop execution stack has violated
   /// max_loops_complexity.
   bool are_loop_children_too_complicated(call_stackt &current_call_stack);
@@ -37,6 +37,8 @@ public:
 protected:
   symex_level2t level2;
 
+  friend class symex_checkpointt;
+
 public:
   /// This is used for eliminating repeated complicated dereferences.
   /// \see goto_symext::dereference_rec
@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/message.h>
 
+#include <chrono>
+
 #include "complexity_limiter.h"
 #include "loopstack.hpp"
 #include "path_storage.h"
@@ -26,6 +28,7 @@ class goto_symex_statet;
 class path_storaget;
 class side_effect_exprt;
 class symex_assignt;
+class symex_checkpointt;
 class typet;
 
 enum class recursing_decisiont
@@ -78,6 +81,9 @@ public:
       complexity_module(mh, options)
   {
     target.set_loop_stack(&ls_stack);
+
+    if(mh.get_verbosity() >= messaget::M_STATISTICS)
+      guard_manager.enable_statistics();
   }
 
   /// A virtual destructor allowing derived classes to be cleaned up correctly
@@ -138,6 +144,32 @@ public:
     symex_target_equationt *const saved_equation,
     symbol_tablet &new_symbol_table);
 
+  /// Performs symbolic execution from the snapshot of the state that a
+  /// previous run saved in \p checkpoint, see \ref set_checkpoint.
+  /// \param checkpoint: checkpoint holding the snapshot
+  /// \param functions: the goto functions the snapshot was taken with
+  /// \param get_goto_function: The delegate to retrieve function bodies (see
+  ///   \ref get_goto_functiont)
+  /// \param new_symbol_table: A symbol table to store the symbols added during
+  ///   symbolic execution
+  virtual void symex_from_checkpoint(
+    const symex_checkpointt &checkpoint,
+    const goto_functionst &functions,
+    const get_goto_functiont &get_goto_function,
+    symbol_tablet &new_symbol_table);
+
+  /// Save a snapshot of the symex state to \p checkpoint whenever at least
+  /// \p interval has passed since the previous snapshot. Snapshots are taken
+  /// between two symex steps of the outermost \ref symex_with_state.
+  void set_checkpoint(
+    const symex_checkpointt &checkpoint,
+    std::chrono::seconds interval)
+  {
+    this->checkpoint = &checkpoint;
+    checkpoint_interval = interval;
+    next_checkpoint = std::chrono::steady_clock::now() + interval;
+  }
+
   //// \brief Symbolically execute the entire program starting from entry point
   ///
   /// This method uses the `state` argument as the symbolic execution
@@ -303,7 +335,16 @@ protected:
   /// The messaget to write log messages to
   mutable messaget log;
 
+  /// Where to save snapshots of the state, see \ref set_checkpoint
+  const symex_checkpointt *checkpoint = nullptr;
+  std::chrono::seconds checkpoint_interval;
+  std::chrono::steady_clock::time_point next_checkpoint;
+
+  /// Save a snapshot of \p state if the checkpoint interval has passed
+  void save_checkpoint_if_due(const statet &state);
+
   friend class symex_dereference_statet;
+  friend class symex_checkpointt;
 
   void trigger_auto_object(const exprt &, statet &);
   void initialize_auto_object(const exprt &, statet &);
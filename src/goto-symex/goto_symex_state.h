@@ -139,6 +139,8 @@ protected:
   typedef std::unordered_map<irep_idt, typet> l1_typest;
   l1_typest l1_types;
 
+  friend class symex_checkpointt;
+
 public:
   // guards
   static irep_idt guard_identifier()
@@ -4,6 +4,7 @@
 
 #include "loopstack.hpp"
 #include "analyses/guard_expr.h"
+#include <algorithm>
 #include <cstring>
 #include <expr_iterator.h>
 #include <string_utils.h>
@@ -130,6 +131,10 @@ guard_variablest get_guard_variables(const guard_exprt &guard, size_t omit_last)
   }
   assert(!guard.is_false());
 
+  auto is_literal = [](const exprt &expr) {
+    return expr.id() == ID_symbol ||
+           (expr.id() == ID_not && to_not_expr(expr).op().id() == ID_symbol);
+  };
   auto func = [](exprt expr) {
     assert(!expr.is_constant());
     if(expr.id() == ID_not)
@@ -143,11 +148,15 @@ guard_variablest get_guard_variables(const guard_exprt &guard, size_t omit_last)
   auto expr = guard.as_expr();
   if(expr.id() != ID_and)
   {
+    if(!is_literal(expr))
+      return {};
     return {func(expr)};
   }
   std::vector<std::tuple<dstringt, bool>> ret;
   auto ops = to_and_expr(expr).operands();
   PRECONDITION(omit_last < ops.size());
+  if(!std::all_of(ops.begin(), ops.end() - omit_last, is_literal))
+    return {};
   std::transform(
     ops.begin(), ops.end() - omit_last, std::back_inserter(ret), func);
   return ret;
@@ -288,7 +297,7 @@ void loopt::end_loop(size_t end_scope)
   iterations.pop_back();
 }
 
-void loopt::add_guard(guard_exprt &iter_guard)
+void loopt::add_guard(const guard_exprt &iter_guard)
 {
   guards.push_back(iter_guard);
 }
@@ -413,7 +422,7 @@ std::vector<dstringt> loop_stackt::variables(
   return ret;
 }
 
-void loop_stackt::set_iter_guard(guard_exprt &guard)
+void loop_stackt::set_iter_guard(const guard_exprt &guard)
 {
   if(!loop_stack.empty())
   {
@@ -97,6 +97,7 @@ public:
   bool split_before(dstringt id) const;
 
   bool matches_guard(dstringt guard_var) const;
+  friend class symex_checkpointt;
 };
 
 template <typename T>
@@ -182,6 +183,7 @@ public:
   {
     this->guard = std::move(guard);
   }
+  friend class symex_checkpointt;
 };
 
 /// the last loop iteration
@@ -243,6 +245,7 @@ public:
   {
     return output;
   }
+  friend class symex_checkpointt;
 };
 
 class loop_stackt;
@@ -250,7 +253,8 @@ class loop_stackt;
 /// [(guard_var, value it is assumed to have)]
 using guard_variablest = std::vector<std::tuple<dstringt, bool>>;
 
-/// returns [(guard_var, value it is assumed to have)]
+/// returns [(guard_var, value it is assumed to have)], or nothing if the
+/// guard is not a conjunction of guard variables and their negations
 guard_variablest
 get_guard_variables(const guard_exprt &guard, size_t omit_last = 0);
 
@@ -273,7 +277,7 @@ public:
 
   const size_t depth;
   /// guard in the context (remove later all guards that are part of the guards variable)
-  const guardt context_guard;
+  const guard_exprt context_guard;
 
   /// hint on whether the loop can be safely fully over approximated, dtodo: improve
   const bool should_fully_over_approximate;
@@ -298,7 +302,7 @@ public:
     optionalt<size_t> parent_loop_id,
     loop_stackt *stack,
     const size_t depth,
-    guardt context_guard,
+    guard_exprt context_guard,
     size_t before_end_scope,
     bool should_fully_over_approximate)
     : id(id),
@@ -342,7 +346,7 @@ public:
 
   void push_iteration(size_t end_scope_of_last, size_t end_scope);
   void end_loop(size_t end_scope);
-  void add_guard(guard_exprt &iter_guard);
+  void add_guard(const guard_exprt &iter_guard);
 
   bool in_last_iteration() const
   {
@@ -383,6 +387,7 @@ public:
     const assign_unknownt &assign_unknown);
 
   void end_loop(const resolvet &resolve, const assign_unknownt &assign_unknown);
+  friend class symex_checkpointt;
 };
 
 /// nested loops that form a stack
@@ -496,7 +501,7 @@ public:
   /// if it does not yet have a loop iteration
   ///
   /// \param guard guard (should consist of a conjuction of guards from the outer most to the inner most if expression)
-  void set_iter_guard(guard_exprt &guard);
+  void set_iter_guard(const guard_exprt &guard);
 
   void emit(std::ostream &os) const;
 
@@ -507,6 +512,7 @@ public:
   {
     emit(std::cout);
   }
+  friend class symex_checkpointt;
 };
 
 #endif //CBMC_LOOPSTACK_HPP
@@ -22,7 +22,7 @@ std::ostream &operator<<(std::ostream &os, const ls_recursion_childt &child)
 ls_recursion_childt ls_recursion_childt::create(
   size_t id,
   const ls_func_info &info,
-  const guardt &guard,
+  const guard_exprt &guard,
   const resolvet &resolve,
   const assign_unknownt &assign_unknown)
 {
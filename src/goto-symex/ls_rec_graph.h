@@ -9,7 +9,7 @@ Author: Johannes Bechberger, johannes.bechberger@kit.edu
 #ifndef CBMC_LS_REC_GRAPH_H
 #define CBMC_LS_REC_GRAPH_H
 
-#include "analyses/guard.h"
+#include "analyses/guard_expr.h"
 #include "ls_info.h"
 #include <cstring>
 #include <dstring.h>
@@ -84,6 +84,7 @@ protected:
       output(std::move(output))
   {
   }
+  friend class symex_checkpointt;
 };
 
 /// an aborted recursion that references a function
@@ -93,14 +94,14 @@ class ls_recursion_childt : public ls_recursion_baset
   /// id of the specific recursive application (counting from 0 onwards on each creation)
   const size_t id;
   /// guard that has is satisfied on the start of this recursive application
-  const guardt guard;
+  const guard_exprt guard;
 
   ls_recursion_childt(
     size_t id,
     const ls_func_info &info,
     name_mappingt input,
     name_mappingt output,
-    const guardt &guard)
+    const guard_exprt &guard)
     : ls_recursion_baset(info, std::move(input), std::move(output)),
       id(id),
       guard(guard)
@@ -120,9 +121,10 @@ public:
   static ls_recursion_childt create(
     size_t id,
     const ls_func_info &info,
-    const guardt &guard,
+    const guard_exprt &guard,
     const resolvet &resolve,
     const assign_unknownt &assign_unknown);
+  friend class symex_checkpointt;
 };
 
 /// an abstract recursive function
@@ -208,7 +210,7 @@ public:
 
   void create_rec_child(
     const requested_functiont &func,
-    const guardt &guard,
+    const guard_exprt &guard,
     const resolvet &resolve,
     const assign_unknownt &assign_unknown)
   {
@@ -266,6 +268,7 @@ public:
   {
     return in_abstract_processing;
   }
+  friend class symex_checkpointt;
 };
 
 #endif //CBMC_LS_REC_GRAPH_H
@@ -11,6 +11,8 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 
 #include "memory_model.h"
 
+#include <util/message.h>
+#include <util/optional.h>
 #include <util/std_expr.h>
 
 memory_model_baset::memory_model_baset(const namespacet &_ns)
@@ -32,7 +34,7 @@ bool memory_model_baset::po(event_it e1, event_it e2)
 {
   // within same thread
   if(e1->source.thread_nr == e2->source.thread_nr)
-    return numbering[e1] < numbering[e2];
+    return thread_number(e1) < thread_number(e2);
   else
   {
     // in general un-ordered, with exception of thread-spawning
@@ -40,30 +42,62 @@ bool memory_model_baset::po(event_it e1, event_it e2)
   }
 }
 
-void memory_model_baset::read_from(symex_target_equationt &equation)
+void memory_model_baset::read_from(
+  symex_target_equationt &equation,
+  message_handlert &message_handler)
 {
   // We iterate over all the reads, and
   // make them match at least one
   // (internal or external) write.
 
+  choice_symbols.resize(events.size());
+  std::size_t number_of_choices = 0;
+  std::size_t number_of_pruned_choices = 0;
+
   for(const auto &address : address_map)
   {
     for(const auto &read_event : address.second.reads)
     {
+      // The last write to this address that is executed unconditionally
+      // before the read in the same thread: any write that precedes it in
+      // program order is overwritten before the read takes place.
+      optionalt<event_it> last_write;
+      for(const auto &write_event : address.second.writes)
+      {
+        if(
+          write_event->source.thread_nr == read_event->source.thread_nr &&
+          write_event->guard.is_true() && po(write_event, read_event) &&
+          (read_event->atomic_section_id == 0 ||
+           read_event->atomic_section_id != write_event->atomic_section_id) &&
+          (!last_write.has_value() || po(*last_write, write_event)))
+        {
+          last_write = write_event;
+        }
+      }
+
       exprt::operandst rf_choice_symbols;
       rf_choice_symbols.reserve(address.second.writes.size());
 
       // this is quadratic in #events per address
       for(const auto &write_event : address.second.writes)
       {
-        // rf cannot contradict program order
-        if(!po(read_event, write_event))
+        // rf cannot contradict program order or the order imposed by thread
+        // creation, and cannot observe a write that has been overwritten
+        if(
+          po(read_event, write_event) ||
+          spawned_after(read_event, write_event) ||
+          (last_write.has_value() && po(write_event, *last_write)))
         {
-          rf_choice_symbols.push_back(register_read_from_choice_symbol(
-            read_event, write_event, equation));
+          ++number_of_pruned_choices;
+          continue;
         }
+
+        rf_choice_symbols.push_back(register_read_from_choice_symbol(
+          read_event, write_event, equation));
       }
 
+      number_of_choices += rf_choice_symbols.size();
+
       // uninitialised global symbol like symex_dynamic::dynamic_object*
       // or *$object
       if(!rf_choice_symbols.empty())
@@ -78,6 +112,10 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
       }
     }
   }
+
+  messaget log{message_handler};
+  log.statistics() << "Read-from choices: " << number_of_choices << " ("
+                   << number_of_pruned_choices << " pruned)" << messaget::eom;
 }
 
 symbol_exprt memory_model_baset::register_read_from_choice_symbol(
@@ -88,7 +126,7 @@ symbol_exprt memory_model_baset::register_read_from_choice_symbol(
   symbol_exprt s = nondet_bool_symbol("rf");
 
   // record the symbol
-  choice_symbols.emplace(std::make_pair(r, w), s);
+  choice_symbols[index(w)].push_back({r, s});
 
   bool is_rfi = w->source.thread_nr == r->source.thread_nr;
   // Uses only the write's guard as precondition, read's guard
@@ -35,14 +35,28 @@ protected:
 
   // This gives us the choice symbol for an R-W pair;
   // built by the method below.
-  typedef std::map<std::pair<event_it, event_it>, symbol_exprt> choice_symbolst;
-  choice_symbolst choice_symbols;
+  struct read_from_choicet
+  {
+    event_it read;
+    symbol_exprt choice;
+  };
+  typedef std::vector<read_from_choicet> read_from_choicest;
+
+  /// The reads that may read from each write, together with their choice
+  /// symbols; indexed by the dense index of the write
+  std::vector<read_from_choicest> choice_symbols;
 
   /// For each read `r` from every address we collect the choice symbols `S`
   ///   via \ref register_read_from_choice_symbol (for potential read-write
   ///   pairs) and add a constraint r.guard => \/S.
+  /// Pairs that would contradict the order imposed by program order or
+  ///   thread creation are not considered, and neither are writes that are
+  ///   necessarily overwritten in the reading thread before the read.
   /// \param equation: symex equation where the new constraint should be added
-  void read_from(symex_target_equationt &equation);
+  /// \param message_handler: message handler to output statistics
+  void read_from(
+    symex_target_equationt &equation,
+    message_handlert &message_handler);
 
   /// Introduce a new choice symbol `s` for the pair (\p r, \p w)
   /// add constraint s => (w.guard /\ r.lhs=w.lhs)
@@ -20,7 +20,7 @@ operator()(symex_target_equationt &equation, message_handlert &message_handler)
   build_event_lists(equation, message_handler);
   build_clock_type();
 
-  read_from(equation);
+  read_from(equation, message_handler);
   write_serialization_external(equation);
   program_order(equation);
 #ifndef CPROVER_MEMORY_MODEL_SUP_CLOCK
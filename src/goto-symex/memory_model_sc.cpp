@@ -22,7 +22,7 @@ operator()(symex_target_equationt &equation, message_handlert &message_handler)
   build_event_lists(equation, message_handler);
   build_clock_type();
 
-  read_from(equation);
+  read_from(equation, message_handler);
   write_serialization_external(equation);
   program_order(equation);
   from_read(equation);
@@ -225,6 +225,11 @@ void memory_model_sct::write_serialization_external(
            (*w_it2)->source.thread_nr)
           continue;
 
+        // already ordered by thread creation?
+        if(spawned_after(*w_it1, *w_it2) ||
+           spawned_after(*w_it2, *w_it1))
+          continue;
+
         // ws is a total order, no two elements have the same rank
         // s -> w_evt1 before w_evt2; !s -> w_evt2 before w_evt1
 
@@ -273,14 +278,16 @@ void memory_model_sct::from_read(symex_target_equationt &equation)
       {
         exprt ws1, ws2;
 
-        if(po(*w_prime, *w) &&
-           !program_order_is_relaxed(*w_prime, *w))
+        if((po(*w_prime, *w) &&
+            !program_order_is_relaxed(*w_prime, *w)) ||
+           spawned_after(*w_prime, *w))
         {
           ws1=true_exprt();
           ws2=false_exprt();
         }
-        else if(po(*w, *w_prime) &&
-                !program_order_is_relaxed(*w, *w_prime))
+        else if((po(*w, *w_prime) &&
+                 !program_order_is_relaxed(*w, *w_prime)) ||
+                spawned_after(*w, *w_prime))
         {
           ws1=false_exprt();
           ws2=true_exprt();
@@ -291,45 +298,46 @@ void memory_model_sct::from_read(symex_target_equationt &equation)
           ws2=before(*w, *w_prime);
         }
 
-        // smells like cubic
-        for(choice_symbolst::const_iterator
-            c_it=choice_symbols.begin();
-            c_it!=choice_symbols.end();
-            c_it++)
+        // only the reads that read from either of the two writes are
+        // affected
+        if(!ws1.is_false())
         {
-          event_it r=c_it->first.first;
-          exprt rf=c_it->second;
-          exprt cond;
-          cond.make_nil();
-
-          if(c_it->first.second==*w_prime && !ws1.is_false())
+          for(const auto &choice : choice_symbols[index(*w_prime)])
           {
+            event_it r=choice.read;
             exprt fr=before(r, *w);
 
             // the guard of w_prime follows from rf; with rfi
             // optimisation such as the previous write_symbol_primed
             // it would even be wrong to add this guard
-            cond=
+            add_constraint(
+              equation,
               implies_exprt(
-                and_exprt(r->guard, (*w)->guard, ws1, rf),
-                fr);
+                and_exprt(r->guard, (*w)->guard, ws1, choice.choice),
+                fr),
+              "fr",
+              r->source);
           }
-          else if(c_it->first.second==*w && !ws2.is_false())
+        }
+
+        if(!ws2.is_false())
+        {
+          for(const auto &choice : choice_symbols[index(*w)])
           {
+            event_it r=choice.read;
             exprt fr=before(r, *w_prime);
 
             // the guard of w follows from rf; with rfi
             // optimisation such as the previous write_symbol_primed
             // it would even be wrong to add this guard
-            cond=
+            add_constraint(
+              equation,
               implies_exprt(
-                and_exprt(r->guard, (*w_prime)->guard, ws2, rf),
-                fr);
+                and_exprt(r->guard, (*w_prime)->guard, ws2, choice.choice),
+                fr),
+              "fr",
+              r->source);
           }
-
-          if(cond.is_not_nil())
-            add_constraint(equation,
-              cond, "fr", r->source);
         }
       }
     }
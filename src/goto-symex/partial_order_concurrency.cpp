@@ -78,9 +78,9 @@ void partial_order_concurrencyt::build_event_lists(
   add_init_writes(equation);
 
   // a per-thread counter
-  std::map<unsigned, unsigned> counter;
+  std::vector<unsigned> counter;
 
-  for(eventst::const_iterator
+  for(eventst::iterator
       e_it=equation.SSA_steps.begin();
       e_it!=equation.SSA_steps.end();
       e_it++)
@@ -100,10 +100,19 @@ void partial_order_concurrencyt::build_event_lists(
         else // must be write
           a_rec.writes.push_back(e_it);
       }
+      else
+      {
+        // threads are numbered in the order of their spawn events
+        spawned_threads.push_back(e_it);
+      }
 
       // maps an event id to a per-thread counter
-      unsigned cnt=counter[thread_nr]++;
-      numbering[e_it]=cnt;
+      if(thread_nr>=counter.size())
+        counter.resize(thread_nr+1, 0);
+
+      e_it->event_index = events.size();
+      events.push_back(e_it);
+      thread_numbering.push_back(counter[thread_nr]++);
     }
   }
 
@@ -122,6 +131,30 @@ void partial_order_concurrencyt::build_event_lists(
   }
 }
 
+bool partial_order_concurrencyt::spawned_after(event_it e1, event_it e2) const
+{
+  const unsigned thread1 = e1->source.thread_nr;
+  const unsigned number1 = thread_number(e1);
+
+  // walk up the chain of threads that spawned the thread of e2
+  for(unsigned thread2 = e2->source.thread_nr; thread2 != 0;)
+  {
+    if(thread2 > spawned_threads.size())
+      return false;
+
+    const event_it &spawn = spawned_threads[thread2 - 1];
+    // parents are spawned before their children
+    if(spawn->source.thread_nr >= thread2)
+      return false;
+    thread2 = spawn->source.thread_nr;
+
+    if(thread2 == thread1)
+      return thread_number(spawn) > number1;
+  }
+
+  return false;
+}
+
 irep_idt partial_order_concurrencyt::rw_clock_id(
   event_it event,
   axiomt axiom)
@@ -138,7 +171,7 @@ symbol_exprt partial_order_concurrencyt::clock(
   event_it event,
   axiomt axiom)
 {
-  PRECONDITION(!numbering.empty());
+  PRECONDITION(!events.empty());
   irep_idt identifier;
 
   if(event->is_shared_write())
@@ -149,7 +182,7 @@ symbol_exprt partial_order_concurrencyt::clock(
   {
     identifier=
       "t"+std::to_string(event->source.thread_nr+1)+"$"+
-      std::to_string(numbering[event])+"$spwnclk$"+std::to_string(axiom);
+      std::to_string(thread_number(event))+"$spwnclk$"+std::to_string(axiom);
   }
   else
     UNREACHABLE;
@@ -159,9 +192,9 @@ symbol_exprt partial_order_concurrencyt::clock(
 
 void partial_order_concurrencyt::build_clock_type()
 {
-  PRECONDITION(!numbering.empty());
+  PRECONDITION(!events.empty());
 
-  std::size_t width = address_bits(numbering.size());
+  std::size_t width = address_bits(events.size());
   clock_type = unsignedbv_typet(width);
 }
 
@@ -62,7 +62,9 @@ protected:
   /// spawn) populate:
   /// 1) the _address_map_ (with a list of reads/writes for the address of each
   ///   event)
-  /// 2) the _numbering_ map (with per-thread unique number of every event)
+  /// 2) the dense _event_index_ and the per-thread _thread_numbering_ of every
+  ///   event
+  /// 3) the _spawned_threads_ (with the spawn event creating each thread)
   /// \param equation: the target equation (containing the events to be
   ///   processed)
   /// \param message_handler: message handler to output statistics
@@ -76,9 +78,40 @@ protected:
   /// \param equation: the target equation to be modified
   void add_init_writes(symex_target_equationt &);
 
-  // a per-thread numbering of the events
-  typedef std::map<event_it, unsigned> numberingt;
-  numberingt numbering;
+  /// All shared reads, writes and spawns in equation order. The position of
+  /// an event in this list is its dense index, which is stored in the event
+  /// and allows per-event data to be kept in flat vectors.
+  event_listt events;
+
+  /// Per-thread number of each event, indexed by dense event index
+  std::vector<unsigned> thread_numbering;
+
+  /// For each thread other than the main thread, the spawn event that
+  /// created it; indexed by thread number minus one
+  event_listt spawned_threads;
+
+  /// Dense index of \p event, which must be a shared read/write or spawn
+  std::size_t index(event_it event) const
+  {
+    PRECONDITION(
+      event->event_index < events.size() &&
+      events[event->event_index] == event);
+    return event->event_index;
+  }
+
+  /// Per-thread number of \p event, which orders the events of each thread
+  unsigned thread_number(event_it event) const
+  {
+    return thread_numbering[index(event)];
+  }
+
+  /// Determine whether the thread of \p e2 is (transitively) spawned by the
+  /// thread of \p e1 at a point after \p e1, in which case \p e1 must
+  /// happen before \p e2 in every execution.
+  /// \param e1: shared read/write or spawn event
+  /// \param e2: shared read/write or spawn event
+  /// \return true if \p e1 is ordered before \p e2 by thread creation
+  bool spawned_after(event_it e1, event_it e2) const;
 
   /// Produce the symbol ID for an event
   /// \param event: SSA step for the event
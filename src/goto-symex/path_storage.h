@@ -26,6 +26,8 @@ public:
 
 private:
   std::size_t nondet_count = 0;
+
+  friend class symex_checkpointt;
 };
 
 /// \brief Storage for symbolic execution paths to be resumed later
@@ -160,6 +162,8 @@ private:
   /// Storage used by \ref get_unique_index.
   name_index_mapt l1_indices;
   name_index_mapt l2_indices;
+
+  friend class symex_checkpointt;
 };
 
 /// \brief LIFO save queue: depth-first search, try to finish paths
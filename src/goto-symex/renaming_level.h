@@ -60,6 +60,8 @@ struct symex_level1t
 
 private:
   symex_renaming_levelt current_names;
+
+  friend class symex_checkpointt;
 };
 
 /// Functor to set the level 2 renaming of SSA expressions.
@@ -176,6 +176,10 @@ public:
   // for SHARED_READ/SHARED_WRITE and ATOMIC_BEGIN/ATOMIC_END
   unsigned atomic_section_id = 0;
 
+  // for SHARED_READ/SHARED_WRITE and SPAWN: position among these events,
+  // assigned by partial_order_concurrencyt
+  std::size_t event_index = 0;
+
   // for slicing
   bool ignore = false;
 
@@ -0,0 +1,1380 @@
+/*******************************************************************\
+
+Module: Checkpointing of Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Checkpointing of Symbolic Execution
+
+#include "symex_checkpoint.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <util/exception_utils.h>
+#include <util/file_util.h>
+#include <util/irep_serialization.h>
+#include <util/make_unique.h>
+#include <util/message.h>
+#include <util/mp_arith.h>
+#include <util/options.h>
+#include <util/string2int.h>
+#include <util/string_hash.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include "symex_target_equation.h"
+
+#define SYMEX_CHECKPOINT_MAGIC "CBMC-SYMEX-CHECKPOINT"
+#define SYMEX_CHECKPOINT_VERSION 2
+
+/// Options that neither change the equation nor the way it is post-processed
+static const char *const fingerprint_independent_options[] = {
+  "aig",
+  "aig-sweep",
+  "arrays-uf",
+  "beautify",
+  "boolector",
+  "bv-divider",
+  "bv-multiplier",
+  "checkpoint",
+  "checkpoint-interval",
+  "cnf-preprocessor",
+  "cprover-smt2",
+  "cvc4",
+  "dimacs",
+  "external-sat-incremental",
+  "fpa",
+  "generic",
+  "graphml-witness",
+  "localize-faults",
+  "mathsat",
+  "outfile",
+  "polarity-aware-cnf",
+  "profile-symex",
+  "program-only",
+  "refine",
+  "refine-arithmetic",
+  "refine-arrays",
+  "refine-floatbv",
+  "resume",
+  "sat-preprocessor",
+  "show-array-constraints",
+  "show-byte-ops",
+  "show-goto-symex-steps",
+  "show-points-to-sets",
+  "show-vcc",
+  "smt2",
+  "stop-on-fail",
+  "symex-coverage-report",
+  "trace",
+  "yices",
+  "z3"};
+
+std::size_t symex_checkpoint_fingerprint(
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions,
+  const optionst &options)
+{
+  std::ostringstream out;
+
+  // the textual forms do not depend on the order in which strings were
+  // interned, which the binary forms do
+  symbol_table.show(out);
+
+  std::vector<irep_idt> function_names;
+  for(const auto &function : goto_functions.function_map)
+    function_names.push_back(function.first);
+  std::sort(
+    function_names.begin(),
+    function_names.end(),
+    [](const irep_idt &a, const irep_idt &b) { return a.compare(b) < 0; });
+
+  const namespacet ns(symbol_table);
+  for(const auto &name : function_names)
+  {
+    out << name << '\n';
+    goto_functions.function_map.at(name).body.output(ns, name, out);
+  }
+
+  std::ostringstream option_lines;
+  options.output(option_lines);
+  std::istringstream in(option_lines.str());
+  for(std::string line; std::getline(in, line);)
+  {
+    const std::string name = line.substr(0, line.find(':'));
+    if(
+      std::find(
+        std::begin(fingerprint_independent_options),
+        std::end(fingerprint_independent_options),
+        name) == std::end(fingerprint_independent_options))
+    {
+      out << line << '\n';
+    }
+  }
+
+  return hash_string(out.str());
+}
+
+static const exprt &to_expr(const irept &irep)
+{
+  return static_cast<const exprt &>(irep);
+}
+
+static irept ids_to_irep(const std::vector<irep_idt> &ids)
+{
+  irept result;
+  for(const auto &id : ids)
+    result.get_sub().emplace_back(id);
+  return result;
+}
+
+static irept name_mapping_to_irep(const name_mappingt &mapping)
+{
+  irept result;
+  for(const auto &entry : mapping)
+  {
+    irept pair;
+    pair.set("from", entry.first);
+    pair.set("to", entry.second);
+    result.get_sub().push_back(std::move(pair));
+  }
+  return result;
+}
+
+static name_mappingt irep_to_name_mapping(const irept &irep)
+{
+  name_mappingt result;
+  for(const auto &pair : irep.get_sub())
+    result.emplace(pair.get("from"), pair.get("to"));
+  return result;
+}
+
+static irept renaming_to_irep(const symex_renaming_levelt &names)
+{
+  irept result;
+  names.iterate(
+    [&result](
+      const irep_idt &key, const std::pair<ssa_exprt, std::size_t> &entry) {
+      irept name;
+      name.set("key", key);
+      name.add("ssa") = entry.first;
+      name.set_size_t("index", entry.second);
+      result.get_sub().push_back(std::move(name));
+    });
+  return result;
+}
+
+static void
+irep_to_renaming(const irept &irep, symex_renaming_levelt &names)
+{
+  for(const auto &name : irep.get_sub())
+  {
+    names.insert(
+      name.get("key"),
+      std::make_pair(
+        static_cast<const ssa_exprt &>(name.find("ssa")),
+        name.get_size_t("index")));
+  }
+}
+
+/// Maps location numbers, which are unique across all goto functions, to
+/// instructions
+class instruction_lookupt
+{
+public:
+  explicit instruction_lookupt(const goto_functionst &goto_functions)
+  {
+    for(const auto &function : goto_functions.function_map)
+    {
+      forall_goto_program_instructions(it, function.second.body)
+        instructions.emplace(it->location_number, it);
+    }
+  }
+
+  goto_programt::const_targett operator()(const irept &location) const
+  {
+    auto entry =
+      instructions.find(unsafe_string2size_t(id2string(location.id())));
+    if(entry == instructions.end())
+    {
+      throw deserialization_exceptiont(
+        "symex checkpoint does not match the goto program: no instruction " +
+        id2string(location.id()));
+    }
+    return entry->second;
+  }
+
+private:
+  std::unordered_map<std::size_t, goto_programt::const_targett> instructions;
+};
+
+static irept location_to_irep(goto_programt::const_targett target)
+{
+  return irept(std::to_string(target->location_number));
+}
+
+static irept source_to_irep(const symex_targett::sourcet &source)
+{
+  irept result("source");
+  result.set_size_t("thread_nr", source.thread_nr);
+  result.set("function", source.function_id);
+  result.add("location") = location_to_irep(source.pc);
+  return result;
+}
+
+static symex_targett::sourcet
+irep_to_source(const irept &irep, const instruction_lookupt &lookup)
+{
+  symex_targett::sourcet source(
+    irep.get("function"), lookup(irep.find("location")));
+  source.thread_nr = static_cast<unsigned>(irep.get_size_t("thread_nr"));
+  return source;
+}
+
+static irept list_to_irep(const std::list<exprt> &list)
+{
+  irept result;
+  for(const auto &expr : list)
+    result.get_sub().push_back(expr);
+  return result;
+}
+
+static irept ssa_step_to_irep(const SSA_stept &step)
+{
+  irept result("ssa_step");
+
+  result.set("step_type", static_cast<long long>(step.type));
+  result.add("source") = source_to_irep(step.source);
+
+  result.add("guard") = step.guard;
+  result.add("ssa_lhs") = step.ssa_lhs;
+  result.add("ssa_full_lhs") = step.ssa_full_lhs;
+  result.add("original_full_lhs") = step.original_full_lhs;
+  result.add("ssa_rhs") = step.ssa_rhs;
+  result.set("assignment_type", static_cast<long long>(step.assignment_type));
+  result.add("cond_expr") = step.cond_expr;
+  result.set("comment", step.comment);
+
+  result.set("format_string", step.format_string);
+  result.set("io_id", step.io_id);
+  result.set("formatted", static_cast<long long>(step.formatted));
+  result.add("io_args") = list_to_irep(step.io_args);
+
+  result.set("called_function", step.called_function);
+  irept &arguments = result.add("arguments");
+  for(const auto &argument : step.ssa_function_arguments)
+    arguments.get_sub().push_back(argument);
+
+  result.set(
+    "atomic_section_id", static_cast<long long>(step.atomic_section_id));
+  result.set("hidden", static_cast<long long>(step.hidden));
+  result.set("ignore", static_cast<long long>(step.ignore));
+  result.set(
+    "part_of_abstraction", static_cast<long long>(step.part_of_abstraction));
+
+  return result;
+}
+
+static SSA_stept
+irep_to_ssa_step(const irept &irep, const instruction_lookupt &lookup)
+{
+  SSA_stept step(
+    irep_to_source(irep.find("source"), lookup),
+    static_cast<goto_trace_stept::typet>(irep.get_long_long("step_type")));
+
+  step.guard = to_expr(irep.find("guard"));
+  step.ssa_lhs = static_cast<const ssa_exprt &>(irep.find("ssa_lhs"));
+  step.ssa_full_lhs = to_expr(irep.find("ssa_full_lhs"));
+  step.original_full_lhs = to_expr(irep.find("original_full_lhs"));
+  step.ssa_rhs = to_expr(irep.find("ssa_rhs"));
+  step.assignment_type = static_cast<symex_targett::assignment_typet>(
+    irep.get_long_long("assignment_type"));
+  step.cond_expr = to_expr(irep.find("cond_expr"));
+  step.comment = irep.get_string("comment");
+
+  step.format_string = irep.get("format_string");
+  step.io_id = irep.get("io_id");
+  step.formatted = irep.get_bool("formatted");
+  for(const auto &arg : irep.find("io_args").get_sub())
+    step.io_args.push_back(to_expr(arg));
+
+  step.called_function = irep.get("called_function");
+  for(const auto &argument : irep.find("arguments").get_sub())
+    step.ssa_function_arguments.push_back(to_expr(argument));
+
+  step.atomic_section_id =
+    static_cast<unsigned>(irep.get_long_long("atomic_section_id"));
+  step.hidden = irep.get_bool("hidden");
+  step.ignore = irep.get_bool("ignore");
+  step.part_of_abstraction = irep.get_bool("part_of_abstraction");
+
+  return step;
+}
+
+/// Converts the state of a goto_symext between two steps into an irept
+class symex_checkpointt::state_writert
+{
+public:
+  explicit state_writert(const goto_symext &symex) : symex(symex)
+  {
+    for(const auto &analysis : symex.path_storage.loop_analysis_map)
+    {
+      loop_analyses.emplace(analysis.second.get(), analysis.first);
+      for(const auto &loop : analysis.second->loop_map)
+      {
+        loops.emplace(
+          &loop.second, std::make_pair(analysis.first, loop.first));
+      }
+    }
+  }
+
+  irept operator()(const goto_symex_statet &state) const
+  {
+    irept result("symex_checkpoint");
+    result.add("state") = convert(state);
+    result.add("path_storage") = convert(symex.path_storage);
+    result.add("loop_stack") = convert(symex.ls_stack);
+    result.add("complexity") = convert(symex.complexity_module);
+    result.set_size_t("atomic_section_counter", symex.atomic_section_counter);
+    result.set_size_t("dynamic_counter", goto_symext::dynamic_counter);
+    result.set_size_t("path_segment_vccs", symex.path_segment_vccs);
+    result.set_size_t("io_count", symex.target.io_count);
+    result.set_size_t("argument_count", symex.target.argument_count);
+    return result;
+  }
+
+private:
+  const goto_symext &symex;
+
+  std::unordered_map<const lexical_loopst *, irep_idt> loop_analyses;
+  std::unordered_map<
+    const lexical_loopst::loopt *,
+    std::pair<irep_idt, goto_programt::const_targett>>
+    loops;
+
+  irept convert(const lexical_loopst::loopt &loop) const
+  {
+    const auto &function_and_head = loops.at(&loop);
+    irept result("loop");
+    result.set("function", function_and_head.first);
+    result.add("head") = location_to_irep(function_and_head.second);
+    return result;
+  }
+
+  static irept convert(const value_sett &value_set)
+  {
+    irept result("value_set");
+    result.set_size_t("location_number", value_set.location_number);
+    irept &entries = result.add("entries");
+    value_set.values.iterate(
+      [&entries](const irep_idt &key, const value_sett::entryt &entry) {
+        irept converted;
+        converted.set("key", key);
+        converted.set("identifier", entry.identifier);
+        converted.set("suffix", entry.suffix);
+        irept &objects = converted.add("objects");
+        for(const auto &object : entry.object_map.read())
+        {
+          irept converted_object;
+          converted_object.add("object") =
+            value_sett::object_numbering[object.first];
+          if(object.second.has_value())
+            converted_object.set("offset", integer2string(*object.second));
+          objects.get_sub().push_back(std::move(converted_object));
+        }
+        entries.get_sub().push_back(std::move(converted));
+      });
+    return result;
+  }
+
+  static irept convert(const goto_statet &goto_state)
+  {
+    irept result("goto_state");
+    result.set_size_t("depth", goto_state.depth);
+    result.add("level2") =
+      renaming_to_irep(goto_state.get_level2().current_names);
+    irept &cache = result.add("dereference_cache");
+    goto_state.dereference_cache.iterate(
+      [&cache](const exprt &key, const symbol_exprt &value) {
+        irept entry;
+        entry.add("key") = key;
+        entry.add("value") = value;
+        cache.get_sub().push_back(std::move(entry));
+      });
+    result.add("value_set") = convert(goto_state.value_set);
+    result.add("guard") = goto_state.guard.as_expr();
+    result.set("reachable", static_cast<long long>(goto_state.reachable));
+    irept &propagation = result.add("propagation");
+    goto_state.propagation.iterate(
+      [&propagation](const irep_idt &key, const exprt &value) {
+        irept entry;
+        entry.set("key", key);
+        entry.add("value") = value;
+        propagation.get_sub().push_back(std::move(entry));
+      });
+    result.set_size_t("atomic_section_id", goto_state.atomic_section_id);
+    return result;
+  }
+
+  irept convert(const framet &frame) const
+  {
+    irept result("frame");
+    result.set("function", frame.function_identifier);
+
+    irept &goto_state_map = result.add("goto_state_map");
+    for(const auto &entry : frame.goto_state_map)
+    {
+      irept converted;
+      converted.add("location") = location_to_irep(entry.first);
+      irept &states = converted.add("states");
+      for(const auto &source_and_state : entry.second)
+      {
+        irept state;
+        state.add("source") = source_to_irep(source_and_state.first);
+        state.add("goto_state") = convert(source_and_state.second);
+        states.get_sub().push_back(std::move(state));
+      }
+      goto_state_map.get_sub().push_back(std::move(converted));
+    }
+
+    result.add("calling_location") = source_to_irep(frame.calling_location);
+    result.add("parameter_names") = ids_to_irep(frame.parameter_names);
+    result.add("guard_at_function_start") =
+      frame.guard_at_function_start.as_expr();
+    result.add("end_of_function") = location_to_irep(frame.end_of_function);
+    result.add("return_value") = frame.return_value;
+    result.set("hidden", static_cast<long long>(frame.hidden_function));
+    result.set(
+      "base_of_abstract_recursion",
+      static_cast<long long>(frame.base_of_abstract_recursion));
+    result.add("old_level1") =
+      renaming_to_irep(frame.old_level1.current_names);
+    result.add("local_objects") = ids_to_irep(
+      {frame.local_objects.begin(), frame.local_objects.end()});
+
+    if(frame.loops_info)
+      result.set("loops_info", loop_analyses.at(frame.loops_info.get()));
+
+    irept &active_loops = result.add("active_loops");
+    for(const auto &active_loop : frame.active_loops)
+    {
+      irept converted;
+      converted.add("loop") = convert(active_loop.loop);
+      converted.set_size_t(
+        "children_too_complex", active_loop.children_too_complex);
+      irept &blacklisted = converted.add("blacklisted");
+      for(const auto &loop : active_loop.blacklisted_loops)
+        blacklisted.get_sub().push_back(convert(loop.get()));
+      active_loops.get_sub().push_back(std::move(converted));
+    }
+
+    irept &loop_iterations = result.add("loop_iterations");
+    for(const auto &entry : frame.loop_iterations)
+    {
+      irept converted;
+      converted.set("loop_id", entry.first);
+      converted.set_size_t("count", entry.second.count);
+      converted.set(
+        "is_recursion", static_cast<long long>(entry.second.is_recursion));
+      loop_iterations.get_sub().push_back(std::move(converted));
+    }
+
+    return result;
+  }
+
+  irept convert(const goto_symex_statet &state) const
+  {
+    irept result("state");
+    result.add("goto_state") = convert(static_cast<const goto_statet &>(state));
+    result.add("source") = source_to_irep(state.source);
+    result.add("level1") = renaming_to_irep(state.level1.current_names);
+
+    irept &l1_types = result.add("l1_types");
+    for(const auto &entry : state.l1_types)
+    {
+      irept converted;
+      converted.set("key", entry.first);
+      converted.add("type") = entry.second;
+      l1_types.get_sub().push_back(std::move(converted));
+    }
+
+    irept &threads = result.add("threads");
+    for(std::size_t i = 0; i < state.threads.size(); ++i)
+    {
+      const auto &thread = state.threads[i];
+      irept converted;
+      // the program counter of the current thread is only updated when
+      // switching threads, and that of a finished thread is not used again
+      if(i != state.source.thread_nr && !thread.call_stack.empty())
+        converted.add("pc") = location_to_irep(thread.pc);
+      converted.add("guard") = thread.guard.as_expr();
+      irept &call_stack = converted.add("call_stack");
+      for(const auto &frame : thread.call_stack)
+        call_stack.get_sub().push_back(convert(frame));
+      irept &function_frame = converted.add("function_frame");
+      for(const auto &entry : thread.function_frame)
+      {
+        irept count;
+        count.set("function", entry.first);
+        count.set_size_t("count", entry.second);
+        function_frame.get_sub().push_back(std::move(count));
+      }
+      converted.set_size_t("atomic_section_id", thread.atomic_section_id);
+      threads.get_sub().push_back(std::move(converted));
+    }
+
+    irept &read_in_atomic_section = result.add("read_in_atomic_section");
+    for(const auto &entry : state.read_in_atomic_section)
+    {
+      irept converted;
+      converted.add("ssa") = entry.first;
+      converted.set_size_t("count", entry.second.first);
+      irept &guards = converted.add("guards");
+      for(const auto &guard : entry.second.second)
+        guards.get_sub().push_back(guard.as_expr());
+      read_in_atomic_section.get_sub().push_back(std::move(converted));
+    }
+
+    irept &written_in_atomic_section = result.add("written_in_atomic_section");
+    for(const auto &entry : state.written_in_atomic_section)
+    {
+      irept converted;
+      converted.add("ssa") = entry.first;
+      irept &guards = converted.add("guards");
+      for(const auto &guard : entry.second)
+        guards.get_sub().push_back(guard.as_expr());
+      written_in_atomic_section.get_sub().push_back(std::move(converted));
+    }
+
+    // bottom to top
+    std::vector<bool> record_events;
+    for(auto events = state.record_events; !events.empty(); events.pop())
+      record_events.push_back(events.top());
+    irept &converted_record_events = result.add("record_events");
+    for(auto it = record_events.rbegin(); it != record_events.rend(); ++it)
+      converted_record_events.get_sub().emplace_back(*it ? ID_1 : ID_0);
+
+    result.set_size_t("total_vccs", state.total_vccs);
+    result.set_size_t("remaining_vccs", state.remaining_vccs);
+
+    return result;
+  }
+
+  static irept convert(const path_storaget &path_storage)
+  {
+    irept result("path_storage");
+
+    const auto convert_indices = [](const path_storaget::name_index_mapt &map) {
+      irept indices;
+      for(const auto &entry : map)
+      {
+        irept converted;
+        converted.set("key", entry.first);
+        converted.set_size_t("index", entry.second);
+        indices.get_sub().push_back(std::move(converted));
+      }
+      return indices;
+    };
+    result.add("l1_indices") = convert_indices(path_storage.l1_indices);
+    result.add("l2_indices") = convert_indices(path_storage.l2_indices);
+    result.set_size_t(
+      "nondet_count", path_storage.build_symex_nondet.nondet_count);
+
+    // the analyses of all functions entered so far, which are recomputed
+    irept &functions = result.add("functions");
+    for(const auto &entry : path_storage.safe_pointers)
+      functions.get_sub().emplace_back(entry.first);
+    irept &loop_functions = result.add("loop_functions");
+    for(const auto &entry : path_storage.loop_analysis_map)
+      loop_functions.get_sub().emplace_back(entry.first);
+
+    return result;
+  }
+
+  static void set_optional(
+    irept &dest,
+    const irep_namet &name,
+    const optionalt<dstringt> &value)
+  {
+    if(value.has_value())
+      dest.set(name, *value);
+  }
+
+  static irept convert(const loop_stackt &loop_stack)
+  {
+    irept result("loop_stack");
+
+    irept &scopes = result.add("scopes");
+    for(const auto &scope : loop_stack.scopes)
+    {
+      irept converted;
+      converted.set_size_t("id", scope.id);
+      set_optional(converted, "guard", scope.guard);
+      converted.add("assigned") =
+        ids_to_irep({scope.assigned.begin(), scope.assigned.end()});
+      converted.add("accessed") =
+        ids_to_irep({scope.accessed.begin(), scope.accessed.end()});
+      scopes.get_sub().push_back(std::move(converted));
+    }
+
+    irept &loops = result.add("loops");
+    for(const auto &loop : loop_stack.loops)
+    {
+      irept converted;
+      converted.set_size_t("id", loop->id);
+      converted.set("function", loop->func_id);
+      converted.set_size_t("nr", loop->nr);
+      if(loop->parent_loop_id.has_value())
+        converted.set_size_t("parent", *loop->parent_loop_id);
+      converted.set_size_t("depth", loop->depth);
+      converted.add("context_guard") = loop->context_guard.as_expr();
+      converted.set(
+        "fully_over_approximate",
+        static_cast<long long>(loop->should_fully_over_approximate));
+      converted.set_size_t("before_end_scope", loop->before_end_scope);
+
+      irept &iterations = converted.add("iterations");
+      for(const auto &iteration : loop->iterations)
+      {
+        irept converted_iteration;
+        converted_iteration.set_size_t("id", iteration->id);
+        converted_iteration.set_size_t("start_scope", iteration->start_scope);
+        converted_iteration.set_size_t("end_scope", iteration->end_scope);
+        set_optional(converted_iteration, "guard", iteration->guard);
+        iterations.get_sub().push_back(std::move(converted_iteration));
+      }
+
+      irept &guards = converted.add("guards");
+      for(const auto &guard : loop->guards)
+        guards.get_sub().push_back(guard.as_expr());
+
+      if(loop->last_loop_iter.has_value())
+      {
+        const last_loop_itert &last = *loop->last_loop_iter;
+        irept &converted_last = converted.add("last_iteration");
+        converted_last.set_size_t("iteration", last.iteration->id);
+        set_optional(converted_last, "guard", last.guard);
+        converted_last.add("input") = name_mapping_to_irep(last.input);
+        converted_last.add("inner_input") =
+          name_mapping_to_irep(last.inner_input);
+        converted_last.add("misc_input") =
+          name_mapping_to_irep(last.misc_input);
+        converted_last.add("inner_output") =
+          name_mapping_to_irep(last.inner_output);
+        converted_last.add("output") = name_mapping_to_irep(last.output);
+      }
+
+      loops.get_sub().push_back(std::move(converted));
+    }
+
+    irept &stack = result.add("stack");
+    for(const auto id : loop_stack.loop_stack)
+      stack.get_sub().emplace_back(std::to_string(id));
+
+    const ls_recursion_node_dbt &recursion = *loop_stack.rec_nodes;
+    irept &children = result.add("recursion_children");
+    for(const auto &child : recursion.rec_children)
+    {
+      irept converted;
+      converted.set_size_t("id", child.id);
+      converted.set("function", child.func_name);
+      converted.add("input") = name_mapping_to_irep(child.input);
+      converted.add("output") = name_mapping_to_irep(child.output);
+      converted.add("guard") = child.guard.as_expr();
+      children.get_sub().push_back(std::move(converted));
+    }
+    irept &nodes = result.add("recursion_nodes");
+    for(const auto &node : recursion.nodes)
+    {
+      irept converted;
+      converted.set("key", node.first);
+      converted.set("function", node.second.func_name);
+      converted.add("input") = name_mapping_to_irep(node.second.input);
+      converted.add("output") = name_mapping_to_irep(node.second.output);
+      nodes.get_sub().push_back(std::move(converted));
+    }
+    irept &requested = result.add("requested");
+    for(const auto &function : recursion.requested_funcs)
+      requested.get_sub().push_back(function.identifier);
+    result.set(
+      "in_abstract_processing",
+      static_cast<long long>(recursion.in_abstract_processing));
+
+    return result;
+  }
+
+  static irept convert(const complexity_limitert &complexity)
+  {
+    irept result("complexity");
+    result.set_size_t(
+      "memory_max_complexity", complexity.memory_max_complexity);
+    result.set_size_t(
+      "steps_since_memory_check", complexity.steps_since_memory_check);
+    irept &pruned = result.add("pruned");
+    for(const auto &entry : complexity.pruned)
+    {
+      irept converted;
+      converted.set("location", entry.first);
+      converted.set_size_t("branches", entry.second.branches);
+      converted.set_size_t("loops", entry.second.loops);
+      pruned.get_sub().push_back(std::move(converted));
+    }
+    return result;
+  }
+};
+
+/// Restores the state of a goto_symext from an irept written by
+/// \ref symex_checkpointt::state_writert. Throws deserialization_exceptiont if
+/// the irept does not match the goto program.
+class symex_checkpointt::state_readert
+{
+public:
+  state_readert(
+    goto_symext &symex,
+    const goto_functionst &goto_functions,
+    const instruction_lookupt &lookup)
+    : symex(symex),
+      goto_functions(goto_functions),
+      lookup(lookup),
+      guard_manager(symex.guard_manager)
+  {
+  }
+
+  void operator()(const irept &irep, goto_symex_statet &state)
+  {
+    // the analyses need to be in place before the frames refer to them
+    convert(irep.find("path_storage"), symex.path_storage);
+    convert(irep.find("state"), state);
+    convert(irep.find("loop_stack"), symex.ls_stack);
+    convert(irep.find("complexity"), symex.complexity_module);
+    symex.atomic_section_counter =
+      static_cast<unsigned>(irep.get_size_t("atomic_section_counter"));
+    goto_symext::dynamic_counter =
+      static_cast<unsigned>(irep.get_size_t("dynamic_counter"));
+    symex.path_segment_vccs = irep.get_size_t("path_segment_vccs");
+    symex.target.io_count = irep.get_size_t("io_count");
+    symex.target.argument_count = irep.get_size_t("argument_count");
+  }
+
+private:
+  goto_symext &symex;
+  const goto_functionst &goto_functions;
+  const instruction_lookupt &lookup;
+  guard_managert &guard_manager;
+  guard_expr_managert guard_expr_manager;
+
+  const goto_functionst::goto_functiont &function(const irep_idt &id) const
+  {
+    const auto entry = goto_functions.function_map.find(id);
+    if(entry == goto_functions.function_map.end())
+    {
+      throw deserialization_exceptiont(
+        "symex checkpoint does not match the goto program: no function " +
+        id2string(id));
+    }
+    return entry->second;
+  }
+
+  guardt guard(const irept &irep) const
+  {
+    return guardt(to_expr(irep), guard_manager);
+  }
+
+  lexical_loopst::loopt &loop(const irept &irep) const
+  {
+    const auto analysis =
+      symex.path_storage.get_loop_analysis(irep.get("function"));
+    const auto entry = analysis->loop_map.find(lookup(irep.find("head")));
+    if(entry == analysis->loop_map.end())
+    {
+      throw deserialization_exceptiont(
+        "symex checkpoint does not match the goto program: no loop in " +
+        irep.get_string("function"));
+    }
+    return entry->second;
+  }
+
+  static optionalt<dstringt>
+  get_optional(const irept &irep, const irep_namet &name)
+  {
+    if(irep.find(name).is_nil())
+      return {};
+    return irep.get(name);
+  }
+
+  static std::unordered_set<dstringt> id_set(const irept &irep)
+  {
+    std::unordered_set<dstringt> result;
+    for(const auto &id : irep.get_sub())
+      result.insert(id.id());
+    return result;
+  }
+
+  static void convert(const irept &irep, value_sett &value_set)
+  {
+    value_set.location_number =
+      static_cast<unsigned>(irep.get_size_t("location_number"));
+    for(const auto &converted : irep.find("entries").get_sub())
+    {
+      value_sett::entryt entry(
+        converted.get("identifier"), converted.get_string("suffix"));
+      for(const auto &object : converted.find("objects").get_sub())
+      {
+        value_sett::offsett offset;
+        if(object.find("offset").is_not_nil())
+          offset = string2integer(object.get_string("offset"));
+        entry.object_map.write()[value_sett::object_numbering.number(
+          to_expr(object.find("object")))] = offset;
+      }
+      value_set.values.insert(converted.get("key"), std::move(entry));
+    }
+  }
+
+  void convert(const irept &irep, goto_statet &goto_state) const
+  {
+    goto_state.depth = static_cast<unsigned>(irep.get_size_t("depth"));
+    irep_to_renaming(irep.find("level2"), goto_state.level2.current_names);
+    for(const auto &entry : irep.find("dereference_cache").get_sub())
+    {
+      goto_state.dereference_cache.insert(
+        to_expr(entry.find("key")),
+        static_cast<const symbol_exprt &>(entry.find("value")));
+    }
+    convert(irep.find("value_set"), goto_state.value_set);
+    goto_state.guard = guard(irep.find("guard"));
+    goto_state.reachable = irep.get_bool("reachable");
+    for(const auto &entry : irep.find("propagation").get_sub())
+    {
+      goto_state.propagation.insert(
+        entry.get("key"), to_expr(entry.find("value")));
+    }
+    goto_state.atomic_section_id =
+      static_cast<unsigned>(irep.get_size_t("atomic_section_id"));
+  }
+
+  void convert(const irept &irep, framet &frame) const
+  {
+    frame.function_identifier = irep.get("function");
+
+    for(const auto &entry : irep.find("goto_state_map").get_sub())
+    {
+      auto &states = frame.goto_state_map[lookup(entry.find("location"))];
+      for(const auto &state : entry.find("states").get_sub())
+      {
+        goto_statet goto_state(guard_manager);
+        convert(state.find("goto_state"), goto_state);
+        states.emplace_back(
+          irep_to_source(state.find("source"), lookup), std::move(goto_state));
+      }
+    }
+
+    for(const auto &name : irep.find("parameter_names").get_sub())
+      frame.parameter_names.push_back(name.id());
+    frame.end_of_function = lookup(irep.find("end_of_function"));
+    frame.return_value = to_expr(irep.find("return_value"));
+    frame.hidden_function = irep.get_bool("hidden");
+    frame.base_of_abstract_recursion =
+      irep.get_bool("base_of_abstract_recursion");
+    irep_to_renaming(
+      irep.find("old_level1"), frame.old_level1.current_names);
+    for(const auto &object : irep.find("local_objects").get_sub())
+      frame.local_objects.insert(object.id());
+
+    if(irep.find("loops_info").is_not_nil())
+    {
+      frame.loops_info =
+        symex.path_storage.get_loop_analysis(irep.get("loops_info"));
+    }
+
+    for(const auto &active_loop : irep.find("active_loops").get_sub())
+    {
+      frame.active_loops.emplace_back(loop(active_loop.find("loop")));
+      framet::active_loop_infot &info = frame.active_loops.back();
+      info.children_too_complex =
+        active_loop.get_size_t("children_too_complex");
+      for(const auto &blacklisted : active_loop.find("blacklisted").get_sub())
+        info.blacklisted_loops.emplace_back(loop(blacklisted));
+    }
+
+    for(const auto &entry : irep.find("loop_iterations").get_sub())
+    {
+      framet::loop_infot &info = frame.loop_iterations[entry.get("loop_id")];
+      info.count = static_cast<unsigned>(entry.get_size_t("count"));
+      info.is_recursion = entry.get_bool("is_recursion");
+    }
+  }
+
+  void convert(const irept &irep, goto_symex_statet &state) const
+  {
+    convert(irep.find("goto_state"), static_cast<goto_statet &>(state));
+    state.source = irep_to_source(irep.find("source"), lookup);
+    irep_to_renaming(irep.find("level1"), state.level1.current_names);
+
+    for(const auto &entry : irep.find("l1_types").get_sub())
+    {
+      state.l1_types.emplace(
+        entry.get("key"), static_cast<const typet &>(entry.find("type")));
+    }
+
+    state.threads.clear();
+    for(const auto &converted : irep.find("threads").get_sub())
+    {
+      state.threads.emplace_back(guard_manager);
+      goto_symex_statet::threadt &thread = state.threads.back();
+      if(converted.find("pc").is_not_nil())
+        thread.pc = lookup(converted.find("pc"));
+      thread.guard = guard(converted.find("guard"));
+      for(const auto &frame : converted.find("call_stack").get_sub())
+      {
+        convert(
+          frame,
+          thread.call_stack.new_frame(
+            irep_to_source(frame.find("calling_location"), lookup),
+            guard(frame.find("guard_at_function_start"))));
+      }
+      for(const auto &entry : converted.find("function_frame").get_sub())
+      {
+        thread.function_frame[entry.get("function")] =
+          static_cast<unsigned>(entry.get_size_t("count"));
+      }
+      thread.atomic_section_id =
+        static_cast<unsigned>(converted.get_size_t("atomic_section_id"));
+    }
+    if(state.source.thread_nr >= state.threads.size())
+    {
+      throw deserialization_exceptiont(
+        "symex checkpoint has no current thread");
+    }
+
+    for(const auto &entry : irep.find("read_in_atomic_section").get_sub())
+    {
+      auto &read = state.read_in_atomic_section[static_cast<const ssa_exprt &>(
+        entry.find("ssa"))];
+      read.first = static_cast<unsigned>(entry.get_size_t("count"));
+      for(const auto &converted_guard : entry.find("guards").get_sub())
+        read.second.push_back(guard(converted_guard));
+    }
+
+    for(const auto &entry : irep.find("written_in_atomic_section").get_sub())
+    {
+      auto &written =
+        state.written_in_atomic_section[static_cast<const ssa_exprt &>(
+          entry.find("ssa"))];
+      for(const auto &converted_guard : entry.find("guards").get_sub())
+        written.push_back(guard(converted_guard));
+    }
+
+    state.record_events = std::stack<bool>();
+    for(const auto &record : irep.find("record_events").get_sub())
+      state.record_events.push(record.id() == ID_1);
+
+    // symex_with_state resets these before every step but the first
+    state.has_saved_jump_target = false;
+    state.has_saved_next_instruction = false;
+
+    state.total_vccs = static_cast<unsigned>(irep.get_size_t("total_vccs"));
+    state.remaining_vccs =
+      static_cast<unsigned>(irep.get_size_t("remaining_vccs"));
+  }
+
+  void convert(const irept &irep, path_storaget &path_storage) const
+  {
+    const auto convert_indices = [](
+                                   const irept &indices,
+                                   path_storaget::name_index_mapt &map) {
+      for(const auto &entry : indices.get_sub())
+        map[entry.get("key")] = entry.get_size_t("index");
+    };
+    convert_indices(irep.find("l1_indices"), path_storage.l1_indices);
+    convert_indices(irep.find("l2_indices"), path_storage.l2_indices);
+    path_storage.build_symex_nondet.nondet_count =
+      irep.get_size_t("nondet_count");
+
+    for(const auto &converted : irep.find("functions").get_sub())
+    {
+      const irep_idt &id = converted.id();
+      const auto &goto_function = function(id);
+      path_storage.dirty.populate_dirty_for_function(id, goto_function);
+      auto emplace_result =
+        path_storage.safe_pointers.emplace(id, local_safe_pointerst{});
+      if(emplace_result.second)
+        emplace_result.first->second(goto_function.body);
+    }
+
+    for(const auto &converted : irep.find("loop_functions").get_sub())
+    {
+      path_storage.add_function_loops(
+        converted.id(), function(converted.id()).body);
+    }
+  }
+
+  void convert(const irept &irep, loop_stackt &loop_stack)
+  {
+    loop_stack.scopes.clear();
+    for(const auto &converted : irep.find("scopes").get_sub())
+    {
+      loop_stack.scopes.emplace_back(converted.get_size_t("id"));
+      scopet &scope = loop_stack.scopes.back();
+      scope.guard = get_optional(converted, "guard");
+      scope.assigned = id_set(converted.find("assigned"));
+      scope.accessed = id_set(converted.find("accessed"));
+    }
+
+    loop_stack.loops.clear();
+    for(const auto &converted : irep.find("loops").get_sub())
+    {
+      optionalt<size_t> parent;
+      if(converted.find("parent").is_not_nil())
+        parent = converted.get_size_t("parent");
+      loop_stack.loops.emplace_back(util_make_unique<loopt>(
+        converted.get_size_t("id"),
+        converted.get("function"),
+        converted.get_size_t("nr"),
+        parent,
+        &loop_stack,
+        converted.get_size_t("depth"),
+        guard_exprt(
+          to_expr(converted.find("context_guard")), guard_expr_manager),
+        converted.get_size_t("before_end_scope"),
+        converted.get_bool("fully_over_approximate")));
+      loopt &loop = *loop_stack.loops.back();
+
+      for(const auto &iteration : converted.find("iterations").get_sub())
+      {
+        loop.iterations.emplace_back(util_make_unique<loop_iterationt>(
+          iteration.get_size_t("id"),
+          &loop,
+          iteration.get_size_t("start_scope"),
+          iteration.get_size_t("end_scope")));
+        loop.iterations.back()->guard = get_optional(iteration, "guard");
+      }
+
+      for(const auto &guard : converted.find("guards").get_sub())
+        loop.guards.emplace_back(to_expr(guard), guard_expr_manager);
+
+      const irept &last = converted.find("last_iteration");
+      if(last.is_not_nil())
+      {
+        const std::size_t iteration = last.get_size_t("iteration");
+        if(iteration >= loop.iterations.size())
+        {
+          throw deserialization_exceptiont(
+            "symex checkpoint has no iteration " + std::to_string(iteration) +
+            " of loop " + std::to_string(loop.id));
+        }
+        loop.last_loop_iter.emplace(
+          loop.iterations[iteration].get(),
+          irep_to_name_mapping(last.find("input")),
+          irep_to_name_mapping(last.find("inner_input")),
+          irep_to_name_mapping(last.find("misc_input")));
+        loop.last_loop_iter->set_guard(get_optional(last, "guard"));
+        loop.last_loop_iter->set_output(
+          irep_to_name_mapping(last.find("inner_output")),
+          irep_to_name_mapping(last.find("output")));
+      }
+    }
+
+    loop_stack.loop_stack.clear();
+    for(const auto &id : irep.find("stack").get_sub())
+      loop_stack.loop_stack.push_back(unsafe_string2size_t(id2string(id.id())));
+
+    const ls_infot &info = loop_stack.get_info();
+    ls_recursion_node_dbt &recursion = loop_stack.abstract_recursion();
+    recursion.rec_children.clear();
+    for(const auto &converted : irep.find("recursion_children").get_sub())
+    {
+      recursion.rec_children.push_back(ls_recursion_childt(
+        converted.get_size_t("id"),
+        info.get_func_info(converted.get("function")),
+        irep_to_name_mapping(converted.find("input")),
+        irep_to_name_mapping(converted.find("output")),
+        guard_exprt(to_expr(converted.find("guard")), guard_expr_manager)));
+    }
+    recursion.nodes.clear();
+    for(const auto &converted : irep.find("recursion_nodes").get_sub())
+    {
+      recursion.nodes.emplace(
+        converted.get("key"),
+        ls_recursion_nodet(
+          info.get_func_info(converted.get("function")),
+          irep_to_name_mapping(converted.find("input")),
+          irep_to_name_mapping(converted.find("output"))));
+    }
+    recursion.requested_funcs.clear();
+    for(const auto &function : irep.find("requested").get_sub())
+    {
+      recursion.requested_funcs.insert(
+        requested_functiont{static_cast<const symbol_exprt &>(function)});
+    }
+    recursion.in_abstract_processing = irep.get_bool("in_abstract_processing");
+  }
+
+  static void convert(const irept &irep, complexity_limitert &complexity)
+  {
+    complexity.memory_max_complexity = irep.get_size_t("memory_max_complexity");
+    complexity.steps_since_memory_check =
+      irep.get_size_t("steps_since_memory_check");
+    for(const auto &converted : irep.find("pruned").get_sub())
+    {
+      auto &pruned = complexity.pruned[converted.get_string("location")];
+      pruned.branches = converted.get_size_t("branches");
+      pruned.loops = converted.get_size_t("loops");
+    }
+  }
+};
+
+static std::string equation_file(const std::string &directory)
+{
+  return concat_dir_file(directory, "equation.bin");
+}
+
+static std::string state_file(const std::string &directory)
+{
+  return concat_dir_file(directory, "state.bin");
+}
+
+symex_checkpointt::symex_checkpointt(
+  std::string directory,
+  std::size_t fingerprint,
+  message_handlert &message_handler)
+  : directory(std::move(directory)),
+    fingerprint(fingerprint),
+    log(message_handler)
+{
+}
+
+symex_checkpointt::contentt symex_checkpointt::content() const
+{
+  if(file_exists(equation_file(directory)))
+    return contentt::EQUATION;
+  else if(file_exists(state_file(directory)))
+    return contentt::STATE;
+  else
+    return contentt::NONE;
+}
+
+bool symex_checkpointt::write_file(
+  const std::string &file_name,
+  const symbol_tablet &symbol_table,
+  const symex_target_equationt &equation,
+  const goto_symex_statet *state,
+  const goto_symext *symex) const
+{
+  if(!is_directory(directory) && !create_directory(directory))
+  {
+    log.error() << "failed to create checkpoint directory '" << directory
+                << "'" << messaget::eom;
+    return true;
+  }
+
+  const std::string tmp_file_name = file_name + ".tmp";
+  {
+    std::ofstream out(tmp_file_name, std::ios::binary);
+    if(!out)
+    {
+      log.error() << "failed to write '" << tmp_file_name << "'"
+                  << messaget::eom;
+      return true;
+    }
+
+    write_gb_string(out, SYMEX_CHECKPOINT_MAGIC);
+    write_gb_word(out, SYMEX_CHECKPOINT_VERSION);
+    write_gb_word(out, fingerprint);
+
+    if(write_goto_binary(out, symbol_table, goto_functionst{}))
+    {
+      log.error() << "failed to write '" << tmp_file_name << "'"
+                  << messaget::eom;
+      return true;
+    }
+
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc);
+
+    write_gb_word(out, equation.SSA_steps.size());
+    for(const auto &step : equation.SSA_steps)
+      irepconverter.reference_convert(ssa_step_to_irep(step), out);
+
+    if(state != nullptr)
+      irepconverter.reference_convert(state_writert(*symex)(*state), out);
+
+    if(!out)
+    {
+      log.error() << "failed to write '" << tmp_file_name << "'"
+                  << messaget::eom;
+      return true;
+    }
+  }
+
+  file_rename(tmp_file_name, file_name);
+
+  return false;
+}
+
+bool symex_checkpointt::read_file(
+  const std::string &file_name,
+  const goto_functionst &goto_functions,
+  symbol_tablet &symbol_table,
+  symex_target_equationt &equation,
+  goto_symex_statet *state,
+  goto_symext *symex) const
+{
+  std::ifstream in(file_name, std::ios::binary);
+  if(!in)
+  {
+    log.error() << "no symex checkpoint found in '" << directory << "'"
+                << messaget::eom;
+    return true;
+  }
+
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+
+  if(
+    irepconverter.read_gb_string(in) != SYMEX_CHECKPOINT_MAGIC ||
+    irep_serializationt::read_gb_word(in) != SYMEX_CHECKPOINT_VERSION)
+  {
+    log.error() << "'" << file_name
+                << "' is not a symex checkpoint of a supported version"
+                << messaget::eom;
+    return true;
+  }
+
+  if(irep_serializationt::read_gb_word(in) != fingerprint)
+  {
+    log.error() << "the symex checkpoint in '" << directory
+                << "' was created from a different goto program or with "
+                << "different options" << messaget::eom;
+    return true;
+  }
+
+  goto_functionst no_functions;
+  if(read_bin_goto_object(
+       in, file_name, symbol_table, no_functions, log.get_message_handler()))
+  {
+    log.error() << "failed to read the symbols in '" << file_name << "'"
+                << messaget::eom;
+    return true;
+  }
+
+  try
+  {
+    const instruction_lookupt lookup(goto_functions);
+
+    const std::size_t number_of_steps = irep_serializationt::read_gb_word(in);
+    for(std::size_t i = 0; i < number_of_steps; ++i)
+    {
+      const irept &irep = irepconverter.reference_convert(in);
+      if(!in)
+        throw deserialization_exceptiont("'" + file_name + "' is truncated");
+      equation.SSA_steps.push_back(irep_to_ssa_step(irep, lookup));
+    }
+
+    if(state != nullptr)
+    {
+      const irept &irep = irepconverter.reference_convert(in);
+      if(!in)
+        throw deserialization_exceptiont("'" + file_name + "' is truncated");
+      state_readert(*symex, goto_functions, lookup)(irep, *state);
+    }
+  }
+  catch(const deserialization_exceptiont &e)
+  {
+    log.error() << e.what() << messaget::eom;
+    return true;
+  }
+
+  return false;
+}
+
+bool symex_checkpointt::write_equation(
+  const symex_target_equationt &equation,
+  const symbol_tablet &symex_symbol_table) const
+{
+  if(write_file(
+       equation_file(directory),
+       symex_symbol_table,
+       equation,
+       nullptr,
+       nullptr))
+  {
+    return true;
+  }
+
+  log.status() << "Wrote symex checkpoint with " << equation.SSA_steps.size()
+               << " steps to " << directory << messaget::eom;
+
+  return false;
+}
+
+bool symex_checkpointt::read_equation(
+  const goto_functionst &goto_functions,
+  symex_target_equationt &equation,
+  symbol_tablet &symex_symbol_table) const
+{
+  if(read_file(
+       equation_file(directory),
+       goto_functions,
+       symex_symbol_table,
+       equation,
+       nullptr,
+       nullptr))
+  {
+    return true;
+  }
+
+  log.status() << "Resumed from symex checkpoint with "
+               << equation.SSA_steps.size() << " steps" << messaget::eom;
+
+  return false;
+}
+
+bool symex_checkpointt::write_state(
+  const goto_symext &symex,
+  const goto_symex_statet &state) const
+{
+  if(write_file(
+       state_file(directory),
+       state.symbol_table,
+       symex.target,
+       &state,
+       &symex))
+  {
+    return true;
+  }
+
+  log.status() << "Wrote symex state with " << symex.target.SSA_steps.size()
+               << " steps to " << directory << messaget::eom;
+
+  return false;
+}
+
+bool symex_checkpointt::read_state(
+  goto_symext &symex,
+  const goto_functionst &goto_functions,
+  goto_symex_statet &state) const
+{
+  if(read_file(
+       state_file(directory),
+       goto_functions,
+       state.symbol_table,
+       symex.target,
+       &state,
+       &symex))
+  {
+    return true;
+  }
+
+  log.status() << "Resuming symex from a state with "
+               << symex.target.SSA_steps.size() << " steps" << messaget::eom;
+
+  return false;
+}
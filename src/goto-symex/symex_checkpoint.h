@@ -0,0 +1,134 @@
+/*******************************************************************\
+
+Module: Checkpointing of Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Checkpointing of Symbolic Execution
+///
+/// A checkpoint directory holds up to two files:
+///  - `state.bin`, written periodically while symbolic execution is running:
+///    the symex state (all threads, call stacks and pending merges), the
+///    equation built up so far, the symbols added by symex, the counters of
+///    the path storage and the loop stack;
+///  - `equation.bin`, written once symbolic execution has finished: the
+///    post-processed equation and the symbols added by symex.
+///
+/// Both start with a fingerprint of the goto program and of the options that
+/// affect symbolic execution, see \ref symex_checkpoint_fingerprint, and a
+/// checkpoint is only accepted by a run with the same fingerprint. Resuming
+/// prefers `equation.bin` when it exists.
+
+#ifndef CPROVER_GOTO_SYMEX_SYMEX_CHECKPOINT_H
+#define CPROVER_GOTO_SYMEX_SYMEX_CHECKPOINT_H
+
+#include <string>
+
+#include "goto_symex.h"
+
+class message_handlert;
+class optionst;
+class symbol_tablet;
+class symex_target_equationt;
+
+/// Compute a fingerprint of the goto program given by \p symbol_table and
+/// \p goto_functions and of those \p options that may change the equation.
+/// Options that only control checkpointing, the output or the choice of the
+/// decision procedure are not part of the fingerprint.
+std::size_t symex_checkpoint_fingerprint(
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions,
+  const optionst &options);
+
+/// Reads and writes the checkpoint files in a directory, see the file
+/// documentation of symex_checkpoint.h. Files are written to temporary names
+/// first and then renamed, so that an interrupted write never replaces a
+/// complete checkpoint with a partial one.
+class symex_checkpointt
+{
+public:
+  /// \param directory: checkpoint directory
+  /// \param fingerprint: fingerprint of the current run, see
+  ///   \ref symex_checkpoint_fingerprint
+  /// \param message_handler: for status and error messages
+  symex_checkpointt(
+    std::string directory,
+    std::size_t fingerprint,
+    message_handlert &message_handler);
+
+  enum class contentt
+  {
+    NONE,
+    STATE,
+    EQUATION
+  };
+
+  /// \return which checkpoint a resumed run would continue from
+  contentt content() const;
+
+  /// Write the finished \p equation and \p symex_symbol_table
+  /// \return true on error
+  bool write_equation(
+    const symex_target_equationt &equation,
+    const symbol_tablet &symex_symbol_table) const;
+
+  /// Read the equation written by \ref write_equation. The program counters
+  /// of the SSA steps are resolved against \p goto_functions by their
+  /// location numbers.
+  /// \param goto_functions: the goto functions of the program
+  /// \param [out] equation: the SSA steps of the checkpoint are appended here
+  /// \param [out] symex_symbol_table: receives the symbols added by symex
+  /// \return true on error
+  bool read_equation(
+    const goto_functionst &goto_functions,
+    symex_target_equationt &equation,
+    symbol_tablet &symex_symbol_table) const;
+
+  /// Write the state of \p symex, which is symbolically executing \p state,
+  /// between two symex steps.
+  /// \return true on error
+  bool write_state(const goto_symext &symex, const goto_symex_statet &state)
+    const;
+
+  /// Restore \p symex and \p state from the snapshot written by
+  /// \ref write_state. \p symex must have been set up like the one the
+  /// snapshot was taken from and not have executed anything yet.
+  /// \return true on error
+  bool read_state(
+    goto_symext &symex,
+    const goto_functionst &goto_functions,
+    goto_symex_statet &state) const;
+
+  const std::string &get_directory() const
+  {
+    return directory;
+  }
+
+private:
+  const std::string directory;
+  const std::size_t fingerprint;
+  mutable messaget log;
+
+  class state_writert;
+  class state_readert;
+
+  bool write_file(
+    const std::string &file_name,
+    const symbol_tablet &symbol_table,
+    const symex_target_equationt &equation,
+    const goto_symex_statet *state,
+    const goto_symext *symex) const;
+
+  bool read_file(
+    const std::string &file_name,
+    const goto_functionst &goto_functions,
+    symbol_tablet &symbol_table,
+    symex_target_equationt &equation,
+    goto_symex_statet *state,
+    goto_symext *symex) const;
+};
+
+#endif // CPROVER_GOTO_SYMEX_SYMEX_CHECKPOINT_H
@@ -293,7 +293,7 @@ void goto_symext::symex_function_call_code(
     parameter_assignments(identifier, goto_function, state, call.arguments());
     ls_stack.abstract_recursion().create_rec_child(
       requested_functiont{to_symbol_expr(call.function())},
-      state.guard,
+      state.guard.as_guard_expr(),
       resolve,
       assign_unknown);
     target.function_return(
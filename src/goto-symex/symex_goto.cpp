@@ -258,7 +258,10 @@ void goto_symext::symex_goto(statet &state)
 
   //std::cout << "guard " << state.guard.as_expr().to_string2() << " new guard " << new_guard.to_string2() << "\n";
 
-  ls_stack.set_iter_guard(state.guard);
+  // the loop stack needs the guard variables that lead to each iteration,
+  // which BDD guards do not provide
+  if(!state.guard.is_bdd())
+    ls_stack.set_iter_guard(state.guard.as_guard_expr());
 
   DATA_INVARIANT(
     !instruction.targets.empty(), "goto should have at least one target");
@@ -287,7 +290,7 @@ void goto_symext::symex_goto(statet &state)
         state.call_stack().top().function_identifier,
         state.call_stack().top().calling_location.function_id,
         instruction.loop_number,
-        state.guard);
+        state.guard.as_guard_expr());
     }
 
     bool in_last_loop_iteration =
@@ -29,6 +29,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/symbol_table.h>
 
 #include "path_storage.h"
+#include "symex_checkpoint.h"
 #include <chrono>
 #include <util/format.h>
 #include <util/format_expr.h>
@@ -61,7 +62,8 @@ symex_configt::symex_configt(const optionst &options)
                 "max-field-sensitivity-array-size")
             : DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE),
     complexity_limits_active(
-      options.get_signed_int_option("symex-complexity-limit") > 0),
+      options.get_signed_int_option("symex-complexity-limit") > 0 ||
+      options.get_unsigned_int_option("symex-memory-limit") > 0),
     cache_dereferences{options.get_bool_option("symex-cache-dereferences")}
 {
 }
@@ -388,6 +390,9 @@ void goto_symext::symex_with_state(
     symex_threaded_step(state, get_goto_functions);
     if(should_pause_symex)
       return;
+    // the nested runs that process abstract recursions are not resumable
+    if(finish_loopstack)
+      save_checkpoint_if_due(state);
   }
 
   if(finish_loopstack)
@@ -516,6 +521,56 @@ void goto_symext::resume_symex_from_saved_state(
   symex_with_state(state, get_goto_function, new_symbol_table, true);
 }
 
+void goto_symext::symex_from_checkpoint(
+  const symex_checkpointt &checkpoint,
+  const goto_functionst &functions,
+  const get_goto_functiont &get_goto_function,
+  symbol_tablet &new_symbol_table)
+{
+  const irep_idt entry_point_id = goto_functionst::entry_point();
+  const goto_programt &entry_point_body =
+    get_goto_function(entry_point_id).body;
+  auto *storage = &path_storage;
+
+  // the placeholder source and call stack are replaced by the snapshot
+  statet state(
+    symex_targett::sourcet(entry_point_id, entry_point_body),
+    symex_config.max_field_sensitivity_array_size,
+    guard_manager,
+    [storage](const irep_idt &id) { return storage->get_unique_l2_index(id); });
+
+  if(checkpoint.read_state(*this, functions, state))
+  {
+    throw deserialization_exceptiont(
+      "failed to resume from symex checkpoint '" + checkpoint.get_directory() +
+      "'");
+  }
+
+  state.symex_target = &target;
+  state.dirty = &path_storage.dirty;
+  state.run_validation_checks = symex_config.run_validation_checks;
+
+  symex_with_state(state, get_goto_function, new_symbol_table, true);
+
+  complexity_module.output_report();
+  guard_manager.output_statistics(log);
+}
+
+void goto_symext::save_checkpoint_if_due(const statet &state)
+{
+  if(
+    checkpoint == nullptr || state.call_stack().empty() ||
+    std::chrono::steady_clock::now() < next_checkpoint)
+  {
+    return;
+  }
+
+  // a failed snapshot is reported, but symex carries on regardless
+  (void)checkpoint->write_state(*this, state);
+
+  next_checkpoint = std::chrono::steady_clock::now() + checkpoint_interval;
+}
+
 std::unique_ptr<goto_symext::statet> goto_symext::initialize_entry_point_state(
   const get_goto_functiont &get_goto_function,
   dstringt entry_point_id)
@@ -592,6 +647,9 @@ void goto_symext::symex_from_entry_point_of(
 
   symex_with_state(*state, get_goto_function, new_symbol_table, true);
 
+  complexity_module.output_report();
+  guard_manager.output_statistics(log);
+
   const auto symex_stop = std::chrono::steady_clock::now();
   std::chrono::duration<double> symex_runtime =
     std::chrono::duration<double>(symex_stop - symex_start);
@@ -312,6 +312,8 @@ protected:
 
   // for unique function call argument identifiers
   std::size_t argument_count = 0;
+
+  friend class symex_checkpointt;
 };
 
 inline bool operator<(
@@ -124,7 +124,7 @@ public:
 
   static bddt bdd_ite(const bddt &i, const bddt &t, const bddt &e)
   {
-    return i.bdd_and(t).bdd_or(i.bdd_not().bdd_and(e));
+    return bddt(i.node->mgr->ite(i, t, e));
   }
 
   bddt constrain(const bddt &other)
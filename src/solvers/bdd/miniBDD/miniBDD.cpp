@@ -15,28 +15,19 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/invariant.h>
 
+#include <algorithm>
 #include <iostream>
+#include <stack>
 
-void mini_bdd_nodet::remove_reference()
-{
-  PRECONDITION_WITH_DIAGNOSTICS(
-    reference_counter != 0, "all references were already removed");
-
-  reference_counter--;
-
-  if(reference_counter == 0 && node_number >= 2)
-  {
-    mini_bdd_mgrt::reverse_keyt reverse_key(var, low, high);
-    mgr->reverse_map.erase(reverse_key);
-    low.clear();
-    high.clear();
-    mgr->free.push(this);
-  }
-}
+const unsigned mini_bdd_mgrt::EMPTY_SLOT;
+const unsigned mini_bdd_mgrt::DELETED_SLOT;
 
 mini_bddt mini_bdd_mgrt::Var(const std::string &label)
 {
   var_table.push_back(var_table_entryt(label));
+  // new variables are added below the others
+  var_to_level.push_back(var_table.size());
+  level_to_var.push_back(var_table.size());
   true_bdd.node->var = var_table.size() + 1;
   false_bdd.node->var = var_table.size() + 1;
   return mk(var_table.size(), false_bdd, true_bdd);
@@ -56,15 +47,17 @@ void mini_bdd_mgrt::DumpDot(std::ostream &out, bool suppress_zero) const
   out << "  { node [shape=box,fontsize=24]; \"1\"; }\n"
       << "}\n\n";
 
-  for(unsigned v = 0; v < var_table.size(); v++)
+  for(unsigned l = 1; l <= var_table.size(); l++)
   {
+    const unsigned v = level_to_var[l];
+
     out << "{ rank=same; "
            "{ node [shape=plaintext,fontname=\"Times Italic\",fontsize=24] \" "
-        << var_table[v].label << " \" }; ";
+        << var_table[v - 1].label << " \" }; ";
 
     for(const auto &u : nodes)
     {
-      if(u.var == (v + 1) && u.reference_counter != 0)
+      if(u.var == v && u.reference_counter != 0)
         out << '"' << u.node_number << "\"; ";
     }
 
@@ -75,8 +68,8 @@ void mini_bdd_mgrt::DumpDot(std::ostream &out, bool suppress_zero) const
 
   out << "{ edge [style = invis];";
 
-  for(unsigned v = 0; v < var_table.size(); v++)
-    out << " \" " << var_table[v].label << " \" ->";
+  for(unsigned l = 1; l <= var_table.size(); l++)
+    out << " \" " << var_table[level_to_var[l] - 1].label << " \" ->";
 
   out << " \"T\"; }\n";
 
@@ -114,26 +107,27 @@ void mini_bdd_mgrt::DumpTikZ(
   out << "  \\tikzstyle{BDDnode}=[circle,draw=black,"
          "inner sep=0pt,minimum size=5mm]\n";
 
-  for(unsigned v = 0; v < var_table.size(); v++)
+  for(unsigned l = 1; l <= var_table.size(); l++)
   {
+    const std::string &label = var_table[level_to_var[l] - 1].label;
+
     out << "  \\node[";
 
-    if(v != 0)
-      out << "below of=v" << var_table[v - 1].label;
+    if(l != 1)
+      out << "below of=v" << var_table[level_to_var[l - 1] - 1].label;
 
-    out << "] (v" << var_table[v].label << ") {$\\mathit{" << var_table[v].label
-        << "}$};\n";
+    out << "] (v" << label << ") {$\\mathit{" << label << "}$};\n";
 
     unsigned previous = 0;
 
     for(const auto &u : nodes)
     {
-      if(u.var == (v + 1) && u.reference_counter != 0)
+      if(u.var == level_to_var[l] && u.reference_counter != 0)
       {
         out << "  \\node[xshift=0cm, BDDnode, ";
 
         if(previous == 0)
-          out << "right of=v" << var_table[v].label;
+          out << "right of=v" << label;
         else
           out << "right of=n" << previous;
 
@@ -152,7 +146,8 @@ void mini_bdd_mgrt::DumpTikZ(
 
   out << "  % terminals\n";
   out << "  \\node[draw=black, style=rectangle, below of=v"
-      << var_table.back().label << ", xshift=1cm] (n1) {$1$};\n";
+      << var_table[level_to_var.back() - 1].label
+      << ", xshift=1cm] (n1) {$1$};\n";
 
   if(!suppress_zero)
     out << "  \\node[draw=black, style=rectangle, left of=n1] (n0) {$0$};\n";
@@ -184,7 +179,10 @@ void mini_bdd_mgrt::DumpTikZ(
 class mini_bdd_applyt
 {
 public:
-  inline explicit mini_bdd_applyt(bool (*_fkt)(bool, bool)) : fkt(_fkt)
+  inline mini_bdd_applyt(
+    bool (*_fkt)(bool, bool),
+    mini_bdd_mgrt::operationt _op)
+    : fkt(_fkt), op(_op)
   {
   }
 
@@ -195,11 +193,31 @@ public:
 
 protected:
   bool (*fkt)(bool, bool);
+  // the operation in the computed cache; all of them are commutative
+  mini_bdd_mgrt::operationt op;
   mini_bddt APP_rec(const mini_bddt &x, const mini_bddt &y);
   mini_bddt APP_non_rec(const mini_bddt &x, const mini_bddt &y);
 
-  typedef std::map<std::pair<unsigned, unsigned>, mini_bddt> Gt;
-  Gt G;
+  bool cache_lookup(const mini_bddt &x, const mini_bddt &y, mini_bddt &result)
+  {
+    return x.node->mgr->cache_lookup(
+      op,
+      std::min(x.node_number(), y.node_number()),
+      std::max(x.node_number(), y.node_number()),
+      0,
+      result);
+  }
+
+  void
+  cache_insert(const mini_bddt &x, const mini_bddt &y, const mini_bddt &result)
+  {
+    x.node->mgr->cache_insert(
+      op,
+      std::min(x.node_number(), y.node_number()),
+      std::max(x.node_number(), y.node_number()),
+      0,
+      result);
+  }
 };
 
 mini_bddt mini_bdd_applyt::APP_rec(const mini_bddt &x, const mini_bddt &y)
@@ -212,26 +230,25 @@ mini_bddt mini_bdd_applyt::APP_rec(const mini_bddt &x, const mini_bddt &y)
     "apply can only be called on BDDs with the same manager");
 
   // dynamic programming
-  std::pair<unsigned, unsigned> key(x.node_number(), y.node_number());
-  Gt::const_iterator G_it = G.find(key);
-  if(G_it != G.end())
-    return G_it->second;
+  mini_bddt u;
+  if(cache_lookup(x, y, u))
+    return u;
 
   mini_bdd_mgrt *mgr = x.node->mgr;
-
-  mini_bddt u;
+  const unsigned x_level = mgr->level(x.var());
+  const unsigned y_level = mgr->level(y.var());
 
   if(x.is_constant() && y.is_constant())
     u = mini_bddt(fkt(x.is_true(), y.is_true()) ? mgr->True() : mgr->False());
-  else if(x.var() == y.var())
+  else if(x_level == y_level)
     u =
       mgr->mk(x.var(), APP_rec(x.low(), y.low()), APP_rec(x.high(), y.high()));
-  else if(x.var() < y.var())
+  else if(x_level < y_level)
     u = mgr->mk(x.var(), APP_rec(x.low(), y), APP_rec(x.high(), y));
-  else /* x.var() > y.var() */
+  else /* x_level > y_level */
     u = mgr->mk(y.var(), APP_rec(x, y.low()), APP_rec(x, y.high()));
 
-  G[key] = u;
+  cache_insert(x, y, u);
 
   return u;
 }
@@ -241,16 +258,10 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
   struct stack_elementt
   {
     stack_elementt(mini_bddt &_result, const mini_bddt &_x, const mini_bddt &_y)
-      : result(_result),
-        x(_x),
-        y(_y),
-        key(x.node_number(), y.node_number()),
-        var(0),
-        phase(phaset::INIT)
+      : result(_result), x(_x), y(_y), var(0), phase(phaset::INIT)
     {
     }
     mini_bddt &result, x, y, lr, hr;
-    std::pair<unsigned, unsigned> key;
     unsigned var;
     enum class phaset
     {
@@ -277,66 +288,49 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
       x.node->mgr == y.node->mgr,
       "apply can only be called on BDDs with the same manager");
 
+    mini_bdd_mgrt *mgr = x.node->mgr;
+
     switch(t.phase)
     {
     case stack_elementt::phaset::INIT:
     {
       // dynamic programming
-      Gt::const_iterator G_it = G.find(t.key);
-      if(G_it != G.end())
+      if(cache_lookup(x, y, t.result))
       {
-        t.result = G_it->second;
         stack.pop();
       }
       else
       {
+        const unsigned x_level = mgr->level(x.var());
+        const unsigned y_level = mgr->level(y.var());
+
         if(x.is_constant() && y.is_constant())
         {
           bool result_truth = fkt(x.is_true(), y.is_true());
-          const mini_bdd_mgrt &mgr = *x.node->mgr;
-          t.result = result_truth ? mgr.True() : mgr.False();
+          t.result = result_truth ? mgr->True() : mgr->False();
           stack.pop();
         }
-        else if(x.var() == y.var())
+        else if(x_level == y_level)
         {
           t.var = x.var();
           t.phase = stack_elementt::phaset::FINISH;
 
-          INVARIANT(
-            x.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            y.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            x.high().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            y.high().var() > t.var, "applying won't break variable order");
-
           stack.push(stack_elementt(t.lr, x.low(), y.low()));
           stack.push(stack_elementt(t.hr, x.high(), y.high()));
         }
-        else if(x.var() < y.var())
+        else if(x_level < y_level)
         {
           t.var = x.var();
           t.phase = stack_elementt::phaset::FINISH;
 
-          INVARIANT(
-            x.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            x.high().var() > t.var, "applying won't break variable order");
-
           stack.push(stack_elementt(t.lr, x.low(), y));
           stack.push(stack_elementt(t.hr, x.high(), y));
         }
-        else /* x.var() > y.var() */
+        else /* x_level > y_level */
         {
           t.var = y.var();
           t.phase = stack_elementt::phaset::FINISH;
 
-          INVARIANT(
-            y.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            y.high().var() > t.var, "applying won't break variable order");
-
           stack.push(stack_elementt(t.lr, x, y.low()));
           stack.push(stack_elementt(t.hr, x, y.high()));
         }
@@ -346,9 +340,9 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
 
     case stack_elementt::phaset::FINISH:
     {
-      mini_bdd_mgrt *mgr = x.node->mgr;
+      // mk checks that the variable order is kept
       t.result = mgr->mk(t.var, t.lr, t.hr);
-      G[t.key] = t.result;
+      cache_insert(x, y, t.result);
       stack.pop();
     }
     break;
@@ -368,7 +362,8 @@ bool equal_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator==(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(equal_fkt)(*this, other);
+  return mini_bdd_applyt(equal_fkt, mini_bdd_mgrt::operationt::EQUAL)(
+    *this, other);
 }
 
 bool xor_fkt(bool x, bool y)
@@ -378,7 +373,8 @@ bool xor_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator^(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(xor_fkt)(*this, other);
+  return mini_bdd_applyt(xor_fkt, mini_bdd_mgrt::operationt::XOR)(
+    *this, other);
 }
 
 mini_bddt mini_bddt::operator!() const
@@ -395,7 +391,8 @@ bool and_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator&(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(and_fkt)(*this, other);
+  return mini_bdd_applyt(and_fkt, mini_bdd_mgrt::operationt::AND)(
+    *this, other);
 }
 
 bool or_fkt(bool x, bool y)
@@ -405,20 +402,143 @@ bool or_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator|(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(or_fkt)(*this, other);
+  return mini_bdd_applyt(or_fkt, mini_bdd_mgrt::operationt::OR)(*this, other);
+}
+
+mini_bddt mini_bdd_mgrt::ite(
+  const mini_bddt &_f,
+  const mini_bddt &_g,
+  const mini_bddt &_h)
+{
+  PRECONDITION_WITH_DIAGNOSTICS(
+    _f.is_initialized() && _g.is_initialized() && _h.is_initialized(),
+    "ite can only be called on initialized BDDs");
+
+  struct stack_elementt
+  {
+    stack_elementt(
+      mini_bddt &_result,
+      const mini_bddt &_f,
+      const mini_bddt &_g,
+      const mini_bddt &_h)
+      : result(_result), f(_f), g(_g), h(_h), var(0), phase(phaset::INIT)
+    {
+    }
+    mini_bddt &result, f, g, h, lr, hr;
+    unsigned var;
+    enum class phaset
+    {
+      INIT,
+      FINISH
+    } phase;
+  };
+
+  mini_bddt u; // return value
+
+  std::stack<stack_elementt> stack;
+  stack.push(stack_elementt(u, _f, _g, _h));
+
+  while(!stack.empty())
+  {
+    auto &t = stack.top();
+
+    switch(t.phase)
+    {
+    case stack_elementt::phaset::INIT:
+    {
+      // ite(f, f, h) = ite(f, 1, h) and ite(f, g, f) = ite(f, g, 0)
+      if(t.g.node == t.f.node)
+        t.g = True();
+      if(t.h.node == t.f.node)
+        t.h = False();
+
+      if(t.f.is_true() || t.g.node == t.h.node)
+      {
+        t.result = t.g;
+        stack.pop();
+      }
+      else if(t.f.is_false())
+      {
+        t.result = t.h;
+        stack.pop();
+      }
+      else if(t.g.is_true() && t.h.is_false())
+      {
+        t.result = t.f;
+        stack.pop();
+      }
+      else if(cache_lookup(
+                operationt::ITE,
+                t.f.node_number(),
+                t.g.node_number(),
+                t.h.node_number(),
+                t.result))
+      {
+        stack.pop();
+      }
+      else
+      {
+        const unsigned top = std::min(
+          level(t.f.var()), std::min(level(t.g.var()), level(t.h.var())));
+        t.var = level_to_var[top];
+        t.phase = stack_elementt::phaset::FINISH;
+
+        auto low = [this, top](const mini_bddt &x) -> const mini_bddt & {
+          return level(x.var()) == top ? x.low() : x;
+        };
+        auto high = [this, top](const mini_bddt &x) -> const mini_bddt & {
+          return level(x.var()) == top ? x.high() : x;
+        };
+
+        stack.push(stack_elementt(t.lr, low(t.f), low(t.g), low(t.h)));
+        stack.push(stack_elementt(t.hr, high(t.f), high(t.g), high(t.h)));
+      }
+    }
+    break;
+
+    case stack_elementt::phaset::FINISH:
+    {
+      t.result = mk(t.var, t.lr, t.hr);
+      cache_insert(
+        operationt::ITE,
+        t.f.node_number(),
+        t.g.node_number(),
+        t.h.node_number(),
+        t.result);
+      stack.pop();
+    }
+    break;
+    }
+  }
+
+  POSTCONDITION_WITH_DIAGNOSTICS(
+    u.is_initialized(), "the resulting BDD is initialized");
+
+  return u;
 }
 
 mini_bdd_mgrt::mini_bdd_mgrt()
+  : var_to_level(1, 0),
+    level_to_var(1, 0),
+    unique_table(1024, EMPTY_SLOT),
+    cache(1024)
 {
   // add true/false nodes
-  nodes.push_back(mini_bdd_nodet(this, 0, 0, mini_bddt(), mini_bddt()));
+  nodes.emplace_back(this, 0, 0, mini_bddt(), mini_bddt());
   false_bdd = mini_bddt(&nodes.back());
-  nodes.push_back(mini_bdd_nodet(this, 1, 1, mini_bddt(), mini_bddt()));
+  nodes.emplace_back(this, 1, 1, mini_bddt(), mini_bddt());
   true_bdd = mini_bddt(&nodes.back());
 }
 
 mini_bdd_mgrt::~mini_bdd_mgrt()
 {
+  // the nodes are destroyed in no particular order, so drop the edges
+  // between them without updating the reference counters
+  for(auto &n : nodes)
+  {
+    n.low.node = nullptr;
+    n.high.node = nullptr;
+  }
 }
 
 mini_bddt
@@ -427,60 +547,350 @@ mini_bdd_mgrt::mk(unsigned var, const mini_bddt &low, const mini_bddt &high)
   PRECONDITION_WITH_DIAGNOSTICS(
     var <= var_table.size(), "cannot make a BDD for an unknown variable");
   PRECONDITION_WITH_DIAGNOSTICS(
-    low.var() > var, "low-edge would break variable ordering");
+    level(low.var()) > level(var), "low-edge would break variable ordering");
   // NOLINTNEXTLINE(build/deprecated)
   PRECONDITION_WITH_DIAGNOSTICS(
-    high.var() > var, "high-edge would break variable ordering");
+    level(high.var()) > level(var), "high-edge would break variable ordering");
 
   if(low.node_number() == high.node_number())
     return low;
-  else
+
+  const std::size_t slot =
+    unique_slot(var, low.node_number(), high.node_number());
+
+  if(unique_table[slot] != EMPTY_SLOT && unique_table[slot] != DELETED_SLOT)
+    return mini_bddt(&nodes[unique_table[slot]]);
+
+  // free the dead nodes once they make up half of all nodes
+  if(free.empty() && dead_nodes >= 4096 && dead_nodes * 2 >= nodes.size())
+    collect_garbage();
+
+  mini_bdd_nodet *n;
+
+  if(free.empty())
+  {
+    unsigned new_number = nodes.back().node_number + 1;
+    nodes.emplace_back(this, var, new_number, low, high);
+    n = &nodes.back();
+  }
+  else // reuse a node
   {
-    reverse_keyt reverse_key(var, low, high);
-    reverse_mapt::const_iterator it = reverse_map.find(reverse_key);
+    n = &nodes[free.back()];
+    free.pop_back();
+    n->var = var;
+    n->low = low;
+    n->high = high;
+  }
+
+  // there are no references to the node yet
+  dead_nodes++;
+
+  unique_insert(*n);
+
+  if(!var_nodes.empty())
+    var_nodes[var].push_back(n->node_number);
+
+  // keep the computed cache about as large as the set of nodes
+  if(nodes.size() > cache.size() && cache.size() < (1u << 20))
+    cache.assign(cache.size() * 2, cache_entryt());
+
+  return mini_bddt(n);
+}
+
+static std::size_t hash_numbers(unsigned a, unsigned b, unsigned c)
+{
+  std::size_t h = a;
+  h = h * 0x9e3779b1u + b;
+  h = h * 0x9e3779b1u + c;
+  return h ^ (h >> 16);
+}
+
+std::size_t
+mini_bdd_mgrt::unique_slot(unsigned var, unsigned low, unsigned high) const
+{
+  const std::size_t mask = unique_table.size() - 1;
+  std::size_t slot = hash_numbers(var, low, high) & mask;
+  std::size_t deleted_slot = unique_table.size();
 
-    if(it != reverse_map.end())
-      return mini_bddt(it->second);
+  // the table is at most half full, hence there is an empty slot
+  while(true)
+  {
+    const unsigned number = unique_table[slot];
+
+    if(number == EMPTY_SLOT)
+      return deleted_slot < unique_table.size() ? deleted_slot : slot;
+    else if(number == DELETED_SLOT)
+    {
+      if(deleted_slot == unique_table.size())
+        deleted_slot = slot;
+    }
     else
     {
-      mini_bdd_nodet *n;
-
-      if(free.empty())
-      {
-        unsigned new_number = nodes.back().node_number + 1;
-        nodes.push_back(mini_bdd_nodet(this, var, new_number, low, high));
-        n = &nodes.back();
-      }
-      else // reuse a node
+      const mini_bdd_nodet &n = nodes[number];
+      if(
+        n.var == var && n.low.node->node_number == low &&
+        n.high.node->node_number == high)
       {
-        n = free.top();
-        free.pop();
-        n->var = var;
-        n->low = low;
-        n->high = high;
+        return slot;
       }
+    }
+
+    slot = (slot + 1) & mask;
+  }
+}
+
+void mini_bdd_mgrt::unique_insert(const mini_bdd_nodet &n)
+{
+  if((unique_used + 1) * 2 > unique_table.size())
+    unique_rehash();
 
-      reverse_map[reverse_key] = n;
-      return mini_bddt(n);
+  const std::size_t slot =
+    unique_slot(n.var, n.low.node_number(), n.high.node_number());
+
+  INVARIANT(
+    unique_table[slot] == EMPTY_SLOT || unique_table[slot] == DELETED_SLOT,
+    "nodes are unique");
+
+  if(unique_table[slot] == EMPTY_SLOT)
+    unique_used++;
+
+  unique_table[slot] = n.node_number;
+  unique_entries++;
+}
+
+void mini_bdd_mgrt::unique_erase(const mini_bdd_nodet &n)
+{
+  const std::size_t slot =
+    unique_slot(n.var, n.low.node_number(), n.high.node_number());
+
+  INVARIANT(unique_table[slot] == n.node_number, "node is in unique table");
+
+  unique_table[slot] = DELETED_SLOT;
+  unique_entries--;
+}
+
+void mini_bdd_mgrt::unique_rehash()
+{
+  std::vector<unsigned> old_table(
+    unique_table.size() * (unique_entries * 4 >= unique_table.size() ? 2 : 1),
+    EMPTY_SLOT);
+  old_table.swap(unique_table);
+  unique_entries = 0;
+  unique_used = 0;
+
+  // Take the nodes from the table rather than from the nodes, as nodes
+  // are taken out of the table while they are changed by swap_levels.
+  for(const auto number : old_table)
+  {
+    if(number != EMPTY_SLOT && number != DELETED_SLOT)
+    {
+      const mini_bdd_nodet &n = nodes[number];
+      unique_table[unique_slot(
+        n.var, n.low.node_number(), n.high.node_number())] = number;
+      unique_entries++;
+      unique_used++;
     }
   }
 }
 
-bool mini_bdd_mgrt::reverse_keyt::
-operator<(const mini_bdd_mgrt::reverse_keyt &y) const
+std::size_t mini_bdd_mgrt::cache_index(
+  operationt op,
+  unsigned f,
+  unsigned g,
+  unsigned h) const
 {
-  const reverse_keyt &x = *this;
+  return (hash_numbers(f, g, h) + static_cast<unsigned>(op)) &
+         (cache.size() - 1);
+}
 
-  if(x.var < y.var)
-    return true;
-  else if(x.var > y.var)
-    return false;
-  else if(x.low < y.low)
-    return true;
-  else if(x.low > y.low)
+bool mini_bdd_mgrt::cache_lookup(
+  operationt op,
+  unsigned f,
+  unsigned g,
+  unsigned h,
+  mini_bddt &result)
+{
+  const cache_entryt &entry = cache[cache_index(op, f, g, h)];
+
+  if(entry.op != op || entry.f != f || entry.g != g || entry.h != h)
     return false;
-  else
-    return x.high < y.high;
+
+  result = mini_bddt(&nodes[entry.result]);
+  return true;
+}
+
+void mini_bdd_mgrt::cache_insert(
+  operationt op,
+  unsigned f,
+  unsigned g,
+  unsigned h,
+  const mini_bddt &result)
+{
+  cache_entryt &entry = cache[cache_index(op, f, g, h)];
+  entry.op = op;
+  entry.f = f;
+  entry.g = g;
+  entry.h = h;
+  entry.result = result.node_number();
+}
+
+void mini_bdd_mgrt::collect_garbage()
+{
+  // the cache may refer to the nodes that are freed
+  std::fill(cache.begin(), cache.end(), cache_entryt());
+
+  std::vector<unsigned> worklist;
+
+  for(const auto &n : nodes)
+  {
+    if(n.reference_counter == 0 && n.low.is_initialized())
+      worklist.push_back(n.node_number);
+  }
+
+  free_nodes(worklist);
+
+  // drop the deleted slots
+  unique_rehash();
+}
+
+void mini_bdd_mgrt::free_nodes(std::vector<unsigned> &worklist)
+{
+  while(!worklist.empty())
+  {
+    mini_bdd_nodet &n = nodes[worklist.back()];
+    worklist.pop_back();
+
+    // skip the terminals and the nodes that are referenced or freed already
+    if(n.reference_counter != 0 || !n.low.is_initialized())
+      continue;
+
+    unique_erase(n);
+    worklist.push_back(n.low.node_number());
+    worklist.push_back(n.high.node_number());
+    n.low.clear();
+    n.high.clear();
+    dead_nodes--;
+    free.push_back(n.node_number);
+  }
+}
+
+void mini_bdd_mgrt::reorder()
+{
+  collect_garbage();
+
+  var_nodes.assign(var_table.size() + 1, std::vector<unsigned>());
+
+  for(const auto &n : nodes)
+  {
+    if(n.low.is_initialized())
+      var_nodes[n.var].push_back(n.node_number);
+  }
+
+  // sift the variables with the most nodes first
+  std::vector<unsigned> vars;
+  for(unsigned v = 1; v <= var_table.size(); v++)
+    vars.push_back(v);
+
+  std::stable_sort(vars.begin(), vars.end(), [this](unsigned a, unsigned b) {
+    return var_nodes[a].size() > var_nodes[b].size();
+  });
+
+  for(const auto v : vars)
+    sift(v);
+
+  var_nodes.clear();
+}
+
+void mini_bdd_mgrt::sift(unsigned var)
+{
+  const unsigned last_level = var_table.size();
+  std::size_t best_size = number_of_nodes();
+  unsigned best_level = level(var);
+
+  // move var down and then up, stopping early once the number of nodes has
+  // grown by a fifth
+  for(const bool down : {true, false})
+  {
+    while(down ? level(var) < last_level : level(var) > 1)
+    {
+      swap_levels(down ? level(var) : level(var) - 1);
+
+      const std::size_t size = number_of_nodes();
+
+      if(size < best_size)
+      {
+        best_size = size;
+        best_level = level(var);
+      }
+      else if(size > best_size + best_size / 5)
+        break;
+    }
+  }
+
+  while(level(var) < best_level)
+    swap_levels(level(var));
+
+  while(level(var) > best_level)
+    swap_levels(level(var) - 1);
+}
+
+void mini_bdd_mgrt::swap_levels(unsigned l)
+{
+  const unsigned x = level_to_var[l];
+  const unsigned y = level_to_var[l + 1];
+
+  // The nodes of x that have a child labelled y are changed in place into
+  // nodes of y, while the others stay where they are.
+  std::vector<unsigned> &x_nodes = var_nodes[x];
+  std::sort(x_nodes.begin(), x_nodes.end());
+  x_nodes.erase(std::unique(x_nodes.begin(), x_nodes.end()), x_nodes.end());
+
+  std::vector<unsigned> changed, kept;
+
+  for(const auto number : x_nodes)
+  {
+    const mini_bdd_nodet &n = nodes[number];
+
+    if(n.var != x || !n.low.is_initialized())
+      continue;
+    else if(n.low.var() == y || n.high.var() == y)
+      changed.push_back(number);
+    else
+      kept.push_back(number);
+  }
+
+  x_nodes.swap(kept);
+
+  std::swap(level_to_var[l], level_to_var[l + 1]);
+  var_to_level[x] = l + 1;
+  var_to_level[y] = l;
+
+  std::vector<unsigned> worklist;
+
+  for(const auto number : changed)
+  {
+    mini_bdd_nodet &n = nodes[number];
+    unique_erase(n);
+
+    // the cofactors f_ab with x=a and y=b
+    const mini_bddt f00 = n.low.var() == y ? n.low.low() : n.low;
+    const mini_bddt f01 = n.low.var() == y ? n.low.high() : n.low;
+    const mini_bddt f10 = n.high.var() == y ? n.high.low() : n.high;
+    const mini_bddt f11 = n.high.var() == y ? n.high.high() : n.high;
+
+    worklist.push_back(n.low.node_number());
+    worklist.push_back(n.high.node_number());
+
+    n.low = mk(x, f00, f10);
+    n.high = mk(x, f01, f11);
+    n.var = y;
+
+    unique_insert(n);
+    var_nodes[y].push_back(number);
+  }
+
+  // free the nodes of y that are no longer referenced
+  free_nodes(worklist);
 }
 
 void mini_bdd_mgrt::DumpTable(std::ostream &out) const
@@ -537,10 +947,12 @@ mini_bddt restrictt::RES(const mini_bddt &u)
   mini_bdd_mgrt *mgr = u.node->mgr;
 
   mini_bddt t;
+  const unsigned u_level = mgr->level(u.var());
+  const unsigned var_level = mgr->level(var);
 
-  if(u.var() > var)
+  if(u_level > var_level)
     t = u;
-  else if(u.var() < var)
+  else if(u_level < var_level)
     t = mgr->mk(u.var(), RES(u.low()), RES(u.high()));
   else // u.var()==var
     t = RES(value ? u.high() : u.low());
@@ -21,9 +21,8 @@ Author: Daniel Kroening, kroening@kroening.com
  * \date   Mon Sep 28 00:00:00 BST 2009
 */
 
-#include <list>
+#include <deque>
 #include <map>
-#include <stack>
 #include <string>
 #include <vector>
 
@@ -101,12 +100,32 @@ public:
   const mini_bddt &False() const;
 
   friend class mini_bdd_nodet;
+  friend class mini_bddt;
+  friend class mini_bdd_applyt;
 
-  // create a node (consulting the reverse-map)
+  // create a node (consulting the unique table)
   mini_bddt mk(unsigned var, const mini_bddt &low, const mini_bddt &high);
 
+  /// If-then-else: the BDD for `(f & g) | (!f & h)`
+  mini_bddt ite(const mini_bddt &f, const mini_bddt &g, const mini_bddt &h);
+
+  /// The number of nodes that are referenced, including those that are only
+  /// referenced by nodes that are not yet freed by \ref collect_garbage
   std::size_t number_of_nodes();
 
+  /// The position of \p var in the variable order, starting from 1 for the
+  /// variable at the root; the terminals are below all variables
+  unsigned level(unsigned var) const;
+
+  /// Reduce the number of nodes by changing the variable order, moving each
+  /// variable to its best level by sifting (Rudell 1993). The nodes are
+  /// changed in place, so all BDDs remain valid, but no BDD operation may be
+  /// in progress.
+  void reorder();
+
+  /// Free the nodes that are no longer referenced
+  void collect_garbage();
+
   struct var_table_entryt
   {
     std::string label;
@@ -117,24 +136,83 @@ public:
   var_tablet var_table;
 
 protected:
-  typedef std::list<mini_bdd_nodet> nodest;
+  // the nodes, indexed by node number; a deque keeps them in place
+  typedef std::deque<mini_bdd_nodet> nodest;
   nodest nodes;
   mini_bddt true_bdd, false_bdd;
 
-  // this is our reverse-map for nodes
-  struct reverse_keyt
+  // the variable order, for variables numbered from 1
+  std::vector<unsigned> var_to_level, level_to_var;
+
+  // Nodes that are no longer referenced are not freed right away, but only
+  // by collect_garbage(), as they may be found again in the unique table or
+  // the computed cache.
+  std::size_t dead_nodes = 0;
+
+  // the numbers of the freed nodes, which mk reuses
+  std::vector<unsigned> free;
+
+  // The unique table, an open-addressing hash table with linear probing
+  // holding node numbers. As the terminals are never in the table, their
+  // numbers mark the empty and the deleted slots.
+  static const unsigned EMPTY_SLOT = 0;
+  static const unsigned DELETED_SLOT = 1;
+  std::vector<unsigned> unique_table;
+  // the number of nodes in the table, and of slots that are not empty
+  std::size_t unique_entries = 0, unique_used = 0;
+
+  // the slot of the node with the given key, or else the slot to insert it
+  std::size_t unique_slot(unsigned var, unsigned low, unsigned high) const;
+  void unique_insert(const mini_bdd_nodet &);
+  void unique_erase(const mini_bdd_nodet &);
+  void unique_rehash();
+
+  // The computed cache, a direct-mapped table of operation results. It
+  // holds node numbers, which are not reused before the cache is cleared by
+  // collect_garbage().
+  enum class operationt : unsigned
   {
-    unsigned var, low, high;
-    reverse_keyt(unsigned _var, const mini_bddt &_low, const mini_bddt &_high);
-
-    bool operator<(const reverse_keyt &) const;
+    NONE,
+    AND,
+    OR,
+    XOR,
+    EQUAL,
+    ITE
   };
 
-  typedef std::map<reverse_keyt, mini_bdd_nodet *> reverse_mapt;
-  reverse_mapt reverse_map;
+  struct cache_entryt
+  {
+    operationt op = operationt::NONE;
+    unsigned f = 0, g = 0, h = 0, result = 0;
+  };
 
-  typedef std::stack<mini_bdd_nodet *> freet;
-  freet free;
+  std::vector<cache_entryt> cache;
+
+  std::size_t
+  cache_index(operationt op, unsigned f, unsigned g, unsigned h) const;
+  bool cache_lookup(
+    operationt op,
+    unsigned f,
+    unsigned g,
+    unsigned h,
+    mini_bddt &result);
+  void cache_insert(
+    operationt op,
+    unsigned f,
+    unsigned g,
+    unsigned h,
+    const mini_bddt &result);
+
+  // free the nodes in the worklist, and those of their descendants, that
+  // are not referenced
+  void free_nodes(std::vector<unsigned> &worklist);
+
+  // While reordering, the numbers of the nodes of each variable; these may
+  // include nodes that were freed or changed since.
+  std::vector<std::vector<unsigned>> var_nodes;
+
+  void sift(unsigned var);
+  void swap_levels(unsigned level);
 };
 
 mini_bddt restrict(const mini_bddt &u, unsigned var, const bool value);
@@ -45,7 +45,7 @@ void arrayst::record_array_index(const index_exprt &index)
   //   entry for the root of the equivalence class
   //   because this map is accessed during building the error trace
   std::size_t number=arrays.number(index.array());
-  if(index_map[number].insert(index.index()).second)
+  if(index_map[number].insert(index.index()))
     update_indices.insert(number);
 }
 
@@ -70,6 +70,14 @@ literalt arrayst::record_array_equality(
   array_equalities.back().f2=op1;
   array_equalities.back().l=SUB::equality(op0, op1);
 
+  if(array_theory == array_theoryt::WEAK_EQUIVALENCE)
+  {
+    // the equality becomes an edge of the weak equivalence graph
+    arrays.number(op0);
+    arrays.number(op1);
+    return array_equalities.back().l;
+  }
+
   arrays.make_union(op0, op1);
   collect_arrays(op0);
   collect_arrays(op1);
@@ -871,6 +879,8 @@ std::string arrayst::enum_to_string(constraint_typet type)
     return "arrayComprehension";
   case constraint_typet::ARRAY_EQUALITY:
     return "arrayEquality";
+  case constraint_typet::ARRAY_WEAK_EQUIVALENCE:
+    return "arrayWeakEquivalence";
   default:
     UNREACHABLE;
   }
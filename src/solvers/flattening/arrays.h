@@ -12,10 +12,15 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_FLATTENING_ARRAYS_H
 #define CPROVER_SOLVERS_FLATTENING_ARRAYS_H
 
+#include <algorithm>
+#include <limits>
 #include <list>
 #include <set>
 #include <unordered_set>
+#include <vector>
 
+#include <util/mp_arith.h>
+#include <util/optional.h>
 #include <util/union_find.h>
 
 #include "equality.h"
@@ -50,14 +55,37 @@ public:
   literalt record_array_equality(const equal_exprt &expr);
   void record_array_index(const index_exprt &expr);
 
+  /// Decision procedures for the theory of arrays
+  enum class array_theoryt
+  {
+    /// instantiate the array axioms for all index terms before solving
+    EAGER,
+    /// add only those read-over-write lemmas that are violated by the
+    /// model of the previous solver call, found by traversing a weak
+    /// equivalence graph of the array terms
+    WEAK_EQUIVALENCE
+  };
+
+  void set_array_theory(array_theoryt theory)
+  {
+    array_theory = theory;
+  }
+
 protected:
   const namespacet &ns;
   messaget log;
   message_handlert &message_handler;
 
+  array_theoryt array_theory = array_theoryt::EAGER;
+
+  decision_proceduret::resultt dec_solve() override;
+
   virtual void post_process_arrays()
   {
-    add_array_constraints();
+    if(array_theory == array_theoryt::WEAK_EQUIVALENCE)
+      update_weak_equivalence_graph();
+    else
+      add_array_constraints();
   }
 
   struct array_equalityt
@@ -75,10 +103,124 @@ protected:
   // this is used to find the clusters of arrays being compared
   union_find<exprt, irep_hash> arrays;
 
+  /// The index terms used with an array, in the order in which they were
+  /// recorded, with hashed membership tests.
+  ///
+  /// Adding constraints for the indices of a set may record further indices
+  /// in the same set. Iterators therefore refer to indices by position and
+  /// yield copies, so they stay valid while the set grows, and a loop up to
+  /// \ref end also visits the indices added while it runs.
+  class index_sett
+  {
+  public:
+    class const_iterator
+    {
+    public:
+      typedef std::input_iterator_tag iterator_category;
+      typedef exprt value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const exprt *pointer;
+      typedef exprt reference;
+
+      const_iterator(const std::vector<exprt> &indices, std::size_t position)
+        : indices(&indices), position(position)
+      {
+      }
+
+      exprt operator*() const
+      {
+        return (*indices)[position];
+      }
+
+      /// Only valid until the next index is added
+      pointer operator->() const
+      {
+        return &(*indices)[position];
+      }
+
+      const_iterator &operator++()
+      {
+        ++position;
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const_iterator old = *this;
+        ++position;
+        return old;
+      }
+
+      /// The end iterator compares equal to every iterator that is past the
+      /// current last index
+      bool operator==(const const_iterator &other) const
+      {
+        return indices == other.indices &&
+               std::min(position, indices->size()) ==
+                 std::min(other.position, indices->size());
+      }
+
+      bool operator!=(const const_iterator &other) const
+      {
+        return !(*this == other);
+      }
+
+    private:
+      const std::vector<exprt> *indices;
+      std::size_t position;
+    };
+
+    /// \return true iff \p index was not in the set before
+    bool insert(const exprt &index)
+    {
+      if(!members.insert(index).second)
+        return false;
+
+      indices.push_back(index);
+      return true;
+    }
+
+    template <typename iteratort>
+    void insert(iteratort first, iteratort last)
+    {
+      for(; first != last; ++first)
+        insert(*first);
+    }
+
+    std::size_t count(const exprt &index) const
+    {
+      return members.count(index);
+    }
+
+    std::size_t size() const
+    {
+      return indices.size();
+    }
+
+    bool empty() const
+    {
+      return indices.empty();
+    }
+
+    const_iterator begin() const
+    {
+      return const_iterator(indices, 0);
+    }
+
+    const_iterator end() const
+    {
+      return const_iterator(indices, std::numeric_limits<std::size_t>::max());
+    }
+
+  protected:
+    std::vector<exprt> indices;
+    std::unordered_set<exprt, irep_hash> members;
+  };
+
   // this tracks the array indicies for each array
-  typedef std::set<exprt> index_sett;
-  // references to values in this container need to be stable as
-  // elements are added while references are held
+  // references to the index sets in this container need to be stable as
+  // sets are added while references are held; the indices within a set are
+  // only accessed through positions, see index_sett
   typedef std::map<std::size_t, index_sett> index_mapt;
   index_mapt index_map;
 
@@ -122,7 +264,8 @@ protected:
     ARRAY_TYPECAST,
     ARRAY_CONSTANT,
     ARRAY_COMPREHENSION,
-    ARRAY_EQUALITY
+    ARRAY_EQUALITY,
+    ARRAY_WEAK_EQUIVALENCE
   };
 
   typedef std::map<constraint_typet, size_t> array_constraint_countt;
@@ -162,6 +305,52 @@ protected:
 
   virtual bool is_unbounded_array(const typet &type) const=0;
     // (maybe this function should be partially moved here from boolbv)
+
+  /// \return the value of \p expr in the current model, or nil if
+  ///   \p expr has not been converted
+  virtual exprt get_converted_value(const exprt &expr) const = 0;
+
+  // the weak equivalence graph: the nodes are the numbers of the array
+  // terms in \ref arrays, edges link terms that agree on all indices except
+  // (for edges from a with-expression) the updated ones
+  struct weak_equivalence_edget
+  {
+    std::size_t target;
+    // the edge is active iff this literal is true in the model
+    literalt guard;
+    // the updated indices, and their values in the model when checking it
+    exprt::operandst stores;
+    std::vector<optionalt<mp_integer>> store_values;
+  };
+
+  typedef std::vector<std::vector<weak_equivalence_edget>>
+    weak_equivalence_grapht;
+  weak_equivalence_grapht weak_equivalence_graph;
+
+  // the with-expressions whose updated indices have been constrained
+  std::unordered_set<std::size_t> weak_equivalence_stores;
+  std::unordered_set<exprt, irep_hash> weak_equivalence_lemmas;
+
+  bool update_weak_equivalence_graph();
+  bool add_weak_equivalence_lemmas();
+  bool add_weak_equivalence_lemmas(
+    std::size_t node,
+    const exprt &index,
+    std::size_t position);
+
+  // the node and the outgoing edge through which a node was reached
+  typedef std::vector<std::pair<std::size_t, std::size_t>>
+    weak_equivalence_patht;
+
+  bool add_weak_equivalence_lemma(
+    const weak_equivalence_patht &parents,
+    std::size_t node,
+    std::size_t target,
+    const exprt &index,
+    const exprt &premise,
+    const exprt &read,
+    const exprt &value);
+  optionalt<mp_integer> get_index_value(const exprt &index) const;
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_ARRAYS_H
@@ -0,0 +1,395 @@
+/*******************************************************************\
+
+Module: Theory of Arrays via Weak Equivalence
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Theory of Arrays via Weak Equivalence
+///
+/// Rather than instantiating the array axioms for all pairs of index terms
+/// up front, the array terms are arranged in a weak equivalence graph:
+/// `a` and `a with [k:=v]` agree on all indices other than `k`, the two
+/// cases of an `if` agree with it when the condition selects them, and so
+/// on. After each satisfying solver call, all reads at the same index value
+/// that are connected by a path avoiding stores to that index must agree,
+/// and so must reads that reach a store, an `array_of` or an array constant
+/// defining that index. Lemmas are added for the violations only.
+
+#include "arrays.h"
+
+#include <util/arith_tools.h>
+#include <util/replace_expr.h>
+#include <util/std_expr.h>
+
+#include <solvers/prop/literal_expr.h>
+
+/// \return true iff the values \p a and \p b, obtained from the model, are
+///   known to be the same
+static bool same_value(const exprt &a, const exprt &b)
+{
+  if(a.is_nil() || b.is_nil())
+    return false;
+
+  if(a.is_constant() && b.is_constant())
+  {
+    return a.type() == b.type() &&
+           to_constant_expr(a).get_value() == to_constant_expr(b).get_value();
+  }
+
+  return a == b;
+}
+
+decision_proceduret::resultt arrayst::dec_solve()
+{
+  if(array_theory != array_theoryt::WEAK_EQUIVALENCE)
+    return SUB::dec_solve();
+
+  std::size_t iteration = 0;
+
+  while(true)
+  {
+    const decision_proceduret::resultt result = SUB::dec_solve();
+    ++iteration;
+
+    if(
+      result != decision_proceduret::resultt::D_SATISFIABLE ||
+      !add_weak_equivalence_lemmas())
+    {
+      log.statistics() << "Array theory: " << iteration << " solver calls, "
+                       << weak_equivalence_lemmas.size() << " lemmas"
+                       << messaget::eom;
+      return result;
+    }
+  }
+}
+
+optionalt<mp_integer> arrayst::get_index_value(const exprt &index) const
+{
+  if(index.is_constant())
+    return numeric_cast<mp_integer>(index);
+
+  const exprt value = get_converted_value(index);
+
+  if(value.is_nil())
+    return {};
+
+  return numeric_cast<mp_integer>(value);
+}
+
+/// (Re-)builds \ref weak_equivalence_graph from the array terms and
+/// equalities recorded so far. The updated indices of with-expressions
+/// that have not been seen before are constrained right away.
+/// \return true iff any constraints have been added
+bool arrayst::update_weak_equivalence_graph()
+{
+  bool added = false;
+
+  weak_equivalence_graph.clear();
+
+  auto add_edge = [this](
+                    std::size_t a,
+                    std::size_t b,
+                    literalt guard,
+                    const exprt::operandst &stores) {
+    weak_equivalence_graph.resize(arrays.size());
+    weak_equivalence_graph[a].push_back({b, guard, stores, {}});
+    weak_equivalence_graph[b].push_back({a, guard, stores, {}});
+  };
+
+  // numbering the operands may add further terms
+  for(std::size_t node = 0; node < arrays.size(); ++node)
+  {
+    // take a copy as arrays may grow
+    const exprt term = arrays[node];
+
+    // the trace is built from the index sets of all array terms
+    index_map[node];
+
+    if(term.id() == ID_with)
+    {
+      const with_exprt &with_expr = to_with_expr(term);
+      const exprt::operandst &operands = with_expr.operands();
+      const typet &subtype = with_expr.type().subtype();
+
+      exprt::operandst stores;
+
+      const bool new_store = weak_equivalence_stores.insert(node).second;
+
+      for(std::size_t i = 1; i + 1 < operands.size(); i += 2)
+      {
+        const exprt &index = operands[i];
+        stores.push_back(index);
+
+        if(new_store)
+        {
+          // x[i]=v, as with the eager procedure
+          prop.l_set_to_true(convert(
+            equal_exprt(index_exprt(term, index, subtype), operands[i + 1])));
+          array_constraint_count[constraint_typet::ARRAY_WITH]++;
+          added = true;
+        }
+      }
+
+      add_edge(
+        node, arrays.number(with_expr.old()), const_literal(true), stores);
+    }
+    else if(term.id() == ID_if)
+    {
+      const if_exprt &if_expr = to_if_expr(term);
+      const literalt cond = convert(if_expr.cond());
+
+      add_edge(node, arrays.number(if_expr.true_case()), cond, {});
+      add_edge(node, arrays.number(if_expr.false_case()), !cond, {});
+    }
+    else if(term.id() == ID_typecast)
+    {
+      const exprt &op = to_typecast_expr(term).op();
+
+      DATA_INVARIANT(
+        op.type().id() == ID_array,
+        "unexpected array type cast from " + op.type().id_string());
+
+      add_edge(node, arrays.number(op), const_literal(true), {});
+    }
+  }
+
+  for(const auto &equality : array_equalities)
+  {
+    add_edge(
+      arrays.number(equality.f1), arrays.number(equality.f2), equality.l, {});
+  }
+
+  weak_equivalence_graph.resize(arrays.size());
+
+  return added;
+}
+
+/// Adds the lemmas violated by the current model.
+/// \return true iff any lemmas have been added
+bool arrayst::add_weak_equivalence_lemmas()
+{
+  bool added = update_weak_equivalence_graph();
+
+  for(auto &edges : weak_equivalence_graph)
+  {
+    for(auto &edge : edges)
+    {
+      for(const auto &store : edge.stores)
+        edge.store_values.push_back(get_index_value(store));
+    }
+  }
+
+  for(std::size_t node = 0; node < weak_equivalence_graph.size(); ++node)
+  {
+    // take a copy as converting lemmas records further indices
+    const index_sett &index_set = index_map[node];
+    const std::vector<exprt> indices(index_set.begin(), index_set.end());
+
+    for(std::size_t position = 0; position < indices.size(); ++position)
+    {
+      if(add_weak_equivalence_lemmas(node, indices[position], position))
+        added = true;
+    }
+  }
+
+  return added;
+}
+
+/// Checks the read of \p index (the \p position-th index of the term
+/// \p node) against the reads and definitions of all terms that are weakly
+/// equivalent to \p node modulo the value of \p index. To add each lemma
+/// once only, reads are only checked against reads recorded later.
+/// \return true iff any lemmas have been added
+bool arrayst::add_weak_equivalence_lemmas(
+  std::size_t node,
+  const exprt &index,
+  std::size_t position)
+{
+  const auto index_value = get_index_value(index);
+  const exprt array = arrays[node];
+  const typet &subtype = array.type().subtype();
+  const index_exprt read(array, index, subtype);
+  const exprt read_value = get_converted_value(read);
+
+  // not used in the formula
+  if(!index_value.has_value() || read_value.is_nil())
+    return false;
+
+  bool added = false;
+
+  weak_equivalence_patht parents(weak_equivalence_graph.size());
+  std::vector<bool> visited(weak_equivalence_graph.size(), false);
+  std::vector<std::size_t> queue{node};
+  visited[node] = true;
+
+  for(std::size_t head = 0; head < queue.size(); ++head)
+  {
+    const std::size_t current = queue[head];
+    const exprt term = arrays[current];
+
+    // other reads of the same index value
+    if(current >= node)
+    {
+      const index_sett &index_set = index_map[current];
+      const std::vector<exprt> others(index_set.begin(), index_set.end());
+
+      for(std::size_t other = current == node ? position + 1 : 0;
+          other < others.size();
+          ++other)
+      {
+        if(get_index_value(others[other]) != index_value)
+          continue;
+
+        const index_exprt other_read(term, others[other], subtype);
+        const exprt other_value = get_converted_value(other_read);
+
+        if(other_value.is_nil() || same_value(read_value, other_value))
+          continue;
+
+        const equal_exprt same_index(
+          index,
+          typecast_exprt::conditional_cast(others[other], index.type()));
+
+        if(add_weak_equivalence_lemma(
+             parents, node, current, index, same_index, read, other_read))
+        {
+          added = true;
+        }
+      }
+    }
+
+    // the definition of the element at the index value, if any, holds
+    // under the given premise
+    exprt premise = true_exprt();
+    exprt definition = nil_exprt();
+
+    if(term.id() == ID_array_of)
+    {
+      definition = to_array_of_expr(term).what();
+    }
+    else if(term.id() == ID_array)
+    {
+      const exprt::operandst &operands = term.operands();
+
+      // out-of-bounds accesses are left unconstrained
+      if(*index_value >= 0 && *index_value < operands.size())
+      {
+        premise = equal_exprt(index, from_integer(*index_value, index.type()));
+        definition = operands[numeric_cast_v<std::size_t>(*index_value)];
+      }
+    }
+    else if(term.id() == ID_array_comprehension)
+    {
+      const array_comprehension_exprt &comprehension =
+        to_array_comprehension_expr(term);
+      exprt body = comprehension.body();
+      replace_expr(comprehension.arg(), index, body);
+      definition = body;
+    }
+    else if(term.id() == ID_with)
+    {
+      // the last update wins
+      const exprt::operandst &operands = term.operands();
+      for(std::size_t i = 1; i + 1 < operands.size(); i += 2)
+      {
+        if(get_index_value(operands[i]) == index_value)
+        {
+          premise = equal_exprt(
+            index, typecast_exprt::conditional_cast(operands[i], index.type()));
+          definition = operands[i + 1];
+        }
+      }
+    }
+
+    if(definition.is_not_nil())
+    {
+      const exprt model_value =
+        definition.is_constant() ? definition : get_converted_value(definition);
+
+      if(
+        !same_value(read_value, model_value) &&
+        add_weak_equivalence_lemma(
+          parents, node, current, index, premise, read, definition))
+      {
+        added = true;
+      }
+    }
+
+    // follow the edges that are active in the model and do not update
+    // the index value
+    const auto &edges = weak_equivalence_graph[current];
+    for(std::size_t e = 0; e < edges.size(); ++e)
+    {
+      const weak_equivalence_edget &edge = edges[e];
+
+      if(visited[edge.target] || !l_get(edge.guard).is_true())
+        continue;
+
+      bool updated = false;
+      for(const auto &store_value : edge.store_values)
+      {
+        if(!store_value.has_value() || *store_value == *index_value)
+          updated = true;
+      }
+
+      if(updated)
+        continue;
+
+      visited[edge.target] = true;
+      parents[edge.target] = {current, e};
+      queue.push_back(edge.target);
+    }
+  }
+
+  return added;
+}
+
+/// Adds the lemma that \p read equals \p value when \p premise holds and
+/// all edges on the path from \p node to \p target (given by \p parents)
+/// are active and do not update \p index.
+/// \return true iff the lemma had not been added before
+bool arrayst::add_weak_equivalence_lemma(
+  const weak_equivalence_patht &parents,
+  std::size_t node,
+  std::size_t target,
+  const exprt &index,
+  const exprt &premise,
+  const exprt &read,
+  const exprt &value)
+{
+  exprt::operandst conjuncts;
+
+  if(!premise.is_true())
+    conjuncts.push_back(premise);
+
+  for(std::size_t current = target; current != node;
+      current = parents[current].first)
+  {
+    const weak_equivalence_edget &edge =
+      weak_equivalence_graph[parents[current].first][parents[current].second];
+
+    if(!edge.guard.is_true())
+      conjuncts.push_back(literal_exprt(edge.guard));
+
+    for(const auto &store : edge.stores)
+    {
+      conjuncts.push_back(notequal_exprt(
+        index, typecast_exprt::conditional_cast(store, index.type())));
+    }
+  }
+
+  const implies_exprt lemma(
+    conjunction(conjuncts),
+    equal_exprt(read, typecast_exprt::conditional_cast(value, read.type())));
+
+  if(!weak_equivalence_lemmas.insert(lemma).second)
+    return false;
+
+  prop.l_set_to_true(convert(lemma));
+  array_constraint_count[constraint_typet::ARRAY_WEAK_EQUIVALENCE]++;
+
+  return true;
+}
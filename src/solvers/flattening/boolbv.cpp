@@ -596,6 +596,31 @@ void boolbvt::print_assignment(std::ostream &out) const
   map.show(out);
 }
 
+void boolbvt::report_byte_operator_lowering()
+{
+  const byte_operator_lowering_cachet &cache = byte_operator_lowering_cache;
+
+  if(cache.runtime.count() == 0)
+    return;
+
+  log.status() << "Runtime Lowering byte operators: " << cache.runtime.count()
+               << "s" << messaget::eom;
+  log.statistics() << "Byte operator lowering cache: " << cache.hits
+                   << " hits, " << cache.misses << " misses" << messaget::eom;
+}
+
+void boolbvt::report_constant_propagation()
+{
+  const bv_utilst::avoided_gatest &avoided = bv_utils.get_avoided_gates();
+
+  if(avoided.variables == 0 && pruned_if_cases == 0)
+    return;
+
+  log.statistics() << "Constant propagation: avoided " << avoided.variables
+                   << " variables, " << avoided.clauses << " clauses, "
+                   << pruned_if_cases << " if-cases" << messaget::eom;
+}
+
 boolbvt::offset_mapt boolbvt::build_offset_map(const struct_typet &src)
 {
   const struct_typet::componentst &components = src.components();
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/mp_arith.h>
 #include <util/optional.h>
 
+#include <solvers/lowering/expr_lowering.h>
 #include <solvers/lowering/functions.h>
 
 #include "bv_utils.h"
@@ -80,11 +81,25 @@ public:
     post_process_quantifiers();
     functions.post_process();
     SUB::post_process();
+    report_byte_operator_lowering();
+    report_constant_propagation();
   }
 
   enum class unbounded_arrayt { U_NONE, U_ALL, U_AUTO };
   unbounded_arrayt unbounded_array;
 
+  /// Select the encodings of multiplication and division of operands with
+  /// at least \p min_width bits
+  void set_arithmetic_encodings(
+    bv_utilst::multipliert multiplier,
+    bv_utilst::dividert divider,
+    std::size_t min_width)
+  {
+    bv_utils.set_multiplier(multiplier);
+    bv_utils.set_divider(divider);
+    bv_utils.set_encoding_min_width(min_width);
+  }
+
   mp_integer get_value(const bvt &bv)
   {
     return get_value(bv, 0, bv.size());
@@ -117,6 +132,21 @@ protected:
   // uninterpreted functions
   functionst functions;
 
+  // lowered byte operators, shared by all conversions
+  byte_operator_lowering_cachet byte_operator_lowering_cache;
+
+  /// Reports the time spent lowering byte operators and the effectiveness of
+  /// \ref byte_operator_lowering_cache
+  void report_byte_operator_lowering();
+
+  // if-expressions with a constant condition, of which only the selected
+  // case has been converted
+  std::size_t pruned_if_cases = 0;
+
+  /// Reports the gates that constant propagation during bit-blasting has
+  /// made unnecessary
+  void report_constant_propagation();
+
   // the mapping from identifiers to literals
   boolbv_mapt map;
 
@@ -250,6 +280,7 @@ protected:
 
   // unbounded arrays
   bool is_unbounded_array(const typet &type) const override;
+  exprt get_converted_value(const exprt &expr) const override;
 
   // quantifier instantiations
   class quantifiert
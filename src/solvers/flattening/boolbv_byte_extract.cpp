@@ -38,7 +38,8 @@ bvt boolbvt::convert_byte_extract(const byte_extract_exprt &expr)
   // unbounded arrays
   if(is_unbounded_array(expr.op().type()))
   {
-    return convert_bv(lower_byte_extract(expr, ns));
+    return convert_bv(
+      lower_byte_extract(expr, ns, byte_operator_lowering_cache));
   }
 
   const std::size_t width = boolbv_width(expr.type());
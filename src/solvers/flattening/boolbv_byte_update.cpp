@@ -22,7 +22,8 @@ bvt boolbvt::convert_byte_update(const byte_update_exprt &expr)
     is_unbounded_array(expr.op().type()) ||
     is_unbounded_array(expr.value().type()))
   {
-    return convert_bv(lower_byte_update(expr, ns));
+    return convert_bv(
+      lower_byte_update(expr, ns, byte_operator_lowering_cache));
   }
 
   const exprt &op = expr.op();
@@ -29,8 +29,8 @@ literalt boolbvt::convert_equality(const equal_exprt &expr)
 
     if(has_byte_operator(expr))
     {
-      return record_array_equality(
-        to_equal_expr(lower_byte_operators(expr, ns)));
+      return record_array_equality(to_equal_expr(
+        lower_byte_operators(expr, ns, byte_operator_lowering_cache)));
     }
 
     return record_array_equality(expr);
@@ -276,6 +276,27 @@ exprt boolbvt::bv_get_cache(const exprt &expr) const
   return bv_get(it->second, expr.type());
 }
 
+exprt boolbvt::get_converted_value(const exprt &expr) const
+{
+  if(expr.type().id() == ID_bool)
+  {
+    const auto value = get_bool(expr);
+
+    if(!value.has_value())
+      return nil_exprt();
+
+    return *value ? static_cast<exprt>(true_exprt())
+                  : static_cast<exprt>(false_exprt());
+  }
+
+  bv_cachet::const_iterator it = bv_cache.find(expr);
+
+  if(it == bv_cache.end())
+    return nil_exprt();
+
+  return bv_get(it->second, expr.type());
+}
+
 exprt boolbvt::bv_get_unbounded_array(const exprt &expr) const
 {
   // first, try to get size
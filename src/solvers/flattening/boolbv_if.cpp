@@ -18,6 +18,14 @@ bvt boolbvt::convert_if(const if_exprt &expr)
 
   literalt cond=convert(expr.cond());
 
+  // the other case does not need to be converted at all
+  if(cond.is_constant())
+  {
+    ++pruned_if_cases;
+    return convert_bv(
+      cond.is_true() ? expr.true_case() : expr.false_case(), width);
+  }
+
   bv_utils.push_control_dep(cond);
 
   const bvt &true_case_bv = convert_bv(expr.true_case(), width);
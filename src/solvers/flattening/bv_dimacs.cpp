@@ -18,6 +18,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 bool bv_dimacst::write_dimacs()
 {
+  if(out != nullptr)
+    return write_dimacs(*out);
+
   if(filename.empty() || filename == "-")
     return write_dimacs(std::cout);
 
@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_FLATTENING_BV_DIMACS_H
 #define CPROVER_SOLVERS_FLATTENING_BV_DIMACS_H
 
+#include <iosfwd>
+
 #include "bv_pointers.h"
 
 class bv_dimacst : public bv_pointerst
@@ -26,6 +28,17 @@ public:
   {
   }
 
+  /// Writes to \p _out, which is the stream that \p _prop writes its clauses
+  /// to if it is a dimacs_cnf_streamt
+  bv_dimacst(
+    const namespacet &_ns,
+    propt &_prop,
+    message_handlert &message_handler,
+    std::ostream &_out)
+    : bv_pointerst(_ns, _prop, message_handler), out(&_out)
+  {
+  }
+
   virtual ~bv_dimacst()
   {
     write_dimacs();
@@ -33,6 +46,7 @@ public:
 
 protected:
   const std::string filename;
+  std::ostream *out = nullptr;
   bool write_dimacs();
   bool write_dimacs(std::ostream &);
 };
@@ -95,7 +95,7 @@ std::size_t bv_pointerst::bv_pointers_widtht::get_object_width(
 {
   // not actually type-dependent for now
   (void)type;
-  return config.bv_encoding.object_bits;
+  return object_width;
 }
 
 std::size_t bv_pointerst::bv_pointers_widtht::get_offset_width(
@@ -187,10 +187,72 @@ bv_pointerst::bv_pointerst(
   bool get_array_constraints)
   : boolbvt(_ns, _prop, message_handler, get_array_constraints),
     pointer_logic(_ns),
-    bv_pointers_width(_ns)
+    bv_pointers_width(_ns, config.bv_encoding.object_bits)
 {
 }
 
+void bv_pointerst::number_objects(const exprt &expr)
+{
+  expr.visit_pre([this](const exprt &e) {
+    if(e.id() == ID_address_of)
+      number_objects_rec(to_address_of_expr(e).object());
+    else if(e.id() == ID_object_address)
+      pointer_logic.add_object(to_object_address_expr(e).object_expr());
+  });
+}
+
+void bv_pointerst::number_objects_rec(const exprt &expr)
+{
+  if(
+    expr.id() == ID_symbol || expr.id() == ID_label ||
+    expr.id() == ID_constant || expr.id() == ID_string_constant ||
+    expr.id() == ID_array)
+  {
+    pointer_logic.add_object(expr);
+  }
+  else if(expr.id() == ID_index)
+  {
+    const exprt &array = to_index_expr(expr).array();
+    if(array.type().id() != ID_pointer)
+      number_objects_rec(array);
+  }
+  else if(
+    expr.id() == ID_byte_extract_little_endian ||
+    expr.id() == ID_byte_extract_big_endian)
+  {
+    number_objects_rec(to_byte_extract_expr(expr).op());
+  }
+  else if(expr.id() == ID_member)
+  {
+    number_objects_rec(to_member_expr(expr).compound());
+  }
+  else if(expr.id() == ID_if)
+  {
+    number_objects_rec(to_if_expr(expr).true_case());
+    number_objects_rec(to_if_expr(expr).false_case());
+  }
+}
+
+std::size_t bv_pointerst::set_object_bits_from_objects()
+{
+  PRECONDITION(bv_cache.empty());
+
+  const std::size_t object_bits = address_bits(pointer_logic.objects.size());
+
+  if(object_bits >= config.ansi_c.pointer_width)
+  {
+    throw analysis_exceptiont(
+      "too many addressed objects: " +
+      std::to_string(pointer_logic.objects.size()) +
+      " objects cannot be encoded in pointers of width " +
+      std::to_string(config.ansi_c.pointer_width));
+  }
+
+  bv_pointers_width.object_width = object_bits;
+
+  return object_bits;
+}
+
 optionalt<bvt> bv_pointerst::convert_address_of_rec(const exprt &expr)
 {
   if(expr.id()==ID_symbol)
@@ -34,13 +34,25 @@ public:
   endianness_mapt
   endianness_map(const typet &type, bool little_endian) const override;
 
+  /// Number the objects whose address is taken in \p expr, as converting
+  /// \p expr would do
+  void number_objects(const exprt &expr);
+
+  /// Set the number of bits encoding the object part of pointers to the
+  /// least number that can encode all objects numbered so far, rather than
+  /// the configured `object_bits`. Must be called before any expression is
+  /// converted.
+  /// \return the number of object bits
+  std::size_t set_object_bits_from_objects();
+
 protected:
   pointer_logict pointer_logic;
 
   class bv_pointers_widtht : public boolbv_widtht
   {
   public:
-    explicit bv_pointers_widtht(const namespacet &_ns) : boolbv_widtht(_ns)
+    bv_pointers_widtht(const namespacet &_ns, std::size_t _object_width)
+      : boolbv_widtht(_ns), object_width(_object_width)
     {
     }
 
@@ -49,6 +61,9 @@ protected:
     std::size_t get_object_width(const pointer_typet &type) const;
     std::size_t get_offset_width(const pointer_typet &type) const;
     std::size_t get_address_width(const pointer_typet &type) const;
+
+    // the number of bits encoding the object part of any pointer
+    std::size_t object_width;
   };
   bv_pointers_widtht bv_pointers_width;
 
@@ -76,6 +91,9 @@ protected:
   NODISCARD
   optionalt<bvt> convert_address_of_rec(const exprt &expr);
 
+  /// Number the objects that \ref convert_address_of_rec adds for \p expr
+  void number_objects_rec(const exprt &expr);
+
   NODISCARD
   bvt offset_arithmetic(
     const pointer_typet &type,
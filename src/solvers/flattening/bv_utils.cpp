@@ -8,6 +8,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "bv_utils.h"
 
+#include <algorithm>
+#include <iterator>
+
 bvt bv_utilst::build_constant(const mp_integer &n, std::size_t width)
 {
   std::string n_str=integer2binary(n, width);
@@ -180,6 +183,26 @@ literalt bv_utilst::full_adder(
       carry_out = prop.land(x, y);
       sum = prop.lxor(x, y);
     }
+    // two of the inputs are the same or complementary: the carry is
+    // then one of the inputs, and the sum the third one or its negation
+    else if(a == b || a == !b)
+    {
+      carry_out = a == b ? a : carry_in;
+      sum = a == b ? carry_in : !carry_in;
+      avoid_gates(2, 14);
+    }
+    else if(a == carry_in || a == !carry_in)
+    {
+      carry_out = a == carry_in ? a : b;
+      sum = a == carry_in ? b : !b;
+      avoid_gates(2, 14);
+    }
+    else if(b == carry_in || b == !carry_in)
+    {
+      carry_out = b == carry_in ? b : a;
+      sum = b == carry_in ? a : !a;
+      avoid_gates(2, 14);
+    }
     else
     {
       carry_out = prop.new_variable();
@@ -248,6 +271,23 @@ literalt bv_utilst::carry(literalt a, literalt b, literalt c)
     else if(b==c)
       return b;
 
+    // the majority of x, !x and y is y
+    if(a == !b)
+    {
+      avoid_gates(1, 6);
+      return c;
+    }
+    else if(a == !c)
+    {
+      avoid_gates(1, 6);
+      return b;
+    }
+    else if(b == !c)
+    {
+      avoid_gates(1, 6);
+      return a;
+    }
+
     // the below yields fewer clauses and variables,
     // but doesn't propagate anything at all
 
@@ -313,14 +353,66 @@ literalt bv_utilst::carry_out(
 {
   PRECONDITION(op0.size() == op1.size());
 
+  // The carry out of a position with two equal operand bits is that bit,
+  // whatever the carry into it. The carries below the most significant
+  // such position do not matter.
+  std::size_t start = 0;
   literalt carry_out=carry_in;
 
-  for(std::size_t i=0; i<op0.size(); i++)
+  for(std::size_t i = op0.size(); i-- > 0;)
+  {
+    if(op0[i] == op1[i])
+    {
+      avoid_carries(op0, op1, carry_in, i);
+      start = i + 1;
+      carry_out = op0[i];
+      break;
+    }
+  }
+
+  for(std::size_t i = start; i < op0.size(); i++)
     carry_out=carry(op0[i], op1[i], carry_out);
 
   return carry_out;
 }
 
+/// Records the carry gates of the \p width least significant positions of
+/// the sum of \p op0, \p op1 and \p carry_in as avoided, following the
+/// constant propagation that \ref carry would have done
+void bv_utilst::avoid_carries(
+  const bvt &op0,
+  const bvt &op1,
+  literalt carry_in,
+  std::size_t width)
+{
+  // the output of a new gate, which is equal to no other literal
+  const literalt gate_output;
+  literalt carry_out = carry_in;
+
+  for(std::size_t i = 0; i < width; i++)
+  {
+    const literalt a = op0[i], b = op1[i], c = carry_out;
+
+    if(a.is_constant() && b.is_constant())
+      carry_out = a == b ? a : c;
+    else if(a.is_constant() && c.is_constant())
+      carry_out = a == c ? a : b;
+    else if(b.is_constant() && c.is_constant())
+      carry_out = b == c ? b : a;
+    else if(a == b || a == c)
+      carry_out = a;
+    else if(b == c)
+      carry_out = b;
+    else if(a == !b || a == !c || b == !c)
+      carry_out = a == !b ? c : a == !c ? b : a;
+    else
+    {
+      avoid_gates(1, 6);
+      carry_out = gate_output;
+    }
+  }
+}
+
 bvt bv_utilst::add_sub_no_overflow(
   const bvt &op0,
   const bvt &op1,
@@ -628,14 +720,122 @@ bvt bv_utilst::wallace_tree(const std::vector<bvt> &pps)
   }
 }
 
-bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
+bvt bv_utilst::dadda_tree(const std::vector<bvt> &pps)
 {
-  #if 1
-  bvt op0=_op0, op1=_op1;
+  PRECONDITION(!pps.empty());
 
-  if(is_constant(op1))
-    std::swap(op0, op1);
+  const std::size_t width = pps.front().size();
+
+  // the bits of each weight, leaving out constant zeros
+  std::vector<bvt> columns(width);
+
+  for(const auto &pp : pps)
+  {
+    INVARIANT(pp.size() == width, "partial products should be of equal size");
+
+    for(std::size_t bit = 0; bit < width; bit++)
+      if(!pp[bit].is_false())
+        columns[bit].push_back(pp[bit]);
+  }
+
+  auto max_height = [&columns]() {
+    std::size_t result = 0;
+    for(const auto &column : columns)
+      result = std::max(result, column.size());
+    return result;
+  };
+
+  // Each stage reduces all columns to the largest number of Dadda's sequence
+  // 2, 3, 4, 6, 9, 13, ... below the current maximum height, using as few
+  // full and half adders as possible. Carries out of the most significant
+  // column are dropped.
+  for(std::size_t height = max_height(); height > 2; height = max_height())
+  {
+    std::size_t target = 2;
+    while(target * 3 / 2 < height)
+      target = target * 3 / 2;
+
+    for(std::size_t bit = 0; bit < width; bit++)
+    {
+      const bvt in = std::move(columns[bit]);
+      bvt out;
+      std::size_t next = 0;
+
+      while(true)
+      {
+        const std::size_t remaining = in.size() - next;
+        const std::size_t column_height = remaining + out.size();
+
+        if(column_height <= target || remaining < 2)
+          break;
+
+        literalt sum, carry;
+
+        if(column_height == target + 1 || remaining == 2)
+        {
+          sum = prop.lxor(in[next], in[next + 1]);
+          carry = prop.land(in[next], in[next + 1]);
+          next += 2;
+        }
+        else
+        {
+          sum = full_adder(in[next], in[next + 1], in[next + 2], carry);
+          next += 3;
+        }
+
+        out.push_back(sum);
+        if(bit + 1 < width)
+          columns[bit + 1].push_back(carry);
+      }
 
+      out.insert(out.end(), in.begin() + next, in.end());
+      columns[bit] = std::move(out);
+    }
+  }
+
+  bvt a = zeros(width), b = zeros(width);
+
+  for(std::size_t bit = 0; bit < width; bit++)
+  {
+    if(!columns[bit].empty())
+      a[bit] = columns[bit][0];
+    if(columns[bit].size() == 2)
+      b[bit] = columns[bit][1];
+  }
+
+  return add(a, b);
+}
+
+/// The shifted partial products of \p op1 for the bits of \p op0 that are
+/// not constant zero, truncated to the width of \p op0
+std::vector<bvt>
+bv_utilst::partial_products(const bvt &op0, const bvt &op1)
+{
+  std::vector<bvt> pps;
+  pps.reserve(op0.size());
+
+  for(std::size_t bit=0; bit<op0.size(); bit++)
+    if(op0[bit]!=const_literal(false))
+    {
+      bvt pp;
+
+      pp.reserve(op0.size());
+
+      // zeros according to weight
+      for(std::size_t idx=0; idx<bit; idx++)
+        pp.push_back(const_literal(false));
+
+      for(std::size_t idx=bit; idx<op0.size(); idx++)
+        pp.push_back(prop.land(op1[idx-bit], op0[bit]));
+
+      pps.push_back(pp);
+    }
+
+  return pps;
+}
+
+bvt bv_utilst::shift_add_multiplier(const bvt &op0, const bvt &op1)
+{
   bvt product;
   product.resize(op0.size());
 
@@ -659,43 +859,224 @@ bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
     }
 
   return product;
-  #else
-  // Wallace tree multiplier. This is disabled, as runtimes have
-  // been observed to go up by 5%-10%, and on some models even by 20%.
-
-  // build the usual quadratic number of partial products
+}
 
-  bvt op0=_op0, op1=_op1;
+/// Radix-4 Booth multiplier: \p op1 is recoded into digits in {-2, ..., 2},
+/// each selecting a partial product of twice, once, zero or minus once or
+/// twice \p op0. The product is truncated to the width of \p op0, which makes
+/// it independent of whether the operands are signed.
+bvt bv_utilst::booth_multiplier(const bvt &op0, const bvt &op1)
+{
+  const std::size_t width = op0.size();
 
-  if(is_constant(op1))
-    std::swap(op0, op1);
+  auto op1_bit = [&op1](std::size_t i) {
+    return i < op1.size() ? op1[i] : const_literal(false);
+  };
 
   std::vector<bvt> pps;
-  pps.reserve(op0.size());
+  pps.reserve(width / 2 + 2);
 
-  for(std::size_t bit=0; bit<op0.size(); bit++)
-    if(op0[bit]!=const_literal(false))
-    {
-      bvt pp;
+  // the +1 of the two's complement of the negative partial products
+  bvt corrections = zeros(width);
 
-      pp.reserve(op0.size());
+  for(std::size_t i = 0; i < width; i += 2)
+  {
+    // the digit is -2 * high + mid + low
+    const literalt low = i == 0 ? const_literal(false) : op1_bit(i - 1);
+    const literalt mid = op1_bit(i);
+    const literalt high = op1_bit(i + 1);
 
-      // zeros according to weight
-      for(std::size_t idx=0; idx<bit; idx++)
-        pp.push_back(const_literal(false));
+    const literalt one = prop.lxor(mid, low);
+    const literalt two = prop.lselect(
+      high, prop.land(!mid, !low), prop.land(mid, low));
+    const literalt negative = prop.land(high, !prop.land(mid, low));
 
-      for(std::size_t idx=bit; idx<op0.size(); idx++)
-        pp.push_back(prop.land(op1[idx-bit], op0[bit]));
+    if(one.is_false() && two.is_false())
+      continue;
 
-      pps.push_back(pp);
+    bvt pp = zeros(width);
+
+    for(std::size_t j = i; j < width; j++)
+    {
+      const literalt magnitude = prop.lor(
+        prop.land(one, op0[j - i]),
+        j == i ? const_literal(false) : prop.land(two, op0[j - i - 1]));
+      pp[j] = prop.lxor(magnitude, negative);
     }
 
+    pps.push_back(pp);
+    corrections[i] = negative;
+  }
+
   if(pps.empty())
-    return zeros(op0.size());
+    return zeros(width);
+
+  pps.push_back(corrections);
+
+  return dadda_tree(pps);
+}
+
+/// Karatsuba multiplication is only applied to operands of at least this
+/// width; narrower ones use a Dadda tree
+#define KARATSUBA_MIN_WIDTH 16
+
+bvt bv_utilst::karatsuba_full_product(const bvt &op0, const bvt &op1)
+{
+  PRECONDITION(op0.size() == op1.size());
+
+  const std::size_t width = op0.size();
+
+  if(width < KARATSUBA_MIN_WIDTH)
+  {
+    const bvt ext0 = zero_extension(op0, width * 2);
+    std::vector<bvt> pps =
+      partial_products(ext0, zero_extension(op1, width * 2));
+    return pps.empty() ? zeros(width * 2) : dadda_tree(pps);
+  }
+
+  // op = x1 * 2^low_width + x0
+  const std::size_t low_width = width / 2;
+  const std::size_t high_width = width - low_width;
+
+  const bvt x0 = extract_lsb(op0, low_width), x1 = extract_msb(op0, high_width);
+  const bvt y0 = extract_lsb(op1, low_width), y1 = extract_msb(op1, high_width);
+
+  const bvt z0 = karatsuba_full_product(x0, y0);
+  const bvt z2 = karatsuba_full_product(x1, y1);
+
+  // (x0 + x1) * (y0 + y1) - z0 - z2 = x0 * y1 + x1 * y0
+  const bvt z1 = karatsuba_full_product(
+    add(zero_extension(x0, high_width + 1), zero_extension(x1, high_width + 1)),
+    add(
+      zero_extension(y0, high_width + 1), zero_extension(y1, high_width + 1)));
+
+  const bvt middle = sub(
+    sub(z1, zero_extension(z0, z1.size())), zero_extension(z2, z1.size()));
+
+  // z0 and z2 * 2^(2 * low_width) do not overlap
+  const bvt outer = concatenate(z0, z2);
+
+  bvt shifted_middle = concatenate(zeros(low_width), middle);
+  shifted_middle.resize(width * 2, const_literal(false));
+
+  return add(outer, shifted_middle);
+}
+
+bvt bv_utilst::karatsuba_multiplier(const bvt &op0, const bvt &op1)
+{
+  const std::size_t width = op0.size();
+
+  if(width < KARATSUBA_MIN_WIDTH)
+  {
+    std::vector<bvt> pps = partial_products(op0, op1);
+    return pps.empty() ? zeros(width) : dadda_tree(pps);
+  }
+
+  const std::size_t low_width = width / 2;
+  const std::size_t high_width = width - low_width;
+  const bvt y = extract_lsb(op1, width);
+
+  auto is_false = [](const literalt &l) { return l.is_false(); };
+  const bvt x1 = extract_msb(op0, high_width), y1 = extract_msb(y, high_width);
+
+  // zero-extended operands, as in overflow checks, need just the product of
+  // their lower halves
+  bvt product =
+    std::all_of(x1.begin(), x1.end(), is_false) &&
+        std::all_of(y1.begin(), y1.end(), is_false)
+      ? karatsuba_full_product(
+          extract_lsb(op0, low_width), extract_lsb(y, low_width))
+      : karatsuba_full_product(op0, y);
+
+  product.resize(width, const_literal(false));
+  return product;
+}
+
+bvt bv_utilst::constant_multiplier(const bvt &op, const bvt &constant)
+{
+  PRECONDITION(is_constant(constant));
+
+  const std::size_t width = op.size();
+
+  // The non-adjacent form writes the constant as sum of d_i * 2^i with
+  // d_i in {-1, 0, 1} and no two adjacent non-zero digits; it has at most as
+  // many non-zero digits as the binary representation. The product is the
+  // sum of the correspondingly shifted and possibly negated operand.
+  std::vector<std::size_t> added, subtracted;
+  bool carry = false;
+
+  for(std::size_t i = 0; i < width; i++)
+  {
+    const bool bit = i < constant.size() && constant[i].is_true();
+    const bool next_bit = i + 1 < constant.size() && constant[i + 1].is_true();
+
+    if(bit != carry)
+    {
+      // an odd remaining value: ...11 becomes -1 with a carry
+      if(next_bit && i + 1 < width)
+        subtracted.push_back(i);
+      else
+        added.push_back(i);
+      carry = next_bit && i + 1 < width;
+    }
+  }
+
+  bvt product;
+
+  if(added.empty())
+    product = zeros(width);
   else
-    return wallace_tree(pps);
+  {
+    product = shift(op, shiftt::SHIFT_LEFT, added.front());
+    for(auto it = std::next(added.begin()); it != added.end(); ++it)
+      product = add(product, shift(op, shiftt::SHIFT_LEFT, *it));
+  }
 
-  #endif
+  for(const auto distance : subtracted)
+    product = sub(product, shift(op, shiftt::SHIFT_LEFT, distance));
+
+  return product;
+}
+
+bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
+{
+  bvt op0=_op0, op1=_op1;
+
+  if(is_constant(op1))
+    std::swap(op0, op1);
+
+  if(op0.size() < encoding_min_width)
+    return shift_add_multiplier(op0, op1);
+
+  if(is_constant(op0) && multiplier_encoding != multipliert::SHIFT_ADD)
+    return constant_multiplier(op1, op0);
+
+  switch(multiplier_encoding)
+  {
+  case multipliert::SHIFT_ADD:
+    return shift_add_multiplier(op0, op1);
+
+  case multipliert::WALLACE:
+  case multipliert::DADDA:
+  {
+    std::vector<bvt> pps = partial_products(op0, op1);
+
+    if(pps.empty())
+      return zeros(op0.size());
+    else if(multiplier_encoding == multipliert::WALLACE)
+      return wallace_tree(pps);
+    else
+      return dadda_tree(pps);
+  }
+
+  case multipliert::BOOTH_RADIX4:
+    return booth_multiplier(op0, op1);
+
+  case multipliert::KARATSUBA:
+    return karatsuba_multiplier(op0, op1);
+  }
+
+  UNREACHABLE;
 }
 
 bvt bv_utilst::unsigned_multiplier_no_overflow(
@@ -742,6 +1123,15 @@ bvt bv_utilst::signed_multiplier(const bvt &op0, const bvt &op1)
   if(op0.empty() || op1.empty())
     return bvt();
 
+  // The truncated product does not depend on the signedness of the
+  // operands; only the default encoding multiplies their absolute values.
+  if(
+    multiplier_encoding != multipliert::SHIFT_ADD &&
+    op0.size() >= encoding_min_width)
+  {
+    return unsigned_multiplier(op0, op1);
+  }
+
   literalt sign0=op0[op0.size()-1];
   literalt sign1=op1[op1.size()-1];
 
@@ -894,6 +1284,14 @@ void bv_utilst::unsigned_divider(
 {
   std::size_t width=op0.size();
 
+  if(
+    divider_encoding == dividert::NON_RESTORING &&
+    width >= encoding_min_width)
+  {
+    non_restoring_divider(op0, op1, res, rem);
+    return;
+  }
+
   // check if we divide by a power of two
   #if 0
   {
@@ -965,6 +1363,47 @@ void bv_utilst::unsigned_divider(
       is_not_zero, lt_or_le(true, res, op0, representationt::UNSIGNED)));
 }
 
+/// Non-restoring division: in each step, the partial remainder is shifted
+/// left by one bit of the dividend, and then the divisor is subtracted from
+/// it if it is non-negative, and added to it otherwise. A negative final
+/// remainder is restored by adding the divisor once more.
+void bv_utilst::non_restoring_divider(
+  const bvt &op0,
+  const bvt &op1,
+  bvt &res,
+  bvt &rem)
+{
+  PRECONDITION(op0.size() == op1.size());
+
+  const std::size_t width = op0.size();
+
+  // the partial remainder is in [-op1, op1), which needs a sign bit
+  const bvt divisor = zero_extension(op1, width + 1);
+  bvt remainder = zeros(width + 1);
+  bvt quotient = zeros(width);
+
+  for(std::size_t i = width; i > 0; i--)
+  {
+    const literalt negative = sign_bit(remainder);
+
+    remainder.pop_back();
+    remainder.insert(remainder.begin(), op0[i - 1]);
+    remainder = add_sub(remainder, divisor, !negative);
+
+    quotient[i - 1] = !sign_bit(remainder);
+  }
+
+  remainder = select(
+    sign_bit(remainder), add(remainder, divisor), remainder);
+  remainder.pop_back();
+
+  // keep the result of a division by zero non-deterministic, as above
+  const literalt is_zero = this->is_zero(op1);
+
+  res = select(is_zero, prop.new_variables(width), quotient);
+  rem = select(is_zero, prop.new_variables(width), remainder);
+}
+
 
 #ifdef COMPACT_EQUAL_CONST
 // TODO : use for lt_or_le as well
@@ -1115,6 +1554,26 @@ literalt bv_utilst::equal(const bvt &op0, const bvt &op1)
     return equal_const(op0, op1);
   #endif
 
+  // complementary bits, in particular differing constants, decide the
+  // result before any of the gates comparing the other bits are built
+  for(std::size_t i = 0; i < op0.size(); i++)
+  {
+    if(op0[i] == !op1[i])
+    {
+      for(std::size_t j = 0; j < op0.size(); j++)
+      {
+        if(
+          !op0[j].is_constant() && !op1[j].is_constant() &&
+          op0[j].var_no() != op1[j].var_no())
+        {
+          avoid_gates(1, 4);
+        }
+      }
+
+      return const_literal(false);
+    }
+  }
+
   bvt equal_bv;
   equal_bv.resize(op0.size());
 
@@ -27,6 +27,63 @@ public:
 
   enum class representationt { SIGNED, UNSIGNED };
 
+  /// Encodings of the product of two non-constant bit-vectors
+  enum class multipliert
+  {
+    /// add one shifted partial product at a time
+    SHIFT_ADD,
+    /// carry-save adder tree over the partial products; not the default, as
+    /// runtimes have been observed to go up by 5%-10%, and on some models
+    /// even by 20%
+    WALLACE,
+    /// column-wise Dadda reduction of the partial products
+    DADDA,
+    /// radix-4 Booth recoding, which halves the number of partial products
+    BOOTH_RADIX4,
+    /// split wide operands into halves, using Dadda trees for narrow ones
+    KARATSUBA
+  };
+
+  /// Encodings of division and remainder
+  enum class dividert
+  {
+    /// fresh variables for quotient and remainder, constrained by a
+    /// multiplication
+    CONSTRAINTS,
+    /// an array of add-or-subtract stages
+    NON_RESTORING
+  };
+
+  void set_multiplier(multipliert encoding)
+  {
+    multiplier_encoding = encoding;
+  }
+
+  void set_divider(dividert encoding)
+  {
+    divider_encoding = encoding;
+  }
+
+  /// Operands narrower than \p width use the default encodings
+  void set_encoding_min_width(std::size_t width)
+  {
+    encoding_min_width = width;
+  }
+
+  /// Gates that were not created because their outputs were already
+  /// determined by constant or shared input literals, counted with the
+  /// variables and clauses their general encoding would have used
+  struct avoided_gatest
+  {
+    std::size_t variables = 0;
+    std::size_t clauses = 0;
+  };
+
+  const avoided_gatest &get_avoided_gates() const
+  {
+    return avoided_gates;
+  }
+
   static bvt build_constant(const mp_integer &i, std::size_t width);
 
   bvt incrementer(const bvt &op, literalt carry_in);
@@ -114,6 +171,10 @@ public:
     bvt &res,
     bvt &rem);
 
+  // multiplication by a constant, using its non-adjacent form; used with
+  // all encodings but shift-and-add
+  bvt constant_multiplier(const bvt &op, const bvt &constant);
+
   #ifdef COMPACT_EQUAL_CONST
   typedef std::set<bvt> equal_const_registeredt;
   equal_const_registeredt equal_const_registered;
@@ -229,6 +290,24 @@ public:
 protected:
   propt &prop;
 
+  multipliert multiplier_encoding = multipliert::SHIFT_ADD;
+  dividert divider_encoding = dividert::CONSTRAINTS;
+  std::size_t encoding_min_width = 0;
+
+  avoided_gatest avoided_gates;
+
+  void avoid_gates(std::size_t variables, std::size_t clauses)
+  {
+    avoided_gates.variables += variables;
+    avoided_gates.clauses += clauses;
+  }
+
+  void avoid_carries(
+    const bvt &op0,
+    const bvt &op1,
+    literalt carry_in,
+    std::size_t width);
+
   void adder(
     bvt &sum,
     const bvt &op,
@@ -252,6 +331,21 @@ protected:
   bvt cond_negate_no_overflow(const bvt &bv, const literalt cond);
 
   bvt wallace_tree(const std::vector<bvt> &pps);
+  bvt dadda_tree(const std::vector<bvt> &pps);
+
+  std::vector<bvt> partial_products(const bvt &op0, const bvt &op1);
+  bvt shift_add_multiplier(const bvt &op0, const bvt &op1);
+  bvt booth_multiplier(const bvt &op0, const bvt &op1);
+  bvt karatsuba_multiplier(const bvt &op0, const bvt &op1);
+
+  // the product of two operands of equal width, with twice their width
+  bvt karatsuba_full_product(const bvt &op0, const bvt &op1);
+
+  void non_restoring_divider(
+    const bvt &op0,
+    const bvt &op1,
+    bvt &res,
+    bvt &rem);
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_BV_UTILS_H
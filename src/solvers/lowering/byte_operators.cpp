@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/expr_util.h>
 #include <util/namespace.h>
 #include <util/pointer_offset_size.h>
+#include <util/replace_expr.h>
 #include <util/simplify_expr.h>
 #include <util/string_constant.h>
 
@@ -981,6 +982,134 @@ static optionalt<exprt> lower_byte_extract_complex(
     ns);
 }
 
+/// \return true iff \p a and \p b are distinct bit-vector types of the same
+///   width, such that an object of one type can be reinterpreted as the other
+static bool same_width_bitvectors(const typet &a, const typet &b)
+{
+  return a != b && can_cast_type<bitvector_typet>(a) &&
+         can_cast_type<bitvector_typet>(b) &&
+         to_bitvector_type(a).get_width() == to_bitvector_type(b).get_width();
+}
+
+/// Reinterpret the bits of \p src as an object of \p target_type, which is a
+/// bit-vector type of the same width, in the same way as \ref bv_to_expr does.
+static exprt reinterpret_bitvector(const exprt &src, const typet &target_type)
+{
+  const std::size_t width = to_bitvector_type(src.type()).get_width();
+  return typecast_exprt::conditional_cast(
+    typecast_exprt::conditional_cast(src, bv_typet{width}), target_type);
+}
+
+/// Find the member or array element of \p src that completely contains the
+/// \p size_bits bits starting at byte \p offset.
+/// \return the member or index expression and the byte offset within it, or
+///   an empty optional if no such member or element exists (including all
+///   unions, which are not descended into)
+static optionalt<std::pair<exprt, mp_integer>> aligned_subexpression(
+  const exprt &src,
+  const mp_integer &offset,
+  const mp_integer &size_bits,
+  const namespacet &ns)
+{
+  if(offset < 0)
+    return {};
+
+  const typet &type = ns.follow(src.type());
+
+  if(type.id() == ID_struct)
+  {
+    const struct_typet &struct_type = to_struct_type(type);
+
+    for(const auto &component : struct_type.components())
+    {
+      const auto component_offset =
+        member_offset(struct_type, component.get_name(), ns);
+      const auto component_bits = pointer_offset_bits(component.type(), ns);
+
+      if(
+        !component_offset.has_value() || !component_bits.has_value() ||
+        *component_bits % 8 != 0 || *component_offset > offset)
+      {
+        continue;
+      }
+
+      if((offset - *component_offset) * 8 + size_bits <= *component_bits)
+      {
+        return std::make_pair(
+          exprt{member_exprt{src, component}}, offset - *component_offset);
+      }
+    }
+  }
+  else if(type.id() == ID_array)
+  {
+    const array_typet &array_type = to_array_type(type);
+    const auto element_bits = pointer_offset_bits(array_type.subtype(), ns);
+    const auto size = numeric_cast<mp_integer>(array_type.size());
+
+    if(
+      !element_bits.has_value() || *element_bits <= 0 ||
+      *element_bits % 8 != 0 || !size.has_value())
+    {
+      return {};
+    }
+
+    const mp_integer element_bytes = *element_bits / 8;
+    const mp_integer index = offset / element_bytes;
+    const mp_integer element_offset = offset % element_bytes;
+
+    if(index < *size && element_offset * 8 + size_bits <= *element_bits)
+    {
+      return std::make_pair(
+        exprt{index_exprt{src, from_integer(index, index_type())}},
+        element_offset);
+    }
+  }
+
+  return {};
+}
+
+/// Rewrite a byte extract expression with a constant offset that selects a
+/// (possibly nested) member or array element of the same type, or a
+/// bit-vector of the same width, into member and index expressions. This
+/// avoids unpacking the object into bytes for aligned accesses, as are
+/// common with struct punning and `memcpy`.
+/// \return the member/index expression, or an empty optional if the access
+///   is not aligned with a subobject
+static optionalt<exprt>
+lower_aligned_byte_extract(const byte_extract_exprt &src, const namespacet &ns)
+{
+  const auto offset = numeric_cast<mp_integer>(src.offset());
+  const auto size_bits = pointer_offset_bits(src.type(), ns);
+
+  if(
+    !offset.has_value() || !size_bits.has_value() || *size_bits <= 0 ||
+    *size_bits % 8 != 0)
+  {
+    return {};
+  }
+
+  exprt subexpr = src.op();
+  mp_integer subexpr_offset = *offset;
+
+  while(true)
+  {
+    if(subexpr_offset == 0 && subexpr.type() == src.type())
+      return simplify_expr(subexpr, ns);
+    else if(
+      subexpr_offset == 0 && same_width_bitvectors(subexpr.type(), src.type()))
+    {
+      return simplify_expr(reinterpret_bitvector(subexpr, src.type()), ns);
+    }
+
+    auto next = aligned_subexpression(subexpr, subexpr_offset, *size_bits, ns);
+    if(!next.has_value())
+      return {};
+
+    subexpr = std::move(next->first);
+    subexpr_offset = next->second;
+  }
+}
+
 /// rewrite byte extraction from an array to byte extraction from a
 /// concatenation of array index expressions
 exprt lower_byte_extract(const byte_extract_exprt &src, const namespacet &ns)
@@ -1035,6 +1164,10 @@ exprt lower_byte_extract(const byte_extract_exprt &src, const namespacet &ns)
     src.id() == ID_byte_extract_big_endian);
   const bool little_endian = src.id() == ID_byte_extract_little_endian;
 
+  // aligned accesses to subobjects need not be unpacked into bytes
+  if(auto aligned = lower_aligned_byte_extract(src, ns))
+    return std::move(*aligned);
+
   // determine an upper bound of the last byte we might need
   auto upper_bound_opt = size_of_expr(src.type(), ns);
   if(upper_bound_opt.has_value())
@@ -2253,6 +2386,48 @@ static exprt lower_byte_update(
   }
 }
 
+/// Rewrite an update of the object \p src at constant byte \p offset by
+/// \p value, which is \p size_bits wide, into with-expressions updating a
+/// (possibly nested) member or array element of the same type, or a
+/// bit-vector of the same width. This is the counterpart of
+/// \ref lower_aligned_byte_extract.
+/// \return the updated object, or an empty optional if the update is not
+///   aligned with a subobject
+static optionalt<exprt> lower_aligned_byte_update(
+  const exprt &src,
+  const mp_integer &offset,
+  const exprt &value,
+  const mp_integer &size_bits,
+  const namespacet &ns)
+{
+  if(offset == 0 && src.type() == value.type())
+    return value;
+  else if(offset == 0 && same_width_bitvectors(value.type(), src.type()))
+    return reinterpret_bitvector(value, src.type());
+
+  const auto next = aligned_subexpression(src, offset, size_bits, ns);
+  if(!next.has_value())
+    return {};
+
+  auto updated =
+    lower_aligned_byte_update(next->first, next->second, value, size_bits, ns);
+  if(!updated.has_value())
+    return {};
+
+  if(next->first.id() == ID_member)
+  {
+    return with_exprt{
+      src,
+      member_designatort{to_member_expr(next->first).get_component_name()},
+      std::move(*updated)};
+  }
+  else
+  {
+    return with_exprt{
+      src, to_index_expr(next->first).index(), std::move(*updated)};
+  }
+}
+
 exprt lower_byte_update(const byte_update_exprt &src, const namespacet &ns)
 {
   DATA_INVARIANT(
@@ -2266,6 +2441,21 @@ exprt lower_byte_update(const byte_update_exprt &src, const namespacet &ns)
   if(src.type().id() == ID_empty || src.value().type().id() == ID_empty)
     return src.op();
 
+  // aligned updates of subobjects need not be unpacked into bytes
+  const auto offset = numeric_cast<mp_integer>(src.offset());
+  const auto value_bits = pointer_offset_bits(src.value().type(), ns);
+  if(
+    offset.has_value() && value_bits.has_value() && *value_bits > 0 &&
+    *value_bits % 8 == 0)
+  {
+    if(
+      auto aligned = lower_aligned_byte_update(
+        src.op(), *offset, src.value(), *value_bits, ns))
+    {
+      return simplify_expr(std::move(*aligned), ns);
+    }
+  }
+
   // byte_update lowering proceeds as follows:
   // 1) Determine the size of the update, with the size of the object to be
   // updated as an upper bound. We fail if neither can be determined.
@@ -2333,3 +2523,143 @@ exprt lower_byte_operators(const exprt &src, const namespacet &ns)
   else
     return tmp;
 }
+
+/// \return true iff \p src is an object access that lowering cannot simplify,
+///   such that lowering it via a placeholder yields the same result
+static bool is_memoizable_operand(const exprt &src)
+{
+  return src.id() == ID_symbol || src.id() == ID_nondet_symbol ||
+         src.id() == ID_member || src.id() == ID_index;
+}
+
+/// Look up the lowering of \p key in \p cache, computing it via \p lower if
+/// it has not been lowered before, and substitute the operands replaced by
+/// placeholders in \p key.
+template <typename byte_operator_exprt, typename lowert>
+static exprt lower_memoized(
+  const byte_operator_exprt &key,
+  const std::vector<std::pair<exprt, exprt>> &placeholders,
+  byte_operator_lowering_cachet &cache,
+  lowert lower)
+{
+  auto entry = cache.lowered.find(key);
+
+  if(entry == cache.lowered.end())
+  {
+    ++cache.misses;
+    exprt lowered = lower(key);
+
+    // comprehensions would share their bound variable across uses
+    if(has_subexpr(lowered, ID_array_comprehension))
+    {
+      for(const auto &placeholder : placeholders)
+        replace_expr(placeholder.first, placeholder.second, lowered);
+      return lowered;
+    }
+
+    entry = cache.lowered.emplace(key, std::move(lowered)).first;
+  }
+  else
+    ++cache.hits;
+
+  exprt result = entry->second;
+  for(const auto &placeholder : placeholders)
+    replace_expr(placeholder.first, placeholder.second, result);
+
+  return result;
+}
+
+exprt lower_byte_extract(
+  const byte_extract_exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  exprt result;
+
+  if(src.offset().is_constant() && is_memoizable_operand(src.op()))
+  {
+    byte_extract_exprt key = src;
+    key.op() = symbol_exprt{"byte_operator_lowering::object", src.op().type()};
+
+    result = lower_memoized(
+      key,
+      {{key.op(), src.op()}},
+      cache,
+      [&ns](const byte_extract_exprt &key) {
+        return lower_byte_extract(key, ns);
+      });
+  }
+  else
+    result = lower_byte_extract(src, ns);
+
+  cache.runtime += std::chrono::steady_clock::now() - start;
+
+  return result;
+}
+
+exprt lower_byte_update(
+  const byte_update_exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  exprt result;
+
+  if(src.offset().is_constant() && is_memoizable_operand(src.op()))
+  {
+    byte_update_exprt key = src;
+    std::vector<std::pair<exprt, exprt>> placeholders;
+
+    key.set_op(
+      symbol_exprt{"byte_operator_lowering::object", src.op().type()});
+    placeholders.emplace_back(key.op(), src.op());
+
+    // constant values are kept as they simplify the result
+    if(is_memoizable_operand(src.value()))
+    {
+      key.set_value(
+        symbol_exprt{"byte_operator_lowering::value", src.value().type()});
+      placeholders.emplace_back(key.value(), src.value());
+    }
+
+    result = lower_memoized(
+      key, placeholders, cache, [&ns](const byte_update_exprt &key) {
+        return lower_byte_update(key, ns);
+      });
+  }
+  else
+    result = lower_byte_update(src, ns);
+
+  cache.runtime += std::chrono::steady_clock::now() - start;
+
+  return result;
+}
+
+exprt lower_byte_operators(
+  const exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache)
+{
+  exprt tmp = src;
+
+  Forall_operands(it, tmp)
+    *it = lower_byte_operators(*it, ns, cache);
+
+  if(
+    src.id() == ID_byte_update_little_endian ||
+    src.id() == ID_byte_update_big_endian)
+  {
+    return lower_byte_update(to_byte_update_expr(tmp), ns, cache);
+  }
+  else if(
+    src.id() == ID_byte_extract_little_endian ||
+    src.id() == ID_byte_extract_big_endian)
+  {
+    return lower_byte_extract(to_byte_extract_expr(tmp), ns, cache);
+  }
+  else
+    return tmp;
+}
@@ -9,12 +9,33 @@ Author: Michael Tautschnig
 #ifndef CPROVER_SOLVERS_LOWERING_EXPR_LOWERING_H
 #define CPROVER_SOLVERS_LOWERING_EXPR_LOWERING_H
 
+#include <chrono>
+#include <unordered_map>
+
 #include <util/expr.h>
 
 class byte_extract_exprt;
 class byte_update_exprt;
 class namespacet;
 
+/// Memoizes the lowering of byte operators with a constant offset. Entries
+/// are keyed by the byte operator with its object (and update value)
+/// replaced by placeholders, i.e., by the type of the object, the offset, the
+/// type that is extracted or written, and the endianness. The results depend
+/// on the namespace, which must thus be the same for all uses of a cache.
+class byte_operator_lowering_cachet
+{
+public:
+  /// Lowered byte operators over the placeholder object and value
+  std::unordered_map<exprt, exprt, irep_hash> lowered;
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+
+  /// Total time spent lowering byte operators using this cache
+  std::chrono::duration<double> runtime{0};
+};
+
 /// Rewrite a byte extract expression to more fundamental operations.
 /// \param src: Byte extract expression
 /// \param ns: Namespace
@@ -24,6 +45,14 @@ class namespacet;
 ///   byte operators from any operands of \p src.
 exprt lower_byte_extract(const byte_extract_exprt &src, const namespacet &ns);
 
+/// Rewrite a byte extract expression to more fundamental operations, reusing
+/// the results for earlier expressions of the same shape stored in \p cache.
+/// See \ref lower_byte_extract(const byte_extract_exprt &, const namespacet &).
+exprt lower_byte_extract(
+  const byte_extract_exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache);
+
 /// Rewrite a byte update expression to more fundamental operations.
 /// \param src: Byte update expression
 /// \param ns: Namespace
@@ -33,6 +62,14 @@ exprt lower_byte_extract(const byte_extract_exprt &src, const namespacet &ns);
 ///   byte operators from any operands of \p src.
 exprt lower_byte_update(const byte_update_exprt &src, const namespacet &ns);
 
+/// Rewrite a byte update expression to more fundamental operations, reusing
+/// the results for earlier expressions of the same shape stored in \p cache.
+/// See \ref lower_byte_update(const byte_update_exprt &, const namespacet &).
+exprt lower_byte_update(
+  const byte_update_exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache);
+
 /// Rewrite an expression possibly containing byte-extract or -update
 /// expressions to more fundamental operations.
 /// \param src: Input expression
@@ -41,6 +78,14 @@ exprt lower_byte_update(const byte_update_exprt &src, const namespacet &ns);
 ///   byte_extract_exprt or \ref byte_update_exprt.
 exprt lower_byte_operators(const exprt &src, const namespacet &ns);
 
+/// Rewrite an expression possibly containing byte-extract or -update
+/// expressions to more fundamental operations, using \p cache to lower the
+/// byte operators.
+exprt lower_byte_operators(
+  const exprt &src,
+  const namespacet &ns,
+  byte_operator_lowering_cachet &cache);
+
 bool has_byte_operator(const exprt &src);
 
 #endif /* CPROVER_SOLVERS_LOWERING_EXPR_LOWERING_H */
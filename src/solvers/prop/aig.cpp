@@ -0,0 +1,190 @@
+/*******************************************************************\
+
+Module: And-Inverter Graph
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// And-Inverter Graph
+
+#include "aig.h"
+
+#include <ostream>
+
+bool aigt::rewrite(literalt a, literalt b, literalt &result)
+{
+  if(a.is_constant() || !nodes[a.var_no()].is_and())
+    return false;
+
+  const aig_nodet &node = nodes[a.var_no()];
+
+  if(!a.sign())
+  {
+    // contradiction: (x & y) & !x = false
+    if(b == !node.a || b == !node.b)
+    {
+      result = const_literal(false);
+      return true;
+    }
+
+    // idempotence: (x & y) & x = (x & y)
+    if(b == node.a || b == node.b)
+    {
+      result = a;
+      return true;
+    }
+  }
+  else
+  {
+    // subsumption: !(x & y) & !x = !x
+    if(b == !node.a || b == !node.b)
+    {
+      result = b;
+      return true;
+    }
+
+    // substitution: !(x & y) & x = !y & x
+    if(b == node.a)
+    {
+      result = new_and_node(!node.b, b);
+      return true;
+    }
+
+    if(b == node.b)
+    {
+      result = new_and_node(!node.a, b);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+literalt aigt::new_and_node(literalt a, literalt b)
+{
+  // constant propagation
+  if(a.is_false() || b.is_false())
+  {
+    ++simplified;
+    return const_literal(false);
+  }
+  if(a.is_true())
+  {
+    ++simplified;
+    return b;
+  }
+  if(b.is_true())
+  {
+    ++simplified;
+    return a;
+  }
+
+  if(a == b)
+  {
+    ++simplified;
+    return a;
+  }
+  if(a == !b)
+  {
+    ++simplified;
+    return const_literal(false);
+  }
+
+  literalt result;
+  if(rewrite(a, b, result) || rewrite(b, a, result))
+  {
+    ++simplified;
+    return result;
+  }
+
+  if(nodes[a.var_no()].is_and() && nodes[b.var_no()].is_and())
+  {
+    const aig_nodet &node_a = nodes[a.var_no()];
+    const aig_nodet &node_b = nodes[b.var_no()];
+
+    // contradiction: (x & y) & (!x & z) = false
+    if(
+      !a.sign() && !b.sign() &&
+      (node_a.a == !node_b.a || node_a.a == !node_b.b ||
+       node_a.b == !node_b.a || node_a.b == !node_b.b))
+    {
+      ++simplified;
+      return const_literal(false);
+    }
+
+    // resolution: !(x & y) & !(x & !y) = !x
+    if(a.sign() && b.sign())
+    {
+      if(
+        (node_a.a == node_b.a && node_a.b == !node_b.b) ||
+        (node_a.a == node_b.b && node_a.b == !node_b.a))
+      {
+        ++simplified;
+        return !node_a.a;
+      }
+      if(
+        (node_a.b == node_b.b && node_a.a == !node_b.a) ||
+        (node_a.b == node_b.a && node_a.a == !node_b.b))
+      {
+        ++simplified;
+        return !node_a.b;
+      }
+    }
+  }
+
+  // structural hashing, with the operands in a canonical order
+  if(b < a)
+    std::swap(a, b);
+
+  const auto key = std::make_pair(a.get(), b.get());
+  const auto existing = and_nodes.find(key);
+  if(existing != and_nodes.end())
+  {
+    ++hash_hits;
+    return literalt(existing->second, false);
+  }
+
+  const literalt::var_not v = static_cast<literalt::var_not>(nodes.size());
+  nodes.emplace_back(a, b);
+  and_nodes.emplace(key, v);
+
+  return literalt(v, false);
+}
+
+static void output_dot_edge(std::ostream &out, std::size_t node, literalt l)
+{
+  if(l.is_constant())
+    out << "  c" << node << " -> n" << node;
+  else
+    out << "  n" << l.var_no() << " -> n" << node;
+
+  if(l.sign())
+    out << " [arrowhead=odot]";
+
+  out << ";\n";
+
+  if(l.is_constant())
+    out << "  c" << node << " [label=\"" << (l.is_true() ? "1" : "0")
+        << "\"];\n";
+}
+
+void aigt::output_dot(std::ostream &out) const
+{
+  out << "digraph aig {\n";
+
+  for(std::size_t n = 1; n < nodes.size(); ++n)
+  {
+    if(nodes[n].is_and())
+    {
+      out << "  n" << n << " [label=\"and\"];\n";
+      output_dot_edge(out, n, nodes[n].a);
+      output_dot_edge(out, n, nodes[n].b);
+    }
+    else
+      out << "  n" << n << " [label=\"var " << n << "\"];\n";
+  }
+
+  out << "}\n";
+}
@@ -0,0 +1,136 @@
+/*******************************************************************\
+
+Module: And-Inverter Graph
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// And-Inverter Graph
+
+#ifndef CPROVER_SOLVERS_PROP_AIG_H
+#define CPROVER_SOLVERS_PROP_AIG_H
+
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+#include <util/irep_hash.h>
+
+#include "literal.h"
+
+/// A node of an And-Inverter Graph: either an input variable or the
+/// conjunction of two possibly negated nodes
+class aig_nodet
+{
+public:
+  literalt a, b;
+
+  aig_nodet()
+  {
+  }
+
+  aig_nodet(literalt _a, literalt _b) : a(_a), b(_b)
+  {
+  }
+
+  bool is_and() const
+  {
+    return a.var_no() != literalt::unused_var_no();
+  }
+
+  bool is_var() const
+  {
+    return !is_and();
+  }
+};
+
+/// An And-Inverter Graph with structural hashing. Literals refer to nodes by
+/// their variable number, the sign of a literal denotes an inverter. As in
+/// CNF, variable number 0 is not used, and the constants are represented by
+/// \ref const_literal.
+///
+/// AND nodes are simplified when they are created: constants are propagated,
+/// and the two-level rewriting rules of Brummayer and Biere ("Local
+/// Two-Level And-Inverter Graph Minimization without Blowup", 2006) detect
+/// contradiction, idempotence, subsumption and resolution among the operands
+/// and their children. The remaining nodes are unique up to the order of the
+/// operands.
+class aigt
+{
+public:
+  aigt() : nodes(1)
+  {
+  }
+
+  typedef std::vector<aig_nodet> nodest;
+
+  /// A fresh input node
+  literalt new_var_node()
+  {
+    literalt l(static_cast<literalt::var_not>(nodes.size()), false);
+    nodes.emplace_back();
+    return l;
+  }
+
+  /// A node for the conjunction of \p a and \p b, which may be an existing
+  /// node or a constant after simplification
+  literalt new_and_node(literalt a, literalt b);
+
+  const aig_nodet &get_node(literalt l) const
+  {
+    return nodes[l.var_no()];
+  }
+
+  std::size_t number_of_nodes() const
+  {
+    return nodes.size() - 1;
+  }
+
+  std::size_t number_of_and_nodes() const
+  {
+    return and_nodes.size();
+  }
+
+  /// Number of requests for AND nodes answered by an existing node
+  std::size_t structural_hash_hits() const
+  {
+    return hash_hits;
+  }
+
+  /// Number of requests for AND nodes answered by simplification
+  std::size_t simplifications() const
+  {
+    return simplified;
+  }
+
+  void output_dot(std::ostream &out) const;
+
+protected:
+  nodest nodes;
+
+  struct and_node_hasht
+  {
+    std::size_t operator()(const std::pair<unsigned, unsigned> &p) const
+    {
+      return hash_combine(static_cast<std::size_t>(p.first), p.second);
+    }
+  };
+
+  /// Maps pairs of operands (smaller literal first) to AND nodes
+  std::unordered_map<
+    std::pair<unsigned, unsigned>,
+    literalt::var_not,
+    and_node_hasht>
+    and_nodes;
+
+  std::size_t hash_hits = 0;
+  std::size_t simplified = 0;
+
+  /// Apply the rewriting rules that look at the children of \p a.
+  /// \return true if the result has been stored in \p result
+  bool rewrite(literalt a, literalt b, literalt &result);
+};
+
+#endif // CPROVER_SOLVERS_PROP_AIG_H
@@ -0,0 +1,388 @@
+/*******************************************************************\
+
+Module: AIG Layer between Propositional Encodings and a SAT Solver
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// AIG Layer between Propositional Encodings and a SAT Solver
+
+#include "aig_prop.h"
+
+#include <util/invariant.h>
+
+/// Negated conjunctions in constraints are flattened into clauses of at most
+/// this many literals
+#define AIG_MAX_CLAUSE_SIZE 64
+
+literalt aig_prop_solvert::land(literalt a, literalt b)
+{
+  return aig.new_and_node(a, b);
+}
+
+literalt aig_prop_solvert::lor(literalt a, literalt b)
+{
+  return !aig.new_and_node(!a, !b);
+}
+
+literalt aig_prop_solvert::land(const bvt &bv)
+{
+  literalt result = const_literal(true);
+  for(const auto &l : bv)
+    result = land(result, l);
+  return result;
+}
+
+literalt aig_prop_solvert::lor(const bvt &bv)
+{
+  literalt result = const_literal(false);
+  for(const auto &l : bv)
+    result = lor(result, l);
+  return result;
+}
+
+literalt aig_prop_solvert::lxor(literalt a, literalt b)
+{
+  return !land(!land(a, !b), !land(!a, b));
+}
+
+literalt aig_prop_solvert::lxor(const bvt &bv)
+{
+  literalt result = const_literal(false);
+  for(const auto &l : bv)
+    result = lxor(result, l);
+  return result;
+}
+
+literalt aig_prop_solvert::lnand(literalt a, literalt b)
+{
+  return !land(a, b);
+}
+
+literalt aig_prop_solvert::lnor(literalt a, literalt b)
+{
+  return !lor(a, b);
+}
+
+literalt aig_prop_solvert::lequal(literalt a, literalt b)
+{
+  return !lxor(a, b);
+}
+
+literalt aig_prop_solvert::limplies(literalt a, literalt b)
+{
+  return lor(!a, b);
+}
+
+literalt aig_prop_solvert::lselect(literalt a, literalt b, literalt c)
+{
+  return !land(!land(a, b), !land(!a, c));
+}
+
+void aig_prop_solvert::set_equal(literalt a, literalt b)
+{
+  constraints.push_back(lequal(a, b));
+}
+
+void aig_prop_solvert::l_set_to(literalt a, bool value)
+{
+  constraints.push_back(a ^ !value);
+}
+
+void aig_prop_solvert::lcnf(const bvt &bv)
+{
+  constraints.push_back(lor(bv));
+}
+
+/// Recognise \p node as AND(!AND(c, u), !AND(!c, w)), which is c ? !u : !w
+static bool is_ite(
+  const aigt &aig,
+  const aig_nodet &node,
+  literalt &c,
+  literalt &u,
+  literalt &w)
+{
+  if(!node.a.sign() || !node.b.sign())
+    return false;
+
+  const aig_nodet &x = aig.get_node(node.a);
+  const aig_nodet &y = aig.get_node(node.b);
+
+  if(!x.is_and() || !y.is_and())
+    return false;
+
+  const literalt x_ops[] = {x.a, x.b};
+  const literalt y_ops[] = {y.a, y.b};
+
+  for(std::size_t i = 0; i < 2; ++i)
+    for(std::size_t j = 0; j < 2; ++j)
+      if(x_ops[i] == !y_ops[j])
+      {
+        c = x_ops[i];
+        u = x_ops[1 - i];
+        w = y_ops[1 - j];
+        return true;
+      }
+
+  return false;
+}
+
+literalt aig_prop_solvert::convert(literalt a)
+{
+  if(a.is_constant())
+    return a;
+
+  return convert_node(a.var_no()) ^ a.sign();
+}
+
+literalt aig_prop_solvert::convert_node(literalt::var_not v)
+{
+  if(node_literals.size() <= aig.number_of_nodes())
+    node_literals.resize(aig.number_of_nodes() + 1);
+
+  auto solver_literal = [this](literalt l) {
+    return l.is_constant() ? l : node_literals[l.var_no()] ^ l.sign();
+  };
+
+  // post-order traversal, avoiding deep recursion on long chains of gates
+  std::vector<std::pair<literalt::var_not, bool>> stack;
+  stack.emplace_back(v, false);
+
+  while(!stack.empty())
+  {
+    const literalt::var_not n = stack.back().first;
+    const bool children_done = stack.back().second;
+    stack.pop_back();
+
+    if(is_converted(n))
+      continue;
+
+    const aig_nodet &node = aig.get_node(literalt(n, false));
+
+    if(node.is_var())
+    {
+      node_literals[n] = solver->new_variable();
+      continue;
+    }
+
+    const literalt replacement =
+      sweeper ? sweeper->get_replacement(n) : literalt();
+    if(replacement.var_no() != literalt::unused_var_no())
+    {
+      if(children_done || replacement.is_constant())
+        node_literals[n] = solver_literal(replacement);
+      else
+      {
+        stack.emplace_back(n, true);
+        stack.emplace_back(replacement.var_no(), false);
+      }
+      continue;
+    }
+
+    literalt c, u, w;
+    const bool ite = is_ite(aig, node, c, u, w);
+
+    if(!children_done)
+    {
+      stack.emplace_back(n, true);
+
+      for(const literalt &op : ite ? bvt{c, u, w} : bvt{node.a, node.b})
+        if(!op.is_constant() && !is_converted(op.var_no()))
+          stack.emplace_back(op.var_no(), false);
+
+      continue;
+    }
+
+    if(ite && w == !u)
+      node_literals[n] = solver->lxor(solver_literal(c), solver_literal(u));
+    else if(ite)
+    {
+      node_literals[n] = solver->lselect(
+        solver_literal(c), !solver_literal(u), !solver_literal(w));
+    }
+    else
+    {
+      node_literals[n] =
+        solver->land(solver_literal(node.a), solver_literal(node.b));
+    }
+  }
+
+  return node_literals[v];
+}
+
+void aig_prop_solvert::convert_constraint(literalt l)
+{
+  // a conjunction becomes one constraint per conjunct
+  bvt conjuncts{l};
+
+  while(!conjuncts.empty())
+  {
+    const literalt conjunct = conjuncts.back();
+    conjuncts.pop_back();
+
+    if(conjunct.is_true())
+      continue;
+
+    if(conjunct.is_false())
+    {
+      has_empty_clause = true;
+      continue;
+    }
+
+    const aig_nodet &node = aig.get_node(conjunct);
+
+    if(node.is_and() && !conjunct.sign())
+    {
+      conjuncts.push_back(node.a);
+      conjuncts.push_back(node.b);
+      continue;
+    }
+
+    // a negated conjunction becomes a clause, flattening nested disjunctions
+    bvt disjuncts{conjunct};
+    bvt clause;
+
+    while(!disjuncts.empty())
+    {
+      const literalt disjunct = disjuncts.back();
+      disjuncts.pop_back();
+
+      const aig_nodet &d_node = aig.get_node(disjunct);
+      if(
+        d_node.is_and() && disjunct.sign() &&
+        clause.size() + disjuncts.size() + 2 <= AIG_MAX_CLAUSE_SIZE)
+      {
+        disjuncts.push_back(!d_node.a);
+        disjuncts.push_back(!d_node.b);
+      }
+      else
+        clause.push_back(convert(disjunct));
+    }
+
+    solver->lcnf(clause);
+    ++number_of_clauses;
+  }
+}
+
+propt::resultt aig_prop_solvert::do_prop_solve()
+{
+  if(sweeper)
+  {
+    bvt roots(constraints.begin() + converted_constraints, constraints.end());
+    roots.insert(roots.end(), assumptions.begin(), assumptions.end());
+    sweeper->sweep(
+      roots, [this](literalt::var_not v) { return !is_converted(v); });
+  }
+
+  for(; converted_constraints < constraints.size(); ++converted_constraints)
+    convert_constraint(constraints[converted_constraints]);
+
+  bvt solver_assumptions;
+  solver_assumptions.reserve(assumptions.size());
+  for(const auto &a : assumptions)
+    solver_assumptions.push_back(convert(a));
+  solver->set_assumptions(solver_assumptions);
+
+  messaget::mstreamt &statistics = log.statistics();
+  statistics << "AIG: " << aig.number_of_nodes() << " nodes, "
+             << aig.number_of_and_nodes() << " AND nodes, "
+             << aig.structural_hash_hits() << " structural hash hits, "
+             << aig.simplifications() << " simplifications, "
+             << number_of_clauses << " constraint clauses";
+  if(sweeper)
+  {
+    statistics << ", " << sweeper->number_of_merged_nodes()
+               << " nodes merged by SAT sweeping";
+  }
+  statistics << messaget::eom;
+
+  node_values.clear();
+
+  if(has_empty_clause)
+    return resultt::P_UNSATISFIABLE;
+
+  return solver->prop_solve();
+}
+
+bool aig_prop_solvert::evaluate(literalt l) const
+{
+  std::vector<literalt::var_not> stack{l.var_no()};
+
+  while(!stack.empty())
+  {
+    const literalt::var_not n = stack.back();
+
+    if(node_values.find(n) != node_values.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if(is_converted(n))
+    {
+      node_values[n] = solver->l_get(node_literals[n]).is_true();
+      stack.pop_back();
+      continue;
+    }
+
+    const aig_nodet &node = aig.get_node(literalt(n, false));
+
+    // nodes outside the cone of the constraints may take any value
+    if(node.is_var())
+    {
+      node_values[n] = false;
+      stack.pop_back();
+      continue;
+    }
+
+    bool pending = false;
+    for(const literalt &op : {node.a, node.b})
+    {
+      if(node_values.find(op.var_no()) == node_values.end())
+      {
+        stack.push_back(op.var_no());
+        pending = true;
+      }
+    }
+
+    if(pending)
+      continue;
+
+    node_values[n] = (node_values[node.a.var_no()] != node.a.sign()) &&
+                     (node_values[node.b.var_no()] != node.b.sign());
+    stack.pop_back();
+  }
+
+  return node_values[l.var_no()] != l.sign();
+}
+
+tvt aig_prop_solvert::l_get(literalt a) const
+{
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  if(is_converted(a.var_no()))
+    return solver->l_get(node_literals[a.var_no()] ^ a.sign());
+
+  return tvt(evaluate(a));
+}
+
+void aig_prop_solvert::set_assignment(literalt a, bool value)
+{
+  if(!a.is_constant())
+    solver->set_assignment(convert(a), value);
+}
+
+bool aig_prop_solvert::is_in_conflict(literalt l) const
+{
+  PRECONDITION(!l.is_constant() && is_converted(l.var_no()));
+  return solver->is_in_conflict(node_literals[l.var_no()] ^ l.sign());
+}
+
+void aig_prop_solvert::set_frozen(literalt a)
+{
+  if(!a.is_constant())
+    solver->set_frozen(convert(a));
+}
@@ -0,0 +1,170 @@
+/*******************************************************************\
+
+Module: AIG Layer between Propositional Encodings and a SAT Solver
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// AIG Layer between Propositional Encodings and a SAT Solver
+
+#ifndef CPROVER_SOLVERS_PROP_AIG_PROP_H
+#define CPROVER_SOLVERS_PROP_AIG_PROP_H
+
+#include <memory>
+#include <unordered_map>
+
+#include <util/make_unique.h>
+
+#include "aig.h"
+#include "aig_sweep.h"
+#include "prop.h"
+
+/// A \ref propt that collects all gates and constraints in a structurally
+/// hashed And-Inverter Graph and hands them to an underlying solver only when
+/// a solver call is made. Equivalent subformulas, which the flattening
+/// frequently creates for example in adders, comparisons and array
+/// constraints, thus share a single set of solver variables and clauses.
+///
+/// Conversion is incremental: each call of \ref prop_solve converts only the
+/// nodes and constraints added since the previous call, so the underlying
+/// solver must not eliminate variables, i.e., it should be a solver without
+/// preprocessing. Multiplexers and exclusive-ors in the graph are recognised
+/// and converted using the corresponding gates of the underlying solver;
+/// conjunctions and negated conjunctions of constraints are split into
+/// separate clauses.
+class aig_prop_solvert : public propt
+{
+public:
+  aig_prop_solvert(
+    std::unique_ptr<propt> solver,
+    message_handlert &message_handler)
+    : propt(message_handler), solver(std::move(solver))
+  {
+  }
+
+  literalt land(literalt a, literalt b) override;
+  literalt lor(literalt a, literalt b) override;
+  literalt land(const bvt &bv) override;
+  literalt lor(const bvt &bv) override;
+  literalt lxor(literalt a, literalt b) override;
+  literalt lxor(const bvt &bv) override;
+  literalt lnand(literalt a, literalt b) override;
+  literalt lnor(literalt a, literalt b) override;
+  literalt lequal(literalt a, literalt b) override;
+  literalt limplies(literalt a, literalt b) override;
+  literalt lselect(literalt a, literalt b, literalt c) override;
+
+  void set_equal(literalt a, literalt b) override;
+  void l_set_to(literalt a, bool value) override;
+  using propt::lcnf;
+  void lcnf(const bvt &bv) override;
+
+  bool cnf_handled_well() const override
+  {
+    return false;
+  }
+
+  void set_assumptions(const bvt &_assumptions) override
+  {
+    assumptions = _assumptions;
+  }
+
+  bool has_set_assumptions() const override
+  {
+    return solver->has_set_assumptions();
+  }
+
+  literalt new_variable() override
+  {
+    return aig.new_var_node();
+  }
+
+  /// As in CNF, this is one more than the largest variable number, as
+  /// variable number 0 is not used
+  size_t no_variables() const override
+  {
+    return aig.number_of_nodes() + 1;
+  }
+
+  const std::string solver_text() override
+  {
+    return "AIG + " + solver->solver_text();
+  }
+
+  tvt l_get(literalt a) const override;
+  void set_assignment(literalt a, bool value) override;
+
+  bool is_in_conflict(literalt l) const override;
+
+  bool has_is_in_conflict() const override
+  {
+    return solver->has_is_in_conflict();
+  }
+
+  void set_frozen(literalt a) override;
+
+  void set_time_limit_seconds(uint32_t lim) override
+  {
+    solver->set_time_limit_seconds(lim);
+  }
+
+  const aigt &get_aig() const
+  {
+    return aig;
+  }
+
+  /// Before each solver call, merge nodes in the cone of the new constraints
+  /// and assumptions that \ref aig_sweept proves equivalent, using a solver
+  /// made by \p make_solver for the equivalence checks and spending at
+  /// most \p time_budget in total
+  void enable_sweeping(
+    const aig_sweept::make_solvert &make_solver,
+    std::chrono::milliseconds time_budget)
+  {
+    sweeper = util_make_unique<aig_sweept>(
+      aig, make_solver, time_budget, log.get_message_handler());
+  }
+
+  /// The literal of the underlying solver that represents \p a, converting
+  /// the cone of \p a if this has not been done yet
+  literalt convert(literalt a);
+
+protected:
+  resultt do_prop_solve() override;
+
+  std::unique_ptr<propt> solver;
+  aigt aig;
+  std::unique_ptr<aig_sweept> sweeper;
+
+  /// Solver literals of the converted nodes, indexed by variable number
+  std::vector<literalt> node_literals;
+
+  /// The constraints, of which the first \ref converted_constraints have
+  /// been passed on to the solver
+  bvt constraints;
+  std::size_t converted_constraints = 0;
+
+  bvt assumptions;
+
+  std::size_t number_of_clauses = 0;
+
+  /// Set when a constraint simplified to false
+  bool has_empty_clause = false;
+
+  /// Values of unconverted nodes, computed on demand by \ref l_get
+  mutable std::unordered_map<literalt::var_not, bool> node_values;
+
+  bool is_converted(literalt::var_not v) const
+  {
+    return v < node_literals.size() &&
+           node_literals[v].var_no() != literalt::unused_var_no();
+  }
+
+  literalt convert_node(literalt::var_not v);
+  void convert_constraint(literalt l);
+  bool evaluate(literalt l) const;
+};
+
+#endif // CPROVER_SOLVERS_PROP_AIG_PROP_H
@@ -0,0 +1,387 @@
+/*******************************************************************\
+
+Module: SAT Sweeping of And-Inverter Graphs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// SAT Sweeping of And-Inverter Graphs
+
+#include "aig_sweep.h"
+
+#include <algorithm>
+
+#include <util/invariant.h>
+
+/// Number of 64-bit words of random patterns simulated initially
+#define AIG_SWEEP_INITIAL_WORDS 4
+
+/// Counterexamples are no longer added as simulation patterns once there
+/// are this many words
+#define AIG_SWEEP_MAX_WORDS 32
+
+/// Number of representatives of a candidate class that a node is checked
+/// against
+#define AIG_SWEEP_MAX_CANDIDATES 2
+
+aig_sweept::aig_sweept(
+  const aigt &aig,
+  const make_solvert &make_solver,
+  std::chrono::milliseconds time_budget,
+  message_handlert &message_handler)
+  : aig(aig),
+    solver(make_solver(solver_message_handler)),
+    log(message_handler),
+    time_budget(time_budget),
+    simulation(AIG_SWEEP_INITIAL_WORDS, wordst(1, 0))
+{
+}
+
+void aig_sweept::simulate_new_nodes()
+{
+  const std::size_t size = aig.number_of_nodes() + 1;
+
+  for(auto &word : simulation)
+  {
+    for(std::size_t v = word.size(); v < size; ++v)
+    {
+      const aig_nodet &node =
+        aig.get_node(literalt(static_cast<literalt::var_not>(v), false));
+
+      if(node.is_var())
+        word.push_back(random());
+      else
+      {
+        word.push_back(
+          (word[node.a.var_no()] ^ (node.a.sign() ? ~0ull : 0)) &
+          (word[node.b.var_no()] ^ (node.b.sign() ? ~0ull : 0)));
+      }
+    }
+  }
+
+  pending_patterns.reserve(size);
+  while(pending_patterns.size() < size)
+    pending_patterns.push_back(random());
+
+  replacements.resize(size);
+  classified.resize(size, false);
+}
+
+void aig_sweept::add_simulation_word(const wordst &input_values)
+{
+  const std::size_t size = simulation.front().size();
+  wordst word(size, 0);
+
+  for(std::size_t v = 1; v < size; ++v)
+  {
+    const aig_nodet &node =
+      aig.get_node(literalt(static_cast<literalt::var_not>(v), false));
+
+    if(node.is_var())
+      word[v] = input_values[v];
+    else
+    {
+      word[v] = (word[node.a.var_no()] ^ (node.a.sign() ? ~0ull : 0)) &
+                (word[node.b.var_no()] ^ (node.b.sign() ? ~0ull : 0));
+    }
+  }
+
+  simulation.push_back(std::move(word));
+  rebuild_classes();
+}
+
+void aig_sweept::rebuild_classes()
+{
+  classes.clear();
+
+  for(std::size_t v = 1; v < classified.size(); ++v)
+  {
+    if(
+      classified[v] &&
+      replacements[v].var_no() == literalt::unused_var_no())
+    {
+      const literalt::var_not var = static_cast<literalt::var_not>(v);
+      classes[signature_hash(var)].push_back(var);
+    }
+  }
+}
+
+std::size_t aig_sweept::signature_hash(literalt::var_not v) const
+{
+  const std::uint64_t mask = phase(v) ? ~0ull : 0;
+  std::size_t hash = 0;
+
+  for(const auto &word : simulation)
+  {
+    hash =
+      hash * 0x9e3779b97f4a7c15ull ^ static_cast<std::size_t>(word[v] ^ mask);
+  }
+
+  return hash;
+}
+
+bool aig_sweept::same_signature(literalt::var_not v1, literalt::var_not v2)
+  const
+{
+  const std::uint64_t mask = phase(v1) != phase(v2) ? ~0ull : 0;
+
+  for(const auto &word : simulation)
+    if(word[v1] != (word[v2] ^ mask))
+      return false;
+
+  return true;
+}
+
+bool aig_sweept::is_constant_signature(literalt::var_not v) const
+{
+  const std::uint64_t expected = phase(v) ? ~0ull : 0;
+
+  for(const auto &word : simulation)
+    if(word[v] != expected)
+      return false;
+
+  return true;
+}
+
+literalt aig_sweept::convert(literalt l)
+{
+  if(l.is_constant())
+    return l;
+
+  if(solver_literals.size() < classified.size())
+    solver_literals.resize(classified.size());
+
+  auto is_converted = [this](literalt::var_not v) {
+    return solver_literals[v].var_no() != literalt::unused_var_no();
+  };
+
+  auto solver_literal = [this](literalt op) {
+    return solver_literals[op.var_no()] ^ op.sign();
+  };
+
+  std::vector<std::pair<literalt::var_not, bool>> stack;
+  stack.emplace_back(l.var_no(), false);
+
+  while(!stack.empty())
+  {
+    const literalt::var_not n = stack.back().first;
+    const bool children_done = stack.back().second;
+    stack.pop_back();
+
+    if(is_converted(n))
+      continue;
+
+    const aig_nodet &node = aig.get_node(literalt(n, false));
+
+    if(node.is_var())
+      solver_literals[n] = solver->new_variable();
+    else if(!children_done)
+    {
+      stack.emplace_back(n, true);
+      for(const literalt &op : {node.a, node.b})
+        if(!is_converted(op.var_no()))
+          stack.emplace_back(op.var_no(), false);
+    }
+    else
+      solver_literals[n] =
+        solver->land(solver_literal(node.a), solver_literal(node.b));
+  }
+
+  return solver_literal(l);
+}
+
+bool aig_sweept::prove_equivalent(
+  literalt l1,
+  literalt l2,
+  std::chrono::steady_clock::duration remaining_time)
+{
+  const literalt a = convert(l1);
+  const literalt b = convert(l2);
+
+  // Solvers take whole seconds, and 0 would mean no limit at all. Solvers
+  // without support for a time limit are only stopped between calls.
+  const auto seconds =
+    std::chrono::duration_cast<std::chrono::seconds>(remaining_time).count();
+  solver->set_time_limit_seconds(
+    static_cast<uint32_t>(std::max<decltype(seconds)>(seconds, 1)));
+
+  solver->set_assumptions({solver->lxor(a, b)});
+  ++sat_calls;
+
+  switch(solver->prop_solve())
+  {
+  case propt::resultt::P_UNSATISFIABLE:
+    solver->set_assumptions({});
+    solver->set_equal(a, b);
+    return true;
+
+  case propt::resultt::P_SATISFIABLE:
+    record_counterexample();
+    return false;
+
+  case propt::resultt::P_UNKNOWN:
+  case propt::resultt::P_ERROR:
+    // unknown, for example because the time limit was hit: not proven, and
+    // there is no counterexample to learn from
+    solver->set_assumptions({});
+    ++unknown_results;
+    return false;
+  }
+
+  UNREACHABLE;
+}
+
+void aig_sweept::record_counterexample()
+{
+  if(simulation.size() >= AIG_SWEEP_MAX_WORDS)
+    return;
+
+  const std::uint64_t bit = 1ull << number_of_pending_patterns;
+
+  for(std::size_t v = 1; v < solver_literals.size(); ++v)
+  {
+    const literalt l = solver_literals[v];
+    if(
+      l.var_no() == literalt::unused_var_no() ||
+      !aig.get_node(literalt(static_cast<literalt::var_not>(v), false))
+         .is_var())
+    {
+      continue;
+    }
+
+    if(solver->l_get(l).is_true())
+      pending_patterns[v] |= bit;
+    else
+      pending_patterns[v] &= ~bit;
+  }
+
+  if(++number_of_pending_patterns == 64)
+  {
+    add_simulation_word(pending_patterns);
+    for(auto &word : pending_patterns)
+      word = random();
+    number_of_pending_patterns = 0;
+  }
+}
+
+void aig_sweept::sweep(
+  const bvt &roots,
+  const std::function<bool(literalt::var_not)> &can_replace)
+{
+  if(time_used >= time_budget)
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t merged_before = merged_nodes;
+  const std::size_t sat_calls_before = sat_calls;
+  const std::size_t unknown_results_before = unknown_results;
+
+  simulate_new_nodes();
+
+  std::vector<bool> in_cone(classified.size(), false);
+  std::vector<literalt::var_not> stack;
+  for(const auto &root : roots)
+    if(!root.is_constant())
+      stack.push_back(root.var_no());
+
+  while(!stack.empty())
+  {
+    const literalt::var_not v = stack.back();
+    stack.pop_back();
+
+    if(in_cone[v] || classified[v])
+      continue;
+
+    in_cone[v] = true;
+
+    const aig_nodet &node = aig.get_node(literalt(v, false));
+    if(node.is_and())
+    {
+      stack.push_back(node.a.var_no());
+      stack.push_back(node.b.var_no());
+    }
+  }
+
+  // variable numbers are a topological order of the graph
+  for(std::size_t i = 1; i < in_cone.size(); ++i)
+  {
+    if(!in_cone[i])
+      continue;
+
+    const auto remaining_time =
+      time_budget - (time_used + (std::chrono::steady_clock::now() - start));
+    if(remaining_time <= std::chrono::steady_clock::duration::zero())
+    {
+      log.warning() << "SAT sweeping stopped: time budget exhausted"
+                    << messaget::eom;
+      break;
+    }
+
+    const literalt::var_not v = static_cast<literalt::var_not>(i);
+    const literalt node_literal(v, false);
+    literalt replacement;
+
+    if(aig.get_node(node_literal).is_and() && can_replace(v))
+    {
+      if(
+        is_constant_signature(v) &&
+        prove_equivalent(
+          node_literal, const_literal(phase(v)), remaining_time))
+      {
+        replacement = const_literal(phase(v));
+      }
+      else
+      {
+        const auto c = classes.find(signature_hash(v));
+        if(c != classes.end())
+        {
+          // a counterexample may rebuild the classes
+          const std::vector<literalt::var_not> candidates = c->second;
+          std::size_t tried = 0;
+
+          for(const auto candidate : candidates)
+          {
+            if(tried == AIG_SWEEP_MAX_CANDIDATES)
+              break;
+            if(!same_signature(v, candidate))
+              continue;
+
+            ++tried;
+            const literalt candidate_literal(
+              candidate, phase(v) != phase(candidate));
+            if(prove_equivalent(
+                 node_literal, candidate_literal, remaining_time))
+            {
+              replacement = candidate_literal;
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    classified[v] = true;
+
+    if(replacement.var_no() != literalt::unused_var_no())
+    {
+      replacements[v] = replacement;
+      ++merged_nodes;
+    }
+    else
+      classes[signature_hash(v)].push_back(v);
+  }
+
+  time_used += std::chrono::steady_clock::now() - start;
+
+  messaget::mstreamt &status = log.status();
+  status << "SAT sweeping merged " << merged_nodes - merged_before
+         << " AIG nodes using " << sat_calls - sat_calls_before << " SAT calls";
+  if(unknown_results != unknown_results_before)
+  {
+    status << ", " << unknown_results - unknown_results_before
+           << " of them inconclusive";
+  }
+  status << messaget::eom;
+}
@@ -0,0 +1,131 @@
+/*******************************************************************\
+
+Module: SAT Sweeping of And-Inverter Graphs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// SAT Sweeping of And-Inverter Graphs
+
+#ifndef CPROVER_SOLVERS_PROP_AIG_SWEEP_H
+#define CPROVER_SOLVERS_PROP_AIG_SWEEP_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+#include "aig.h"
+#include "prop.h"
+
+/// Finds AND nodes of an \ref aigt that are functionally equivalent to an
+/// earlier node, or to a constant, possibly up to negation (FRAIG-style SAT
+/// sweeping, as in Mishchenko et al., "FRAIGs: A Unifying Representation for
+/// Logic Synthesis and Verification", 2005).
+///
+/// All nodes are simulated on 64-bit words of random input patterns; nodes
+/// with the same (normalised) simulation signature are candidates for
+/// equivalence. Each candidate pair is checked with an incremental call of a
+/// separate SAT solver, under an assumption on their exclusive-or. Proven
+/// equivalences are recorded as replacements and also added to the checking
+/// solver, which simplifies later checks; counterexamples become new
+/// simulation patterns that split the candidate classes.
+///
+/// The checking solver holds no constraints, so the replacements are valid
+/// unconditionally. Its messages are discarded, as there is one solver call
+/// per candidate pair. The total time spent is bounded by a budget, which also
+/// limits each solver call.
+class aig_sweept
+{
+public:
+  typedef std::function<std::unique_ptr<propt>(message_handlert &)>
+    make_solvert;
+
+  aig_sweept(
+    const aigt &aig,
+    const make_solvert &make_solver,
+    std::chrono::milliseconds time_budget,
+    message_handlert &message_handler);
+
+  /// Sweep the nodes in the cones of \p roots. Nodes for which
+  /// \p can_replace returns false may serve as representatives but are not
+  /// replaced themselves.
+  void sweep(
+    const bvt &roots,
+    const std::function<bool(literalt::var_not)> &can_replace);
+
+  /// The literal that the node with variable number \p v has been proven
+  /// equivalent to, or a literal with \ref literalt::unused_var_no
+  literalt get_replacement(literalt::var_not v) const
+  {
+    return v < replacements.size() ? replacements[v] : literalt();
+  }
+
+  std::size_t number_of_merged_nodes() const
+  {
+    return merged_nodes;
+  }
+
+protected:
+  const aigt &aig;
+  null_message_handlert solver_message_handler;
+  std::unique_ptr<propt> solver;
+  messaget log;
+
+  const std::chrono::milliseconds time_budget;
+  std::chrono::steady_clock::duration time_used =
+    std::chrono::steady_clock::duration::zero();
+
+  std::mt19937_64 random;
+
+  typedef std::vector<std::uint64_t> wordst;
+
+  /// Simulation values, indexed by word, then by variable number
+  std::vector<wordst> simulation;
+
+  /// Input values of counterexamples not yet added to \ref simulation
+  wordst pending_patterns;
+  std::size_t number_of_pending_patterns = 0;
+
+  /// Representatives of the candidate classes, by signature hash
+  std::unordered_map<std::size_t, std::vector<literalt::var_not>> classes;
+
+  std::vector<literalt> replacements;
+  std::vector<bool> classified;
+  std::vector<literalt> solver_literals;
+
+  std::size_t merged_nodes = 0;
+  std::size_t sat_calls = 0;
+  std::size_t unknown_results = 0;
+
+  void simulate_new_nodes();
+  void add_simulation_word(const wordst &input_values);
+  void rebuild_classes();
+
+  bool phase(literalt::var_not v) const
+  {
+    return (simulation.front()[v] & 1) != 0;
+  }
+
+  std::size_t signature_hash(literalt::var_not v) const;
+  bool same_signature(literalt::var_not v1, literalt::var_not v2) const;
+  bool is_constant_signature(literalt::var_not v) const;
+
+  literalt convert(literalt l);
+
+  /// Check whether \p l1 and \p l2 are equivalent, recording a counterexample
+  /// if they are not. The solver call is limited to \p remaining_time, and
+  /// an inconclusive result counts as not equivalent.
+  bool prove_equivalent(
+    literalt l1,
+    literalt l2,
+    std::chrono::steady_clock::duration remaining_time);
+
+  void record_counterexample();
+};
+
+#endif // CPROVER_SOLVERS_PROP_AIG_SWEEP_H
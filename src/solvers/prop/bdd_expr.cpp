@@ -15,6 +15,8 @@ Author: Michael Tautschnig, michael.tautschnig@qmul.ac.uk
 #include <util/invariant.h>
 #include <util/std_expr.h>
 
+#include <unordered_set>
+
 bddt bdd_exprt::from_expr_rec(const exprt &expr)
 {
   PRECONDITION(expr.type().id() == ID_bool);
@@ -174,3 +176,23 @@ exprt bdd_exprt::as_expr(const bddt &root) const
   bdd_nodet node = bdd_mgr.bdd_node(root);
   return as_expr(node, cache);
 }
+
+std::size_t bdd_exprt::size(const bddt &root) const
+{
+  std::unordered_set<bdd_nodet::idt> seen;
+  std::vector<bdd_nodet> stack{bdd_mgr.bdd_node(root)};
+
+  while(!stack.empty())
+  {
+    const bdd_nodet node = stack.back();
+    stack.pop_back();
+
+    if(!seen.insert(node.id()).second || node.is_constant())
+      continue;
+
+    stack.push_back(node.then_branch());
+    stack.push_back(node.else_branch());
+  }
+
+  return seen.size();
+}
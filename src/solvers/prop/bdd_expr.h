@@ -36,6 +36,9 @@ public:
   bddt from_expr(const exprt &expr);
   exprt as_expr(const bddt &root) const;
 
+  /// The number of nodes of \p root, including the terminals
+  std::size_t size(const bddt &root) const;
+
 protected:
   bdd_managert bdd_mgr;
 
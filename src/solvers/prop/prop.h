@@ -95,7 +95,15 @@ public:
 
   // solving
   virtual const std::string solver_text()=0;
-  enum class resultt { P_SATISFIABLE, P_UNSATISFIABLE, P_ERROR };
+  /// P_UNKNOWN means that the solver gave up without an error, for example
+  /// on reaching a resource limit; it can be called again
+  enum class resultt
+  {
+    P_SATISFIABLE,
+    P_UNSATISFIABLE,
+    P_UNKNOWN,
+    P_ERROR
+  };
   resultt prop_solve();
 
   // satisfying assignment
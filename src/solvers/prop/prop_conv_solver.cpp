@@ -493,6 +493,9 @@ decision_proceduret::resultt prop_conv_solvert::dec_solve()
     return resultt::D_SATISFIABLE;
   case propt::resultt::P_UNSATISFIABLE:
     return resultt::D_UNSATISFIABLE;
+  case propt::resultt::P_UNKNOWN:
+    log.error() << "SAT checker gave up without a result" << messaget::eom;
+    return resultt::D_ERROR;
   case propt::resultt::P_ERROR:
     return resultt::D_ERROR;
   }
@@ -559,6 +562,7 @@ void prop_conv_solvert::push(const std::vector<exprt> &assumptions)
   for(const auto &assumption : assumptions)
     assumption_stack.push_back(to_literal_expr(assumption).get_literal());
   context_size_stack.push_back(assumptions.size());
+  fresh_context_stack.push_back(false);
 
   prop.set_assumptions(assumption_stack);
 }
@@ -571,15 +575,22 @@ void prop_conv_solvert::push()
 
   assumption_stack.push_back(context_literal);
   context_size_stack.push_back(1);
+  fresh_context_stack.push_back(true);
 
   prop.set_assumptions(assumption_stack);
 }
 
 void prop_conv_solvert::pop()
 {
+  // A context literal is never used again, which makes the constraints
+  // that it guards redundant.
+  if(fresh_context_stack.back())
+    prop.l_set_to_false(assumption_stack.back());
+
   // We remove the context from the stack.
   assumption_stack.resize(assumption_stack.size() - context_size_stack.back());
   context_size_stack.pop_back();
+  fresh_context_stack.pop_back();
 
   prop.set_assumptions(assumption_stack);
 }
@@ -55,16 +55,28 @@ public:
   literalt convert(const exprt &expr) override;
   bool is_in_conflict(const exprt &expr) const override;
 
+  /// \return true iff the solver takes assumptions and \ref is_in_conflict
+  ///   can tell which of them are in the final conflict
+  bool has_is_in_conflict() const
+  {
+    return prop.has_set_assumptions() && prop.has_is_in_conflict();
+  }
+
   /// For a Boolean expression \p expr, add the constraint
   /// 'current_context => expr' if \p value is `true`,
   /// otherwise add 'current_context => not expr'
   void set_to(const exprt &expr, bool value) override;
 
+  /// Push a context with a fresh context literal, which guards the
+  /// constraints added until the matching \ref pop
   void push() override;
 
   /// Push \p assumptions in form of `literal_exprt`
   void push(const std::vector<exprt> &assumptions) override;
 
+  /// Pop the top context; the fresh context literal of a context created by
+  /// \ref push() is set to false, so that the solver may discard the
+  /// constraints that it guards
   void pop() override;
 
   bool use_cache = true;
@@ -139,6 +151,9 @@ protected:
   /// Number of assumptions in each context on the stack
   std::vector<size_t> context_size_stack;
 
+  /// For each context on the stack, whether it was created by \ref push()
+  std::vector<bool> fresh_context_stack;
+
 private:
   /// Helper method used by `set_to` for adding the constraints to `prop`.
   /// This method is private because it must not be used by derived classes.
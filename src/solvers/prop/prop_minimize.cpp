@@ -13,14 +13,35 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/threeval.h>
 
+#include <util/std_expr.h>
+
+#include <algorithm>
+
 #include "literal_expr.h"
-#include "prop_conv.h"
+#include "prop_conv_solver.h"
 
 prop_minimizet::prop_minimizet(
   prop_convt &_prop_conv,
   message_handlert &message_handler)
-  : prop_conv(_prop_conv), log(message_handler)
+  : prop_conv(_prop_conv),
+    log(message_handler),
+    strategy(strategyt::LINEAR_SEARCH)
 {
+  const auto solver = dynamic_cast<const prop_conv_solvert *>(&prop_conv);
+
+  if(solver != nullptr && solver->has_is_in_conflict())
+    strategy = strategyt::CORE_GUIDED;
+}
+
+void prop_minimizet::set_strategy(strategyt _strategy)
+{
+  if(_strategy == strategyt::CORE_GUIDED)
+  {
+    const auto solver = dynamic_cast<const prop_conv_solvert *>(&prop_conv);
+    PRECONDITION(solver != nullptr && solver->has_is_in_conflict());
+  }
+
+  strategy = _strategy;
 }
 
 /// Add an objective
@@ -39,7 +60,8 @@ void prop_minimizet::objective(const literalt condition, const weightt weight)
 }
 
 /// Fix objectives that are satisfied
-void prop_minimizet::fix_objectives()
+/// \return true iff any objectives have been fixed
+bool prop_minimizet::fix_objectives()
 {
   std::vector<objectivet> &entry = current->second;
   bool found = false;
@@ -58,7 +80,7 @@ void prop_minimizet::fix_objectives()
     }
   }
 
-  POSTCONDITION(found);
+  return found;
 }
 
 /// Build constraints that require us to improve on at least one goal, greedily.
@@ -93,52 +115,208 @@ literalt prop_minimizet::constraint()
   }
 }
 
+/// Satisfy the objectives of the current weight greedily, one more at a
+/// time
+/// \return false iff the decision procedure failed
+bool prop_minimizet::linear_search()
+{
+  decision_proceduret::resultt dec_result;
+  do
+  {
+    // We want to improve on one of the objectives, please!
+    literalt c = constraint();
+
+    if(c.is_false())
+      dec_result = decision_proceduret::resultt::D_UNSATISFIABLE;
+    else
+    {
+      _iterations++;
+
+      prop_conv.push({literal_exprt{c}});
+      dec_result = prop_conv();
+
+      switch(dec_result)
+      {
+      case decision_proceduret::resultt::D_UNSATISFIABLE:
+        last_was_SAT = false;
+        break;
+
+      case decision_proceduret::resultt::D_SATISFIABLE:
+      {
+        last_was_SAT = true;
+        // fix the ones we got
+        const bool fixed = fix_objectives();
+        CHECK_RETURN(fixed);
+        break;
+      }
+
+      case decision_proceduret::resultt::D_ERROR:
+        log.error() << "decision procedure failed" << messaget::eom;
+        last_was_SAT = false;
+        return false;
+      }
+    }
+  } while(dec_result != decision_proceduret::resultt::D_UNSATISFIABLE);
+
+  return true;
+}
+
+/// Satisfy as many of the objectives of the current weight as possible:
+/// the negated conditions are assumed as soft constraints. Each core of
+/// soft constraints reported by the solver is relaxed by fresh literals,
+/// of which exactly one may be true, so that each core gives up one
+/// objective.
+/// \return false iff the decision procedure failed
+bool prop_minimizet::core_guided()
+{
+  const auto &solver = dynamic_cast<const prop_conv_solvert &>(prop_conv);
+
+  bvt soft;
+  for(auto &objective : current->second)
+  {
+    if(objective.fixed || objective.condition.is_true())
+    {
+      // a constant-true condition can never be satisfied, and would only
+      // turn up as a core of its own
+      continue;
+    }
+    else if(objective.condition.is_false())
+    {
+      // satisfied in every assignment, without asking the solver
+      _number_satisfied++;
+      _value += current->first;
+      objective.fixed = true;
+    }
+    else
+      soft.push_back(!objective.condition);
+  }
+
+  while(!soft.empty())
+  {
+    std::vector<exprt> assumptions;
+    assumptions.reserve(soft.size());
+    for(const auto &literal : soft)
+      assumptions.push_back(literal_exprt(literal));
+
+    _iterations++;
+
+    prop_conv.push(assumptions);
+    const decision_proceduret::resultt dec_result = prop_conv();
+
+    bvt core;
+    if(dec_result == decision_proceduret::resultt::D_UNSATISFIABLE)
+    {
+      for(const auto &literal : soft)
+      {
+        if(solver.is_in_conflict(literal_exprt(literal)))
+          core.push_back(literal);
+      }
+    }
+
+    prop_conv.pop();
+
+    switch(dec_result)
+    {
+    case decision_proceduret::resultt::D_SATISFIABLE:
+      last_was_SAT = true;
+      fix_objectives();
+      return true;
+
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+      last_was_SAT = false;
+      break;
+
+    case decision_proceduret::resultt::D_ERROR:
+      log.error() << "decision procedure failed" << messaget::eom;
+      last_was_SAT = false;
+      return false;
+    }
+
+    // the constraints are contradictory without any of the objectives
+    if(core.empty())
+    {
+      log.error() << "no satisfying assignment to minimize" << messaget::eom;
+      return false;
+    }
+
+    if(core.size() == 1)
+    {
+      // this one cannot be satisfied at all
+      soft.erase(std::find(soft.begin(), soft.end(), core.front()));
+      continue;
+    }
+
+    bvt relaxation;
+    relaxation.reserve(core.size());
+
+    for(auto &literal : soft)
+    {
+      if(std::find(core.begin(), core.end(), literal) == core.end())
+        continue;
+
+      relaxation.push_back(new_relaxation_literal());
+      literal = prop_conv.convert(
+        or_exprt(literal_exprt(literal), literal_exprt(relaxation.back())));
+    }
+
+    exactly_one(relaxation);
+  }
+
+  return true;
+}
+
+literalt prop_minimizet::new_relaxation_literal()
+{
+  return prop_conv.convert(symbol_exprt(
+    "prop_minimize::relaxation" + std::to_string(relaxation_counter++),
+    bool_typet()));
+}
+
+/// Constrains exactly one of \p literals to be true, using a sequential
+/// counter for the at-most-one part
+void prop_minimizet::exactly_one(const bvt &literals)
+{
+  exprt::operandst disjuncts;
+  disjuncts.reserve(literals.size());
+  for(const auto &literal : literals)
+    disjuncts.push_back(literal_exprt(literal));
+
+  prop_conv.set_to_true(disjunction(disjuncts));
+
+  // any_before is true iff any of the literals before the current one is
+  literalt any_before = literals.front();
+
+  for(std::size_t i = 1; i < literals.size(); i++)
+  {
+    prop_conv.set_to_false(
+      and_exprt(literal_exprt(any_before), literal_exprt(literals[i])));
+
+    if(i + 1 < literals.size())
+    {
+      any_before = prop_conv.convert(
+        or_exprt(literal_exprt(any_before), literal_exprt(literals[i])));
+    }
+  }
+}
+
 /// Try to cover all objectives
 void prop_minimizet::operator()()
 {
   _iterations = 0;
   _number_satisfied = 0;
   _value = 0;
-  bool last_was_SAT = false;
+  last_was_SAT = false;
 
   // go from high weights to low ones
   for(current = objectives.rbegin(); current != objectives.rend(); current++)
   {
     log.status() << "weight " << current->first << messaget::eom;
 
-    decision_proceduret::resultt dec_result;
-    do
-    {
-      // We want to improve on one of the objectives, please!
-      literalt c = constraint();
+    const bool success = strategy == strategyt::CORE_GUIDED ? core_guided()
+                                                            : linear_search();
 
-      if(c.is_false())
-        dec_result = decision_proceduret::resultt::D_UNSATISFIABLE;
-      else
-      {
-        _iterations++;
-
-        prop_conv.push({literal_exprt{c}});
-        dec_result = prop_conv();
-
-        switch(dec_result)
-        {
-        case decision_proceduret::resultt::D_UNSATISFIABLE:
-          last_was_SAT = false;
-          break;
-
-        case decision_proceduret::resultt::D_SATISFIABLE:
-          last_was_SAT = true;
-          fix_objectives(); // fix the ones we got
-          break;
-
-        case decision_proceduret::resultt::D_ERROR:
-          log.error() << "decision procedure failed" << messaget::eom;
-          last_was_SAT = false;
-          return;
-        }
-      }
-    } while(dec_result != decision_proceduret::resultt::D_UNSATISFIABLE);
+    if(!success)
+      return;
   }
 
   if(!last_was_SAT)
@@ -146,7 +324,9 @@ void prop_minimizet::operator()()
     // We don't have a satisfying assignment to work with.
     // Run solver again to get one.
 
-    prop_conv.pop();
+    if(strategy == strategyt::LINEAR_SEARCH)
+      prop_conv.pop();
+
     (void)prop_conv();
   }
 }
@@ -29,6 +29,30 @@ public:
 
   void operator()();
 
+  /// The objectives are treated one weight at a time, from the highest
+  /// weight to the lowest one. The strategies differ in how the objectives
+  /// of one weight are satisfied.
+  enum class strategyt
+  {
+    /// require one more objective to be satisfied, until the solver fails
+    /// to do so; this yields a maximal set of satisfied objectives
+    LINEAR_SEARCH,
+    /// assume all objectives to be satisfied, and relax the unsatisfiable
+    /// cores reported by the solver (Fu-Malik); this yields a set of
+    /// satisfied objectives of maximum size, and needs as many solver calls
+    /// as there are cores
+    CORE_GUIDED
+  };
+
+  /// The default is \ref strategyt::CORE_GUIDED where the decision procedure
+  /// can report the assumptions in the final conflict
+  void set_strategy(strategyt _strategy);
+
+  strategyt get_strategy() const
+  {
+    return strategy;
+  }
+
   // statistics
 
   std::size_t number_satisfied() const
@@ -75,9 +99,18 @@ protected:
   weightt _value = 0;
   prop_convt &prop_conv;
   messaget log;
+  strategyt strategy;
+  bool last_was_SAT = false;
 
   literalt constraint();
-  void fix_objectives();
+  bool fix_objectives();
+
+  bool linear_search();
+  bool core_guided();
+
+  literalt new_relaxation_literal();
+  void exactly_one(const bvt &literals);
+  std::size_t relaxation_counter = 0;
 
   objectivest::reverse_iterator current;
 };
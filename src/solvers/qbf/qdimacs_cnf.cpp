@@ -101,7 +101,7 @@ void qdimacs_cnft::copy_to(qdimacs_cnft &cnf) const
       it=clauses.begin();
       it!=clauses.end();
       it++)
-    cnf.lcnf(*it);
+    cnf.lcnf(bvt(it->begin(), it->end()));
 }
 
 size_t qdimacs_cnft::hash() const
@@ -28,6 +28,8 @@ private:
     bool refine_arrays=true;
     /// Enable arithmetic refinement
     bool refine_arithmetic=true;
+    /// Enable refinement of floating-point arithmetic
+    bool refine_floatbv = true;
   };
 public:
   struct infot:public configt
@@ -96,6 +98,7 @@ private:
   void check_SAT(approximationt &approximation);
   void check_UNSAT(approximationt &approximation);
   void initialize(approximationt &approximation);
+  void add_floatbv_partial_interpretation(approximationt &approximation);
   void get_values(approximationt &approximation);
   void check_SAT();
   void check_UNSAT();
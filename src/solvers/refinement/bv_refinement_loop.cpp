@@ -110,6 +110,7 @@ decision_proceduret::resultt bv_refinementt::prop_solve()
   {
   case propt::resultt::P_SATISFIABLE: return resultt::D_SATISFIABLE;
   case propt::resultt::P_UNSATISFIABLE: return resultt::D_UNSATISFIABLE;
+  case propt::resultt::P_UNKNOWN: return resultt::D_ERROR;
   case propt::resultt::P_ERROR: return resultt::D_ERROR;
   }
   // clang-format off
@@ -123,6 +124,13 @@ void bv_refinementt::check_SAT()
 
   arrays_overapproximated();
 
+  if(
+    array_theory == array_theoryt::WEAK_EQUIVALENCE &&
+    add_weak_equivalence_lemmas())
+  {
+    progress = true;
+  }
+
   // get values before modifying the formula
   for(approximationt &approximation : this->approximations)
     get_values(approximation);
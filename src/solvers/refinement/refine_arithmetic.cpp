@@ -38,17 +38,131 @@ void bv_refinementt::approximationt::add_under_assumption(literalt l)
 
 bvt bv_refinementt::convert_floatbv_op(const ieee_float_op_exprt &expr)
 {
-  if(!config_.refine_arithmetic)
+  if(!config_.refine_floatbv)
     return SUB::convert_floatbv_op(expr);
 
   if(expr.type().id() != ID_floatbv)
     return SUB::convert_floatbv_op(expr);
 
   bvt bv;
-  add_approximation(expr, bv);
+  approximationt &a = add_approximation(expr, bv);
+
+  // initially, we have a partial interpretation for special values
+  add_floatbv_partial_interpretation(a);
+
   return bv;
 }
 
+/// Constrain the result of the floating-point operation of \p a for the
+/// cases that do not depend on the rounding mode or the fractions of the
+/// operands: NaNs, infinities, zeros and the sign of products and quotients.
+/// This is exact, but far cheaper than the full circuit.
+void bv_refinementt::add_floatbv_partial_interpretation(approximationt &a)
+{
+  float_utilst float_utils(prop);
+  float_utils.spec = ieee_float_spect(to_floatbv_type(a.expr.type()));
+
+  const bvt &op0 = a.op0_bv;
+  bvt op1 = a.op1_bv;
+  const bvt &result = a.result_bv;
+
+  // a-b behaves as a+(-b)
+  if(a.expr.id() == ID_floatbv_minus)
+    op1.back() = !op1.back();
+
+  const literalt op0_nan = float_utils.is_NaN(op0);
+  const literalt op1_nan = float_utils.is_NaN(op1);
+  const literalt op0_inf = float_utils.is_infinity(op0);
+  const literalt op1_inf = float_utils.is_infinity(op1);
+  const literalt op0_zero = float_utils.is_zero(op0);
+  const literalt op1_zero = float_utils.is_zero(op1);
+  const literalt result_nan = float_utils.is_NaN(result);
+  const literalt result_inf = float_utils.is_infinity(result);
+  const literalt result_zero = float_utils.is_zero(result);
+
+  const literalt op0_number = prop.land(!op0_nan, !op0_inf);
+  const literalt op1_number = prop.land(!op1_nan, !op1_inf);
+
+  std::vector<std::pair<literalt, literalt>> implications;
+
+  // NaN operands yield NaN
+  implications.emplace_back(prop.lor(op0_nan, op1_nan), result_nan);
+
+  if(a.expr.id() == ID_floatbv_plus || a.expr.id() == ID_floatbv_minus)
+  {
+    const literalt op0_sign = float_utilst::sign_bit(op0);
+    const literalt op1_sign = float_utilst::sign_bit(op1);
+
+    // inf-inf is NaN
+    implications.emplace_back(
+      prop.land(
+        prop.land(op0_inf, op1_inf), prop.lxor(op0_sign, op1_sign)),
+      result_nan);
+
+    // x+inf is inf, and x+0 is x for non-zero x
+    const literalt op0_result = prop.lor(
+      prop.land(op0_inf, op1_number),
+      prop.land(op1_zero, prop.land(op0_number, !op0_zero)));
+    const literalt op1_result = prop.lor(
+      prop.land(op1_inf, op0_number),
+      prop.land(op0_zero, prop.land(op1_number, !op1_zero)));
+    implications.emplace_back(op0_result, bv_utils.equal(result, op0));
+    implications.emplace_back(op1_result, bv_utils.equal(result, op1));
+  }
+  else if(a.expr.id() == ID_floatbv_mult || a.expr.id() == ID_floatbv_div)
+  {
+    const bool is_mult = a.expr.id() == ID_floatbv_mult;
+
+    // the sign of any number is the exclusive-or of the signs
+    implications.emplace_back(
+      !result_nan,
+      prop.lequal(
+        float_utilst::sign_bit(result),
+        prop.lxor(float_utilst::sign_bit(op0), float_utilst::sign_bit(op1))));
+
+    if(is_mult)
+    {
+      // 0*inf is NaN
+      implications.emplace_back(
+        prop.lor(prop.land(op0_zero, op1_inf), prop.land(op0_inf, op1_zero)),
+        result_nan);
+      // 0*x is 0 for finite x
+      implications.emplace_back(
+        prop.lor(
+          prop.land(op0_zero, op1_number), prop.land(op1_zero, op0_number)),
+        result_zero);
+      // inf*x is inf for non-zero x
+      implications.emplace_back(
+        prop.lor(
+          prop.land(op0_inf, prop.land(!op1_nan, !op1_zero)),
+          prop.land(op1_inf, prop.land(!op0_nan, !op0_zero))),
+        result_inf);
+    }
+    else
+    {
+      // 0/0 and inf/inf are NaN
+      implications.emplace_back(
+        prop.lor(prop.land(op0_zero, op1_zero), prop.land(op0_inf, op1_inf)),
+        result_nan);
+      // 0/x for non-zero x and x/inf for finite x are 0
+      implications.emplace_back(
+        prop.lor(
+          prop.land(op0_zero, prop.land(!op1_nan, !op1_zero)),
+          prop.land(op1_inf, op0_number)),
+        result_zero);
+      // inf/x for finite x and x/0 for non-zero x are inf
+      implications.emplace_back(
+        prop.lor(
+          prop.land(op0_inf, op1_number),
+          prop.land(op1_zero, prop.land(!op0_nan, !op0_zero))),
+        result_inf);
+    }
+  }
+
+  for(const auto &implication : implications)
+    prop.l_set_to_true(prop.limplies(implication.first, implication.second));
+}
+
 bvt bv_refinementt::convert_mult(const mult_exprt &expr)
 {
   if(!config_.refine_arithmetic || expr.type().id()==ID_fixedbv)
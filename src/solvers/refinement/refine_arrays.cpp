@@ -20,6 +20,13 @@ Author: Daniel Kroening, kroening@kroening.com
 /// generate array constraints
 void bv_refinementt::post_process_arrays()
 {
+  // lemmas are added in check_SAT
+  if(array_theory == array_theoryt::WEAK_EQUIVALENCE)
+  {
+    arrayst::post_process_arrays();
+    return;
+  }
+
   collect_indices();
   // at this point all indices should in the index set
 
@@ -79,17 +86,18 @@ void bv_refinementt::arrays_overapproximated()
     exprt simplified=get(current);
     solver << simplified;
 
-    switch(static_cast<decision_proceduret::resultt>(sat_check.prop_solve()))
+    switch(sat_check.prop_solve())
     {
-    case decision_proceduret::resultt::D_SATISFIABLE:
+    case propt::resultt::P_SATISFIABLE:
       ++it;
       break;
-    case decision_proceduret::resultt::D_UNSATISFIABLE:
+    case propt::resultt::P_UNSATISFIABLE:
       prop.l_set_to_true(convert(current));
       nb_active++;
       lazy_array_constraints.erase(it++);
       break;
-    case decision_proceduret::resultt::D_ERROR:
+    case propt::resultt::P_UNKNOWN:
+    case propt::resultt::P_ERROR:
       INVARIANT(false, "error in array over approximation check");
     }
   }
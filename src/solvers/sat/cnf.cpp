@@ -276,8 +276,10 @@ literalt cnft::land(literalt a, literalt b)
   if(a==b)
     return a;
 
-  literalt o=new_variable();
-  gate_and(a, b, o);
+  literalt o = polarity_aware ? defer_gate(deferred_gatet::kindt::AND, a, b)
+                              : new_variable();
+  if(!polarity_aware)
+    gate_and(a, b, o);
   relate(a, o);
   relate(b, o);
   return o;
@@ -294,8 +296,10 @@ literalt cnft::lor(literalt a, literalt b)
   if(a==b)
     return a;
 
-  literalt o=new_variable();
-  gate_or(a, b, o);
+  literalt o = polarity_aware ? defer_gate(deferred_gatet::kindt::OR, a, b)
+                              : new_variable();
+  if(!polarity_aware)
+    gate_or(a, b, o);
   relate(a, o);
   relate(b, o);
   return o;
@@ -371,6 +375,15 @@ literalt cnft::lselect(literalt a, literalt b, literalt c)
 
   // (a+c'+o) (a+c+o') (a'+b'+o) (a'+b+o')
 
+  if(polarity_aware)
+  {
+    literalt o = defer_gate(deferred_gatet::kindt::SELECT, a, b, c);
+    relate(a, o);
+    relate(b, o);
+    relate(c, o);
+    return o;
+  }
+
   literalt o=new_variable();
 
   relate(a, o);
@@ -533,6 +546,204 @@ void cnft::lcnf(const bvt &bv)
   relationless_lcnf(bv);
 }
 
+literalt cnft::defer_gate(
+  deferred_gatet::kindt kind,
+  literalt a,
+  literalt b,
+  literalt c)
+{
+  const literalt o = new_variable();
+
+  if(deferred_gates.size() <= o.var_no())
+    deferred_gates.resize(o.var_no() + 1);
+
+  deferred_gatet &gate = deferred_gates[o.var_no()];
+  gate.kind = kind;
+  gate.a = a;
+  gate.b = b;
+  gate.c = c;
+  ++number_of_deferred_gates;
+
+  return o;
+}
+
+void cnft::encode_polarities(const bvt &bv)
+{
+  // the clauses emitted here must not trigger this again, as their literal
+  // of the gate output must not be encoded in the opposite polarity; they
+  // use a local vector, as bv may be lcnf_bv
+  if(!polarity_aware || encoding_deferred_gates)
+    return;
+
+  encoding_deferred_gates = true;
+
+  bvt required = bv;
+  bvt lits;
+
+  while(!required.empty())
+  {
+    const literalt l = required.back();
+    required.pop_back();
+
+    if(!is_deferred_gate(l))
+      continue;
+
+    deferred_gatet &gate = deferred_gates[l.var_no()];
+    const unsigned char polarity = l.sign() ? 2 : 1;
+    if(gate.encoded & polarity)
+      continue;
+
+    gate.encoded |= polarity;
+    ++number_of_encoded_polarities;
+
+    const literalt o(l.var_no(), false);
+    const literalt a = gate.a, b = gate.b, c = gate.c;
+
+    switch(gate.kind)
+    {
+    case deferred_gatet::kindt::AND:
+      if(!l.sign())
+      {
+        // o -> a, o -> b
+        lits = {!o, a};
+        relationless_lcnf(lits);
+        lits = {!o, b};
+        relationless_lcnf(lits);
+        required.insert(required.end(), {a, b});
+      }
+      else
+      {
+        // a & b -> o
+        lits = {!a, !b, o};
+        relationless_lcnf(lits);
+        required.insert(required.end(), {!a, !b});
+      }
+      break;
+
+    case deferred_gatet::kindt::OR:
+      if(!l.sign())
+      {
+        // o -> a | b
+        lits = {a, b, !o};
+        relationless_lcnf(lits);
+        required.insert(required.end(), {a, b});
+      }
+      else
+      {
+        // a -> o, b -> o
+        lits = {!a, o};
+        relationless_lcnf(lits);
+        lits = {!b, o};
+        relationless_lcnf(lits);
+        required.insert(required.end(), {!a, !b});
+      }
+      break;
+
+    case deferred_gatet::kindt::SELECT:
+      if(!l.sign())
+      {
+        // o -> (a ? b : c)
+        lits = {!a, b, !o};
+        relationless_lcnf(lits);
+        lits = {a, c, !o};
+        relationless_lcnf(lits);
+        required.insert(required.end(), {a, !a, b, c});
+      }
+      else
+      {
+        // (a ? b : c) -> o
+        lits = {!a, !b, o};
+        relationless_lcnf(lits);
+        lits = {a, !c, o};
+        relationless_lcnf(lits);
+        required.insert(required.end(), {a, !a, !b, !c});
+      }
+      break;
+
+    case deferred_gatet::kindt::NONE:
+      UNREACHABLE;
+    }
+  }
+
+  encoding_deferred_gates = false;
+}
+
+tvt cnft::deferred_gate_value(
+  literalt l,
+  const std::function<tvt(literalt)> &model_value) const
+{
+  if(!is_deferred_gate(l))
+    return model_value(l);
+
+  auto value = [this](literalt op) {
+    if(op.is_constant())
+      return tvt(op.is_true());
+    const tvt v = deferred_gate_values.at(op.var_no());
+    return op.sign() ? !v : v;
+  };
+
+  std::vector<literalt::var_not> stack{l.var_no()};
+
+  while(!stack.empty())
+  {
+    const literalt::var_not v = stack.back();
+
+    if(deferred_gate_values.find(v) != deferred_gate_values.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    const literalt o(v, false);
+    if(!is_deferred_gate(o) || deferred_gates[v].encoded == 3)
+    {
+      // gates encoded in both polarities have encoded cones
+      deferred_gate_values[v] = model_value(o);
+      stack.pop_back();
+      continue;
+    }
+
+    const deferred_gatet &gate = deferred_gates[v];
+    bool pending = false;
+    for(const literalt &op : {gate.a, gate.b, gate.c})
+    {
+      if(
+        op.var_no() != literalt::unused_var_no() && !op.is_constant() &&
+        deferred_gate_values.find(op.var_no()) == deferred_gate_values.end())
+      {
+        stack.push_back(op.var_no());
+        pending = true;
+      }
+    }
+
+    if(pending)
+      continue;
+
+    tvt result;
+    switch(gate.kind)
+    {
+    case deferred_gatet::kindt::AND:
+      result = value(gate.a) && value(gate.b);
+      break;
+    case deferred_gatet::kindt::OR:
+      result = value(gate.a) || value(gate.b);
+      break;
+    case deferred_gatet::kindt::SELECT:
+      result = (value(gate.a) && value(gate.b)) ||
+               (!value(gate.a) && value(gate.c));
+      break;
+    case deferred_gatet::kindt::NONE:
+      UNREACHABLE;
+    }
+
+    deferred_gate_values[v] = result;
+    stack.pop_back();
+  }
+
+  const tvt result = deferred_gate_values[l.var_no()];
+  return l.sign() ? !result : result;
+}
+
 literalt cnft::wrap(const literalt &literal)
 {
   if(literal.is_constant())
@@ -12,6 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_CNF_H
 #define CPROVER_SOLVERS_SAT_CNF_H
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 #include <solvers/prop/prop.h>
 
 class cnft:public propt
@@ -57,6 +61,22 @@ public:
 
   literalt wrap(const literalt &literal) override;
 
+  /// Use a polarity-aware (Plaisted-Greenbaum) encoding for the gates
+  /// created by \ref land, \ref lor and \ref lselect on two or three
+  /// literals: their clauses are only emitted once the output of a gate is
+  /// used in a clause, an assumption or frozen, and only for the polarity in
+  /// which it is used. This has no effect unless the solver supports it, see
+  /// \ref has_polarity_aware_encoding.
+  void set_polarity_aware_encoding(bool value)
+  {
+    polarity_aware = value && has_polarity_aware_encoding();
+  }
+
+  virtual bool has_polarity_aware_encoding() const
+  {
+    return false;
+  }
+
 protected:
   void gate_and(literalt a, literalt b, literalt o);
   void gate_or(literalt a, literalt b, literalt o);
@@ -85,6 +105,61 @@ protected:
 
   bool supports_relations;
 
+  bool polarity_aware = false;
+
+  /// A gate whose clauses have not been emitted, or only for one polarity
+  struct deferred_gatet
+  {
+    enum class kindt : unsigned char
+    {
+      NONE,
+      AND,
+      OR,
+      SELECT
+    };
+
+    literalt a, b, c;
+    kindt kind = kindt::NONE;
+    // bit 0: o -> gate(a, b, c) is encoded, bit 1: gate(a, b, c) -> o is
+    unsigned char encoded = 0;
+  };
+
+  /// The deferred gates, indexed by the variable number of their output
+  std::vector<deferred_gatet> deferred_gates;
+  std::size_t number_of_deferred_gates = 0;
+  std::size_t number_of_encoded_polarities = 0;
+  bool encoding_deferred_gates = false;
+
+  literalt defer_gate(
+    deferred_gatet::kindt kind,
+    literalt a,
+    literalt b,
+    literalt c = literalt());
+
+  bool is_deferred_gate(literalt l) const
+  {
+    return !l.is_constant() && l.var_no() < deferred_gates.size() &&
+           deferred_gates[l.var_no()].kind != deferred_gatet::kindt::NONE;
+  }
+
+  /// Solvers that support polarity-aware encoding call this for the literals
+  /// of each clause that is added, for each assumption, and for both
+  /// polarities of each frozen literal. It emits the clauses of the deferred
+  /// gates that are required for the polarities in which the literals occur.
+  void encode_polarities(const bvt &bv);
+
+  /// Values of the deferred gates in the last model, see
+  /// \ref deferred_gate_value; to be cleared when solving
+  mutable std::unordered_map<literalt::var_not, tvt> deferred_gate_values;
+
+  /// The value of \p l in a model. The solver may assign any value to the
+  /// output of a gate that is not encoded in both polarities, as long as
+  /// the constraints are satisfied, which is why the value is recomputed
+  /// from the inputs of such gates, and taken from \p model_value otherwise.
+  tvt deferred_gate_value(
+    literalt l,
+    const std::function<tvt(literalt)> &model_value) const;
+
   bool process_clause(const bvt &bv, bvt &dest) const;
 
   static bool is_all(const bvt &bv, literalt l)
@@ -20,12 +20,10 @@ bool output_relations_setting() {
 
 void cnf_clause_listt::relationless_lcnf(const bvt &bv)
 {
-  bvt new_bv;
-
-  if(process_clause(bv, new_bv))
+  if(process_clause(bv, processed_clause))
     return;
 
-  clauses.push_back(new_bv);
+  clauses.push_back(processed_clause);
 }
 
 void cnf_clause_list_assignmentt::print_assignment(std::ostream &out) const
@@ -12,8 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_CNF_CLAUSE_LIST_H
 #define CPROVER_SOLVERS_SAT_CNF_CLAUSE_LIST_H
 
-#include <list>
-
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <util/threeval.h>
 
@@ -33,6 +33,187 @@ private:
   std::vector<std::vector<literalt::var_not>> relations;
 };
 
+/// A sequence of clauses stored in one buffer of literals, with the offset of
+/// the first literal of each clause, rather than one allocation per clause
+class clause_arenat
+{
+public:
+  /// The literals of a clause, which are valid until the next change to the
+  /// arena
+  class clauset
+  {
+  public:
+    clauset(const literalt *_first, const literalt *_last)
+      : first(_first), last(_last)
+    {
+    }
+
+    // NOLINTNEXTLINE(runtime/explicit)
+    clauset(const bvt &bv) : first(bv.data()), last(bv.data() + bv.size())
+    {
+    }
+
+    const literalt *begin() const
+    {
+      return first;
+    }
+
+    const literalt *end() const
+    {
+      return last;
+    }
+
+    std::size_t size() const
+    {
+      return last - first;
+    }
+
+    bool empty() const
+    {
+      return first == last;
+    }
+
+    const literalt &operator[](std::size_t i) const
+    {
+      return first[i];
+    }
+
+    const literalt *data() const
+    {
+      return first;
+    }
+
+  protected:
+    const literalt *first;
+    const literalt *last;
+  };
+
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef clauset value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const clauset *pointer;
+    typedef const clauset &reference;
+
+    const_iterator(const clause_arenat &_arena, std::size_t _index)
+      : arena(&_arena), index(_index), clause(nullptr, nullptr)
+    {
+    }
+
+    reference operator*() const
+    {
+      clause = (*arena)[index];
+      return clause;
+    }
+
+    pointer operator->() const
+    {
+      return &**this;
+    }
+
+    const_iterator &operator++()
+    {
+      ++index;
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator result = *this;
+      ++index;
+      return result;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return index == other.index;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return index != other.index;
+    }
+
+  protected:
+    const clause_arenat *arena;
+    std::size_t index;
+    mutable clauset clause;
+  };
+
+  typedef const_iterator iterator;
+
+  void push_back(clauset clause)
+  {
+    const std::less<const literalt *> before;
+    const literalt *base = literals.data();
+
+    if(
+      !clause.empty() && !before(clause.begin(), base) &&
+      before(clause.begin(), base + literals.size()))
+    {
+      // A clause of this arena: inserting a range of the vector into itself
+      // is undefined, and growing it would move the clause. Reserving first
+      // keeps the literals in place while they are appended by position.
+      const std::size_t first = clause.begin() - base;
+      const std::size_t last = first + clause.size();
+      literals.reserve(literals.size() + clause.size());
+      for(std::size_t i = first; i < last; ++i)
+        literals.push_back(literals[i]);
+    }
+    else
+      literals.insert(literals.end(), clause.begin(), clause.end());
+
+    offsets.push_back(literals.size());
+  }
+
+  clauset operator[](std::size_t i) const
+  {
+    const literalt *base = literals.data();
+    return clauset(
+      base + (i == 0 ? 0 : offsets[i - 1]), base + offsets[i]);
+  }
+
+  std::size_t size() const
+  {
+    return offsets.size();
+  }
+
+  bool empty() const
+  {
+    return offsets.empty();
+  }
+
+  void clear()
+  {
+    literals.clear();
+    offsets.clear();
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(*this, 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(*this, size());
+  }
+
+  bool operator==(const clause_arenat &other) const
+  {
+    return literals == other.literals && offsets == other.offsets;
+  }
+
+protected:
+  /// The literals of all clauses, one after the other
+  bvt literals;
+
+  /// For each clause the offset in \ref literals after its last literal
+  std::vector<std::size_t> offsets;
+};
+
 // CNF given as a list of clauses
 
 class cnf_clause_listt:public cnft
@@ -57,7 +238,7 @@ public:
     return clauses.size();
   }
 
-  typedef std::list<bvt> clausest;
+  typedef clause_arenat clausest;
 
   clausest &get_clauses() { return clauses; }
 
@@ -68,13 +249,13 @@ public:
         it=clauses.begin();
         it!=clauses.end();
         it++)
-      cnf.lcnf(*it);
+      cnf.lcnf(bvt(it->begin(), it->end()));
   }
 
-  static size_t hash_clause(const bvt &bv)
+  static size_t hash_clause(const clause_arenat::clauset &bv)
   {
     size_t result=0;
-    for(bvt::const_iterator it=bv.begin(); it!=bv.end(); it++)
+    for(const literalt *it=bv.begin(); it!=bv.end(); it++)
       result=((result<<2)^it->get())-result;
 
     return result;
@@ -106,6 +287,9 @@ protected:
 
   clausest clauses;
   relationst relations;
+
+  /// Reused for the simplified clause by relationless_lcnf
+  bvt processed_clause;
   bool output_relations;
 };
 
@@ -0,0 +1,657 @@
+/*******************************************************************\
+
+Module: CNF Preprocessing for SAT Solvers without a Simplifier
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// CNF Preprocessing for SAT Solvers without a Simplifier
+
+#include "cnf_preprocessor.h"
+
+#include <util/invariant.h>
+
+#include <algorithm>
+#include <limits>
+
+/// Variables with more than this many pairs of clauses to resolve are not
+/// eliminated
+static const std::size_t max_resolution_pairs = 1000;
+
+/// Variables are not eliminated if a resolvent has more literals than this
+static const std::size_t max_resolvent_size = 20;
+
+/// Number of literal comparisons that subsumption checking may take
+static const std::size_t subsumption_budget = 100000000;
+
+cnf_preprocessort::cnf_preprocessort(
+  std::unique_ptr<propt> solver,
+  message_handlert &message_handler)
+  : cnf_solvert(message_handler), solver(std::move(solver))
+{
+}
+
+void cnf_preprocessort::lcnf(const bvt &bv)
+{
+  bvt clause;
+
+  if(process_clause(bv, clause))
+    return;
+
+  clause_counter++;
+
+  if(preprocessed)
+    add_to_solver(clause);
+  else
+    clauses.push_back(std::move(clause));
+}
+
+tvt cnf_preprocessort::l_get(literalt a) const
+{
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  if(a.var_no() >= model.size())
+    return solver->l_get(a);
+
+  const tvt value = model[a.var_no()];
+  return a.sign() ? !value : value;
+}
+
+void cnf_preprocessort::set_assignment(literalt a, bool value)
+{
+  if(preprocessed && !a.is_constant())
+    restore(a.var_no());
+
+  solver->set_assignment(a, value);
+}
+
+void cnf_preprocessort::set_assumptions(const bvt &_assumptions)
+{
+  assumptions = _assumptions;
+}
+
+void cnf_preprocessort::set_frozen(literalt a)
+{
+  if(a.is_constant())
+    return;
+
+  if(!preprocessed)
+  {
+    if(frozen.size() <= a.var_no())
+      frozen.resize(a.var_no() + 1, false);
+    frozen[a.var_no()] = true;
+  }
+  else
+    restore(a.var_no());
+
+  if(solver->no_variables() < no_variables())
+    solver->new_variables(no_variables() - solver->no_variables());
+  solver->set_frozen(a);
+}
+
+propt::resultt cnf_preprocessort::do_prop_solve()
+{
+  model.clear();
+
+  if(!preprocessed)
+  {
+    preprocess();
+    preprocessed = true;
+  }
+
+  for(const auto &a : assumptions)
+  {
+    if(!a.is_constant())
+      restore(a.var_no());
+  }
+
+  if(solver->no_variables() < no_variables())
+    solver->new_variables(no_variables() - solver->no_variables());
+
+  solver->set_assumptions(assumptions);
+  const resultt result = solver->prop_solve();
+
+  if(result == resultt::P_SATISFIABLE)
+  {
+    extend_model();
+    status = statust::SAT;
+  }
+  else if(result == resultt::P_UNSATISFIABLE)
+    status = statust::UNSAT;
+  else
+    status = statust::ERROR;
+
+  if(restored != 0)
+  {
+    log.statistics() << "CNF preprocessing: " << restored
+                     << " removed variables restored" << messaget::eom;
+  }
+
+  return result;
+}
+
+void cnf_preprocessort::preprocess()
+{
+  frozen.resize(no_variables(), false);
+  for(const auto &a : assumptions)
+  {
+    if(!a.is_constant())
+      frozen[a.var_no()] = true;
+  }
+
+  removal_index.assign(
+    no_variables(), std::numeric_limits<std::size_t>::max());
+
+  const std::size_t clauses_before = clauses.size();
+
+  substitute_equivalences();
+  remove_subsumed_clauses();
+  eliminate_variables();
+
+  log.statistics() << "CNF preprocessing: " << substituted
+                   << " variables substituted, " << eliminated
+                   << " variables eliminated, " << subsumed
+                   << " clauses subsumed, " << clauses_before << " -> "
+                   << clauses.size() << " clauses" << messaget::eom;
+
+  for(const auto &clause : clauses)
+    add_to_solver(clause);
+
+  clauses.clear();
+  clauses.shrink_to_fit();
+}
+
+void cnf_preprocessort::substitute_equivalences()
+{
+  const std::size_t number_of_literals = 2 * no_variables();
+
+  // the binary implication graph, with the literals as nodes, numbered by
+  // literalt::get()
+  std::vector<std::vector<unsigned>> implications(number_of_literals);
+  bool has_binary_clauses = false;
+
+  for(const auto &clause : clauses)
+  {
+    if(clause.size() == 2)
+    {
+      implications[(!clause[0]).get()].push_back(clause[1].get());
+      implications[(!clause[1]).get()].push_back(clause[0].get());
+      has_binary_clauses = true;
+    }
+  }
+
+  if(!has_binary_clauses)
+    return;
+
+  // Tarjan's algorithm for strongly connected components, without recursion
+  const unsigned unvisited = std::numeric_limits<unsigned>::max();
+  std::vector<unsigned> index(number_of_literals, unvisited);
+  std::vector<unsigned> lowlink(number_of_literals);
+  std::vector<unsigned> component(number_of_literals, unvisited);
+  std::vector<unsigned> stack;
+  std::vector<std::pair<unsigned, std::size_t>> call_stack;
+  unsigned next_index = 0, next_component = 0;
+
+  // the literal that each variable is replaced by
+  std::vector<literalt> replacement(no_variables());
+  std::vector<bool> is_replaced(no_variables(), false);
+
+  for(unsigned root = 2; root < number_of_literals; root++)
+  {
+    if(index[root] != unvisited)
+      continue;
+
+    call_stack.emplace_back(root, 0);
+    index[root] = lowlink[root] = next_index++;
+    stack.push_back(root);
+
+    while(!call_stack.empty())
+    {
+      const unsigned node = call_stack.back().first;
+      std::size_t &edge = call_stack.back().second;
+
+      if(edge < implications[node].size())
+      {
+        const unsigned successor = implications[node][edge++];
+
+        if(index[successor] == unvisited)
+        {
+          index[successor] = lowlink[successor] = next_index++;
+          stack.push_back(successor);
+          call_stack.emplace_back(successor, 0);
+        }
+        else if(component[successor] == unvisited)
+          lowlink[node] = std::min(lowlink[node], index[successor]);
+
+        continue;
+      }
+
+      call_stack.pop_back();
+      if(!call_stack.empty())
+      {
+        const unsigned parent = call_stack.back().first;
+        lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
+      }
+
+      if(lowlink[node] != index[node])
+        continue;
+
+      // node is the root of a component
+      std::vector<unsigned> members;
+      unsigned member;
+      do
+      {
+        member = stack.back();
+        stack.pop_back();
+        component[member] = next_component;
+        members.push_back(member);
+      } while(member != node);
+
+      const unsigned this_component = next_component++;
+
+      if(members.size() < 2)
+        continue;
+
+      // a literal that is equivalent to its negation makes the formula
+      // unsatisfiable, which is left to the solver
+      bool contradictory = false;
+      for(const unsigned m : members)
+        contradictory |= component[m ^ 1] == this_component;
+      if(contradictory)
+        continue;
+
+      // Prefer frozen variables as representatives, then the smallest one,
+      // which is the same choice for the component of the negations.
+      literalt representative(members.front() >> 1, members.front() & 1);
+      bool representative_frozen = frozen[representative.var_no()];
+      for(const unsigned m : members)
+      {
+        const literalt l(m >> 1, (m & 1) != 0);
+        const bool is_frozen = frozen[l.var_no()];
+
+        if(
+          (is_frozen && !representative_frozen) ||
+          (is_frozen == representative_frozen &&
+           l.var_no() < representative.var_no()))
+        {
+          representative = l;
+          representative_frozen = is_frozen;
+        }
+      }
+
+      for(const unsigned m : members)
+      {
+        const literalt l(m >> 1, (m & 1) != 0);
+        const literalt::var_not v = l.var_no();
+
+        if(v == representative.var_no() || frozen[v] || is_replaced[v])
+          continue;
+
+        replacement[v] = representative ^ l.sign();
+        is_replaced[v] = true;
+      }
+    }
+  }
+
+  std::size_t replaced_variables = 0;
+  for(literalt::var_not v = 1; v < no_variables(); v++)
+  {
+    if(is_replaced[v])
+    {
+      remove(v, replacement[v], {});
+      ++replaced_variables;
+    }
+  }
+
+  if(replaced_variables == 0)
+    return;
+
+  substituted += replaced_variables;
+
+  std::vector<bvt> substituted_clauses;
+  substituted_clauses.reserve(clauses.size());
+  bvt clause;
+
+  for(auto &original : clauses)
+  {
+    for(auto &l : original)
+    {
+      if(is_replaced[l.var_no()])
+        l = replacement[l.var_no()] ^ l.sign();
+    }
+
+    if(!process_clause(original, clause))
+      substituted_clauses.push_back(clause);
+  }
+
+  clauses.swap(substituted_clauses);
+}
+
+void cnf_preprocessort::remove_subsumed_clauses()
+{
+  std::vector<std::vector<std::size_t>> occurs(2 * no_variables());
+  for(std::size_t i = 0; i < clauses.size(); i++)
+  {
+    for(const auto &l : clauses[i])
+      occurs[l.get()].push_back(i);
+  }
+
+  std::vector<std::size_t> order(clauses.size());
+  for(std::size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  std::stable_sort(
+    order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+      return clauses[a].size() < clauses[b].size();
+    });
+
+  std::vector<bool> removed(clauses.size(), false);
+  std::vector<bool> mark(2 * no_variables(), false);
+  std::size_t budget = subsumption_budget;
+
+  for(const std::size_t i : order)
+  {
+    const bvt &clause = clauses[i];
+    if(removed[i] || clause.empty())
+      continue;
+
+    // the clauses subsumed by clause all contain its least frequent literal
+    literalt rarest = clause.front();
+    for(const auto &l : clause)
+    {
+      if(occurs[l.get()].size() < occurs[rarest.get()].size())
+        rarest = l;
+    }
+
+    for(const auto &l : clause)
+      mark[l.get()] = true;
+
+    for(const std::size_t j : occurs[rarest.get()])
+    {
+      if(j == i || removed[j] || clauses[j].size() < clause.size())
+        continue;
+
+      std::size_t contained = 0;
+      for(const auto &l : clauses[j])
+        contained += mark[l.get()];
+
+      if(contained == clause.size())
+      {
+        removed[j] = true;
+        ++subsumed;
+      }
+
+      budget -= std::min(budget, clauses[j].size());
+    }
+
+    for(const auto &l : clause)
+      mark[l.get()] = false;
+
+    if(budget == 0)
+      break;
+  }
+
+  std::size_t kept = 0;
+  for(std::size_t i = 0; i < clauses.size(); i++)
+  {
+    if(!removed[i])
+      clauses[kept++].swap(clauses[i]);
+  }
+  clauses.resize(kept);
+}
+
+void cnf_preprocessort::eliminate_variables()
+{
+  std::vector<std::vector<std::size_t>> occurs(2 * no_variables());
+  for(std::size_t i = 0; i < clauses.size(); i++)
+  {
+    for(const auto &l : clauses[i])
+      occurs[l.get()].push_back(i);
+  }
+
+  std::vector<literalt::var_not> candidates;
+  for(literalt::var_not v = 1; v < no_variables(); v++)
+  {
+    const literalt l(v, false);
+    if(
+      !frozen[v] && !is_removed(v) &&
+      (!occurs[l.get()].empty() || !occurs[(!l).get()].empty()))
+    {
+      candidates.push_back(v);
+    }
+  }
+
+  // variables with few occurrences are the cheapest to eliminate
+  std::stable_sort(
+    candidates.begin(),
+    candidates.end(),
+    [&occurs](literalt::var_not a, literalt::var_not b) {
+      return occurs[2 * a].size() + occurs[2 * a + 1].size() <
+             occurs[2 * b].size() + occurs[2 * b + 1].size();
+    });
+
+  std::vector<bool> removed(clauses.size(), false);
+  std::vector<bool> mark(2 * no_variables(), false);
+  std::vector<std::size_t> positive, negative;
+  std::vector<bvt> resolvents;
+
+  for(const literalt::var_not v : candidates)
+  {
+    const literalt l(v, false);
+
+    positive.clear();
+    for(const std::size_t i : occurs[l.get()])
+    {
+      if(!removed[i])
+        positive.push_back(i);
+    }
+
+    negative.clear();
+    for(const std::size_t i : occurs[(!l).get()])
+    {
+      if(!removed[i])
+        negative.push_back(i);
+    }
+
+    if(
+      (positive.empty() && negative.empty()) ||
+      positive.size() * negative.size() > max_resolution_pairs)
+    {
+      continue;
+    }
+
+    // the elimination must not increase the number of clauses
+    const std::size_t max_resolvents = positive.size() + negative.size();
+    resolvents.clear();
+    bool eliminate = true;
+
+    for(const std::size_t p : positive)
+    {
+      for(const auto &lit : clauses[p])
+        mark[lit.get()] = true;
+
+      for(const std::size_t n : negative)
+      {
+        bvt resolvent;
+        bool tautology = false;
+
+        for(const auto &lit : clauses[p])
+        {
+          if(lit != l)
+            resolvent.push_back(lit);
+        }
+
+        for(const auto &lit : clauses[n])
+        {
+          if(lit == !l || mark[lit.get()])
+            continue;
+
+          if(mark[(!lit).get()])
+          {
+            tautology = true;
+            break;
+          }
+
+          resolvent.push_back(lit);
+        }
+
+        if(tautology)
+          continue;
+
+        if(
+          resolvent.size() > max_resolvent_size ||
+          resolvents.size() == max_resolvents)
+        {
+          eliminate = false;
+          break;
+        }
+
+        std::sort(resolvent.begin(), resolvent.end());
+        resolvents.push_back(std::move(resolvent));
+      }
+
+      for(const auto &lit : clauses[p])
+        mark[lit.get()] = false;
+
+      if(!eliminate)
+        break;
+    }
+
+    if(!eliminate)
+      continue;
+
+    std::vector<bvt> removed_clauses;
+    removed_clauses.reserve(max_resolvents);
+    for(const auto &side : {positive, negative})
+    {
+      for(const std::size_t i : side)
+      {
+        removed[i] = true;
+        removed_clauses.push_back(clauses[i]);
+      }
+    }
+
+    remove(v, literalt(), std::move(removed_clauses));
+    ++eliminated;
+
+    for(auto &resolvent : resolvents)
+    {
+      for(const auto &lit : resolvent)
+        occurs[lit.get()].push_back(clauses.size());
+
+      clauses.push_back(std::move(resolvent));
+      removed.push_back(false);
+    }
+  }
+
+  std::size_t kept = 0;
+  for(std::size_t i = 0; i < clauses.size(); i++)
+  {
+    if(!removed[i])
+      clauses[kept++].swap(clauses[i]);
+  }
+  clauses.resize(kept);
+}
+
+void cnf_preprocessort::remove(
+  literalt::var_not var,
+  literalt representative,
+  std::vector<bvt> removed_clauses)
+{
+  removal_index[var] = removals.size();
+  removals.push_back({var, representative, std::move(removed_clauses), true});
+}
+
+void cnf_preprocessort::restore(literalt::var_not var)
+{
+  if(!is_removed(var))
+    return;
+
+  removalt &removal = removals[removal_index[var]];
+  removal.active = false;
+  ++restored;
+
+  // restoring the clauses may restore further variables
+  std::vector<bvt> removed_clauses;
+  removed_clauses.swap(removal.clauses);
+
+  if(removed_clauses.empty())
+  {
+    const literalt v(var, false);
+    add_to_solver({!v, removal.representative});
+    add_to_solver({v, !removal.representative});
+  }
+  else
+  {
+    for(const auto &clause : removed_clauses)
+      add_to_solver(clause);
+  }
+}
+
+void cnf_preprocessort::add_to_solver(const bvt &clause)
+{
+  for(const auto &l : clause)
+    restore(l.var_no());
+
+  if(solver->no_variables() < no_variables())
+    solver->new_variables(no_variables() - solver->no_variables());
+
+  solver->lcnf(clause);
+}
+
+void cnf_preprocessort::extend_model()
+{
+  model.assign(no_variables(), tvt(false));
+
+  for(literalt::var_not v = 1; v < no_variables(); v++)
+  {
+    if(!is_removed(v))
+    {
+      const tvt value = solver->l_get(literalt(v, false));
+      if(!value.is_unknown())
+        model[v] = value;
+    }
+  }
+
+  const auto value = [this](literalt l) {
+    return model[l.var_no()].is_true() != l.sign();
+  };
+
+  // a removed variable only occurs in the clauses of variables that were
+  // removed before it
+  for(auto it = removals.rbegin(); it != removals.rend(); ++it)
+  {
+    if(!it->active)
+      continue;
+
+    if(it->clauses.empty())
+    {
+      model[it->var] = tvt(value(it->representative));
+      continue;
+    }
+
+    // a clause with the positive literal that is not satisfied otherwise
+    // requires the variable to be true; the resolvents ensure that the
+    // clauses with the negative literal are then satisfied otherwise
+    const literalt positive(it->var, false);
+    model[it->var] = tvt(false);
+
+    for(const auto &clause : it->clauses)
+    {
+      if(std::find(clause.begin(), clause.end(), positive) == clause.end())
+        continue;
+
+      bool satisfied = false;
+      for(const auto &l : clause)
+        satisfied |= l != positive && value(l);
+
+      if(!satisfied)
+      {
+        model[it->var] = tvt(true);
+        break;
+      }
+    }
+  }
+}
@@ -0,0 +1,144 @@
+/*******************************************************************\
+
+Module: CNF Preprocessing for SAT Solvers without a Simplifier
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// CNF Preprocessing for SAT Solvers without a Simplifier
+
+#ifndef CPROVER_SOLVERS_SAT_CNF_PREPROCESSOR_H
+#define CPROVER_SOLVERS_SAT_CNF_PREPROCESSOR_H
+
+#include <memory>
+
+#include "cnf.h"
+
+/// A \ref cnft that collects the clauses until the first solver call, and
+/// simplifies them before handing them to an underlying solver:
+///  * variables that are equivalent according to the binary clauses are
+///    replaced by a representative;
+///  * clauses that are subsumed by other clauses are removed;
+///  * variables are eliminated by resolution, as long as this does not
+///    increase the number of clauses.
+///
+/// Frozen variables and the variables of the assumptions of the first solver
+/// call are kept. Clauses and assumptions that are added later and refer to
+/// a removed variable bring back the clauses that the removal replaced. The
+/// values of removed variables are reconstructed from the model of the
+/// underlying solver.
+///
+/// This gives solvers without preprocessing of their own, such as external
+/// solvers or IPASIR libraries, the benefit of the simplifications that
+/// MiniSat's SimpSolver performs.
+class cnf_preprocessort : public cnf_solvert
+{
+public:
+  cnf_preprocessort(
+    std::unique_ptr<propt> solver,
+    message_handlert &message_handler);
+
+  const std::string solver_text() override
+  {
+    return "CNF preprocessing + " + solver->solver_text();
+  }
+
+  void lcnf(const bvt &bv) override;
+
+  tvt l_get(literalt a) const override;
+  void set_assignment(literalt a, bool value) override;
+
+  void set_assumptions(const bvt &_assumptions) override;
+
+  bool has_set_assumptions() const override
+  {
+    return solver->has_set_assumptions();
+  }
+
+  bool is_in_conflict(literalt a) const override
+  {
+    return solver->is_in_conflict(a);
+  }
+
+  bool has_is_in_conflict() const override
+  {
+    return solver->has_is_in_conflict();
+  }
+
+  void set_frozen(literalt a) override;
+
+  void set_time_limit_seconds(uint32_t lim) override
+  {
+    solver->set_time_limit_seconds(lim);
+  }
+
+protected:
+  resultt do_prop_solve() override;
+
+  std::unique_ptr<propt> solver;
+
+  bvt assumptions;
+
+  /// The clauses until the first solver call
+  std::vector<bvt> clauses;
+  bool preprocessed = false;
+
+  /// Variables that preprocessing must keep, indexed by variable number
+  std::vector<bool> frozen;
+
+  /// A variable removed by preprocessing
+  struct removalt
+  {
+    literalt::var_not var;
+
+    /// For a substituted variable, the literal it is equivalent to
+    literalt representative;
+
+    /// For an eliminated variable, the clauses that contained it
+    std::vector<bvt> clauses;
+
+    /// False once the variable has been brought back
+    bool active;
+  };
+
+  /// The removed variables, in the order in which they were removed
+  std::vector<removalt> removals;
+
+  /// The index in \ref removals of each variable, or `removals.size()` and
+  /// above for those that are not removed
+  std::vector<std::size_t> removal_index;
+
+  /// Values of all variables in the last model, including the removed ones
+  std::vector<tvt> model;
+
+  bool is_removed(literalt::var_not v) const
+  {
+    return v < removal_index.size() && removal_index[v] < removals.size() &&
+           removals[removal_index[v]].active;
+  }
+
+  void preprocess();
+  void substitute_equivalences();
+  void remove_subsumed_clauses();
+  void eliminate_variables();
+
+  /// Records the removal of \p var
+  void remove(literalt::var_not var, literalt representative, std::vector<bvt>);
+
+  /// Brings back the removed variable \p var
+  void restore(literalt::var_not var);
+
+  /// Passes \p clause to the solver, bringing back its removed variables
+  void add_to_solver(const bvt &clause);
+
+  void extend_model();
+
+  std::size_t substituted = 0;
+  std::size_t eliminated = 0;
+  std::size_t subsumed = 0;
+  std::size_t restored = 0;
+};
+
+#endif // CPROVER_SOLVERS_SAT_CNF_PREPROCESSOR_H
@@ -9,10 +9,13 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "dimacs_cnf.h"
 
+#include <util/exception_utils.h>
 #include <util/invariant.h>
 #include <util/magic.h>
 
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 dimacs_cnft::dimacs_cnft(message_handlert &message_handler)
   : cnf_clause_listt(message_handler), break_lines(false)
@@ -56,7 +59,7 @@ void dimacs_cnft::write_problem_line(std::ostream &out)
 }
 
 void dimacs_cnft::write_dimacs_clause(
-  const bvt &clause,
+  const clause_arenat::clauset &clause,
   std::ostream &out,
   bool break_lines)
 {
@@ -102,6 +105,67 @@ void dimacs_cnft::write_clauses(std::ostream &out)
   out << output_block.str();
 }
 
+dimacs_cnf_streamt::dimacs_cnf_streamt(
+  std::ostream &_out,
+  message_handlert &message_handler)
+  : dimacs_cnft(message_handler), out(_out), problem_line_position(-1)
+{
+  if(&out != &std::cout)
+    problem_line_position = out.tellp();
+
+  if(problem_line_position != std::streampos(-1))
+    out << problem_line();
+  else
+  {
+    body_file = std::unique_ptr<temporary_filet>(
+      new temporary_filet("dimacs_cnf_", ".cnf"));
+    body.open((*body_file)());
+    if(!body)
+      throw system_exceptiont("failed to open " + (*body_file)());
+  }
+}
+
+std::string dimacs_cnf_streamt::problem_line() const
+{
+  // The counts are padded to a fixed width so that the final line can
+  // replace the one written before any clause.
+  std::ostringstream line;
+  line << "p cnf " << (no_variables() - 1) << " " << clause_count;
+  line << std::setw(std::streamsize(47 - line.str().size())) << ""
+       << "\n";
+  return line.str();
+}
+
+void dimacs_cnf_streamt::relationless_lcnf(const bvt &bv)
+{
+  bvt new_bv;
+
+  if(process_clause(bv, new_bv))
+    return;
+
+  write_dimacs_clause(new_bv, body_file ? body : out, break_lines);
+  ++clause_count;
+}
+
+void dimacs_cnf_streamt::write_dimacs_cnf(std::ostream &_out)
+{
+  PRECONDITION(&_out == &out);
+
+  if(body_file)
+  {
+    out << problem_line();
+    body.close();
+    std::ifstream clauses_in((*body_file)());
+    out << clauses_in.rdbuf();
+    return;
+  }
+
+  const std::streampos end = out.tellp();
+  out.seekp(problem_line_position);
+  out << problem_line();
+  out.seekp(end);
+}
+
 void dimacs_cnf_dumpt::lcnf(const bvt &bv)
 {
   dimacs_cnft::write_dimacs_clause(bv, out, true);
@@ -10,7 +10,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_DIMACS_CNF_H
 #define CPROVER_SOLVERS_SAT_DIMACS_CNF_H
 
-#include <iosfwd>
+#include <fstream>
+#include <memory>
+
+#include <util/tempfile.h>
 
 #include "cnf_clause_list.h"
 
@@ -35,7 +38,10 @@ public:
   bool is_in_conflict(literalt l) const override;
 
   static void
-  write_dimacs_clause(const bvt &, std::ostream &, bool break_lines);
+  write_dimacs_clause(
+    const clause_arenat::clauset &,
+    std::ostream &,
+    bool break_lines);
 
 protected:
   void write_problem_line(std::ostream &out);
@@ -44,6 +50,46 @@ protected:
   bool break_lines;
 };
 
+/// Writes the clauses in DIMACS format as they are added, rather than
+/// keeping them in memory until write_dimacs_cnf is called. The problem line
+/// is written first with room for the final counts and overwritten once these
+/// are known. If the output cannot be repositioned, or is the standard output
+/// that status messages also go to, the clauses are written to a temporary
+/// file instead, which write_dimacs_cnf copies after the problem line.
+class dimacs_cnf_streamt : public dimacs_cnft
+{
+public:
+  dimacs_cnf_streamt(std::ostream &_out, message_handlert &message_handler);
+
+  const std::string solver_text() override
+  {
+    return "DIMACS CNF streaming";
+  }
+
+  size_t no_clauses() const override
+  {
+    return clause_count;
+  }
+
+  /// Completes the problem line of the clauses written so far
+  /// \param out: must be the stream the constructor was given
+  void write_dimacs_cnf(std::ostream &out) override;
+
+protected:
+  void relationless_lcnf(const bvt &bv) override;
+
+  std::string problem_line() const;
+
+  std::ostream &out;
+  std::size_t clause_count = 0;
+
+  /// Position of the problem line in \ref out, if it is overwritten in place
+  std::streampos problem_line_position;
+
+  std::unique_ptr<temporary_filet> body_file;
+  std::ofstream body;
+};
+
 class dimacs_cnf_dumpt:public cnft
 {
 public:
@@ -0,0 +1,234 @@
+/*******************************************************************\
+
+Module: Incremental External SAT Solver
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Incremental External SAT Solver
+
+#include "external_sat_incremental.h"
+
+#include <util/invariant.h>
+#include <util/string_utils.h>
+
+#include <cstdlib>
+#include <sstream>
+
+external_sat_incrementalt::external_sat_incrementalt(
+  message_handlert &message_handler,
+  std::string cmd)
+  : cnf_solvert(message_handler),
+    solver_cmd(std::move(cmd)),
+    process(split_string(solver_cmd, ' ', false, true))
+{
+}
+
+const std::string external_sat_incrementalt::solver_text()
+{
+  return "External incremental SAT solver";
+}
+
+tvt external_sat_incrementalt::l_get(literalt a) const
+{
+  if(a.is_true())
+    return tvt(true);
+  else if(a.is_false())
+    return tvt(false);
+
+  if(a.var_no() >= assignment.size())
+    return tvt::unknown();
+
+  tvt result = assignment[a.var_no()];
+  return a.sign() ? !result : result;
+}
+
+void external_sat_incrementalt::send(const char *command, const bvt &literals)
+{
+  std::string line = command;
+
+  for(const auto &literal : literals)
+  {
+    line += ' ';
+    line += std::to_string(literal.dimacs());
+  }
+
+  line += " 0\n";
+  process.send(line);
+}
+
+void external_sat_incrementalt::lcnf(const bvt &bv)
+{
+  bvt clause;
+
+  if(process_clause(bv, clause))
+    return;
+
+  send("add", clause);
+  clause_counter++;
+}
+
+void external_sat_incrementalt::set_assignment(literalt, bool)
+{
+  UNIMPLEMENTED;
+}
+
+void external_sat_incrementalt::set_assumptions(const bvt &_assumptions)
+{
+  assumptions.clear();
+  assumes_false = false;
+
+  for(const auto &literal : _assumptions)
+  {
+    if(literal.is_false())
+      assumes_false = true;
+    else if(!literal.is_true())
+      assumptions.push_back(literal);
+  }
+}
+
+bool external_sat_incrementalt::is_in_conflict(literalt a) const
+{
+  return conflict.find(a.var_no()) != conflict.end();
+}
+
+bool external_sat_incrementalt::read_literals(
+  const std::string &prefix,
+  std::vector<int> &literals)
+{
+  std::string line;
+  if(!process.read_line(line))
+    return false;
+
+  std::istringstream in(line);
+  std::string word;
+  if(!(in >> word) || word != prefix)
+    return false;
+
+  literals.clear();
+  int literal;
+  while(in >> literal)
+  {
+    if(literal == 0)
+      return true;
+    literals.push_back(literal);
+  }
+
+  return false;
+}
+
+bool external_sat_incrementalt::read_model()
+{
+  bvt variables;
+  variables.reserve(no_variables());
+  for(std::size_t v = 1; v < no_variables(); v++)
+    variables.push_back(literalt(v, false));
+
+  send("value", variables);
+
+  std::vector<int> values;
+  if(!read_literals("v", values) || values.size() != variables.size())
+    return false;
+
+  assignment.assign(no_variables(), tvt::unknown());
+  for(const int value : values)
+  {
+    const std::size_t v = std::abs(value);
+    if(v >= no_variables())
+      return false;
+    assignment[v] = tvt(value > 0);
+  }
+
+  return true;
+}
+
+bool external_sat_incrementalt::read_conflict()
+{
+  send("failed", assumptions);
+
+  std::vector<int> failed;
+  if(!read_literals("f", failed))
+    return false;
+
+  for(const int literal : failed)
+    conflict.insert(std::abs(literal));
+
+  return true;
+}
+
+propt::resultt external_sat_incrementalt::do_prop_solve()
+{
+  log.statistics() << (no_variables() - 1) << " variables, " << clause_counter
+                   << " clauses" << messaget::eom;
+
+  assignment.clear();
+  conflict.clear();
+
+  if(assumes_false)
+  {
+    log.status() << "got FALSE as assumption: instance is UNSATISFIABLE"
+                 << messaget::eom;
+    status = statust::UNSAT;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  if(!assumptions.empty())
+    send("assume", assumptions);
+
+  process.send("solve\n");
+
+  std::string line;
+  if(!process.read_line(line))
+  {
+    log.error() << "external SAT solver " << solver_cmd
+                << " terminated unexpectedly" << messaget::eom;
+    status = statust::ERROR;
+    return resultt::P_ERROR;
+  }
+
+  if(line == "s SATISFIABLE")
+  {
+    if(!read_model())
+    {
+      log.error() << "external SAT solver has provided an unexpected model"
+                  << messaget::eom;
+      status = statust::ERROR;
+      return resultt::P_ERROR;
+    }
+
+    log.status() << "SAT checker: instance is SATISFIABLE" << messaget::eom;
+    status = statust::SAT;
+    return resultt::P_SATISFIABLE;
+  }
+
+  if(line == "s UNSATISFIABLE")
+  {
+    if(!read_conflict())
+    {
+      log.error() << "external SAT solver has provided an unexpected conflict"
+                  << messaget::eom;
+      status = statust::ERROR;
+      return resultt::P_ERROR;
+    }
+
+    log.status() << "SAT checker: instance is UNSATISFIABLE" << messaget::eom;
+    status = statust::UNSAT;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  if(line == "s UNKNOWN")
+  {
+    // the solver gave up, for example on a resource limit, but keeps its
+    // state and can be asked again
+    log.status() << "SAT checker: gave up without a result" << messaget::eom;
+    status = statust::INIT;
+    return resultt::P_UNKNOWN;
+  }
+
+  log.error() << "external SAT solver has provided an unexpected response: "
+              << line << messaget::eom;
+  status = statust::ERROR;
+  return resultt::P_ERROR;
+}
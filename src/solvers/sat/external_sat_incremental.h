@@ -0,0 +1,94 @@
+/*******************************************************************\
+
+Module: Incremental External SAT Solver
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An external SAT solver that keeps running across several calls to
+/// prop_solve, and receives the formula incrementally over a pipe.
+///
+/// The solver process reads commands from its standard input, one per line,
+/// with literals in DIMACS notation:
+///  * `add l1 ... ln 0` adds the clause `l1 | ... | ln`;
+///  * `assume l1 ... ln 0` assumes the literals for the next `solve`;
+///  * `solve` answers `s SATISFIABLE`, `s UNSATISFIABLE` or `s UNKNOWN`;
+///  * `value v1 ... vn 0` answers `v l1 ... ln 0`, where `li` is `vi` or `-vi`
+///    depending on the value of variable `vi` in the last model;
+///  * `failed l1 ... ln 0` answers `f` followed by those of the assumed
+///    literals `li` that are part of the last conflict, and `0`.
+///
+/// These correspond to the functions of the IPASIR interface;
+/// scripts/ipasir_pipe.cpp implements the protocol for any IPASIR solver.
+
+#ifndef CPROVER_SOLVERS_SAT_EXTERNAL_SAT_INCREMENTAL_H
+#define CPROVER_SOLVERS_SAT_EXTERNAL_SAT_INCREMENTAL_H
+
+#include "cnf.h"
+
+#include <util/piped_process.h>
+
+#include <unordered_set>
+
+class external_sat_incrementalt : public cnf_solvert
+{
+public:
+  /// \param cmd: the solver executable, followed by its arguments, separated
+  ///   by spaces
+  external_sat_incrementalt(message_handlert &message_handler, std::string cmd);
+
+  const std::string solver_text() override;
+
+  tvt l_get(literalt a) const override;
+
+  void lcnf(const bvt &bv) override;
+
+  void set_assignment(literalt a, bool value) override;
+
+  void set_assumptions(const bvt &_assumptions) override;
+
+  bool is_in_conflict(literalt a) const override;
+
+  bool has_set_assumptions() const override final
+  {
+    return true;
+  }
+
+  bool has_is_in_conflict() const override final
+  {
+    return true;
+  }
+
+protected:
+  resultt do_prop_solve() override;
+
+  /// Sends \p command followed by \p literals, terminated by 0
+  void send(const char *command, const bvt &literals);
+
+  std::string solver_cmd;
+  piped_processt process;
+
+  /// The assumptions that are not constant
+  bvt assumptions;
+  bool assumes_false = false;
+
+  /// Fetches the values of all variables after a satisfiable `solve`
+  bool read_model();
+
+  /// Fetches the assumptions in the conflict after an unsatisfiable `solve`
+  bool read_conflict();
+
+  /// Reads the answer to `value` or `failed`: \p prefix, then literals
+  /// terminated by 0
+  bool read_literals(const std::string &prefix, std::vector<int> &literals);
+
+  /// The values of the variables in the last model
+  std::vector<tvt> assignment;
+
+  /// The variables of the assumptions in the last conflict
+  std::unordered_set<unsigned> conflict;
+};
+
+#endif // CPROVER_SOLVERS_SAT_EXTERNAL_SAT_INCREMENTAL_H
@@ -41,6 +41,18 @@ void convert(const bvt &bv, Minisat::vec<Minisat::Lit> &dest)
 
 template<typename T>
 tvt satcheck_minisat2_baset<T>::l_get(literalt a) const
+{
+  if(polarity_aware)
+  {
+    return deferred_gate_value(
+      a, [this](literalt l) { return model_value(l); });
+  }
+
+  return model_value(a);
+}
+
+template <typename T>
+tvt satcheck_minisat2_baset<T>::model_value(literalt a) const
 {
   if(a.is_true())
     return tvt(true);
@@ -135,6 +147,8 @@ void satcheck_minisat2_baset<T>::lcnf(const bvt &bv)
       }
     }
 
+    encode_polarities(bv);
+
     Minisat::vec<Minisat::Lit> c;
 
     convert(bv, c);
@@ -191,6 +205,14 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
   log.statistics() << (no_variables() - 1) << " variables, "
                    << solver->nClauses() << " clauses" << messaget::eom;
 
+  if(polarity_aware)
+  {
+    log.statistics() << "Polarity-aware CNF: " << number_of_encoded_polarities
+                     << " of " << 2 * number_of_deferred_gates
+                     << " gate polarities encoded" << messaget::eom;
+    deferred_gate_values.clear();
+  }
+
   try
   {
     add_variables();
@@ -296,6 +318,7 @@ void satcheck_minisat2_baset<T>::set_assignment(literalt a, bool value)
     solver->model.growTo(v + 1);
     value ^= sign;
     solver->model[v] = Minisat::lbool(value);
+    deferred_gate_values.clear();
   }
   catch(const Minisat::OutOfMemoryException &)
   {
@@ -332,6 +355,8 @@ bool satcheck_minisat2_baset<T>::is_in_conflict(literalt a) const
 template<typename T>
 void satcheck_minisat2_baset<T>::set_assumptions(const bvt &bv)
 {
+  encode_polarities(bv);
+
   // We filter out 'true' assumptions which cause an assertion violation
   // in Minisat2.
   assumptions.clear();
@@ -353,6 +378,9 @@ void satcheck_minisat_simplifiert::set_frozen(literalt a)
   {
     if(!a.is_constant())
     {
+      // later clauses may use a in either polarity, but must not need
+      // clauses over variables that the simplifier may eliminate
+      encode_polarities({a, !a});
       add_variables();
       solver->setFrozen(a.var_no(), true);
     }
@@ -62,6 +62,10 @@ public:
   {
     return true;
   }
+  bool has_polarity_aware_encoding() const override final
+  {
+    return true;
+  }
 
   void set_time_limit_seconds(uint32_t lim) override
   {
@@ -91,6 +95,9 @@ protected:
   void add_variables();
   bvt assumptions;
 
+  /// The value of \p a in the model of the solver
+  tvt model_value(literalt a) const;
+
   optionalt<solver_hardnesst> solver_hardness;
 };
 
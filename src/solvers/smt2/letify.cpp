@@ -13,96 +13,108 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/std_expr.h>
 
-void letifyt::collect_bindings(
-  const exprt &expr,
-  seen_expressionst &map,
-  std::vector<exprt> &let_order)
+void letifyt::collect_bindings(const exprt &expr)
 {
   // do not letify things with no children
   if(expr.operands().empty())
     return;
 
-  // did we already see the expression?
-  seen_expressionst::iterator entry = map.find(expr);
+  auto entry = bindings.emplace(&expr.read(), bindingt(expr));
 
-  if(entry != map.end())
+  if(!entry.second)
   {
-    // yes, seen before, increase counter
-    let_count_idt &count_id = entry->second;
-    ++(count_id.count);
+    // the node has been seen before, increase counter
+    ++(entry.first->second.count);
     return;
   }
 
   // not seen before
-  for(auto &op : expr.operands())
-    collect_bindings(op, map, let_order);
+  bindingt &binding = entry.first->second;
 
-  INVARIANT(
-    map.find(expr) == map.end(), "expression should not have been seen yet");
+  for(const auto &op : expr.operands())
+    collect_bindings(op);
 
-  symbol_exprt let =
-    symbol_exprt("_let_" + std::to_string(++let_id_count), expr.type());
-
-  map.insert(std::make_pair(expr, let_count_idt(1, let)));
-
-  let_order.push_back(expr);
+  let_order.push_back(&binding);
 }
 
-/// Construct a nested let expression for expressions
-/// in let_order that are used more than once
-exprt letifyt::letify(
-  const exprt &expr,
-  const std::vector<exprt> &let_order,
-  const seen_expressionst &map)
+exprt letifyt::substitute_operands(const exprt &expr)
 {
-  exprt result = substitute_let(expr, map);
+  if(expr.operands().empty())
+    return expr;
 
-  // we build inside out, so go backwards in let order
-  for(auto r_it = let_order.rbegin(); r_it != let_order.rend(); r_it++)
-  {
-    const exprt &current = *r_it;
+  auto entry = bindings.find(&expr.read());
+  PRECONDITION(entry != bindings.end());
+  bindingt &binding = entry->second;
 
-    auto m_it = map.find(current);
-    PRECONDITION(m_it != map.end());
+  if(binding.is_substituted)
+    return binding.substituted;
 
-    // Used more than once? Then a let pays off.
-    if(m_it->second.count > 1)
-    {
-      result = let_exprt(
-        m_it->second.let_symbol, substitute_let(current, map), result);
-    }
+  // copy only the nodes that change, so that the result shares all
+  // unchanged subexpressions with the input
+  exprt result = expr;
+  const exprt::operandst &operands = expr.operands();
+
+  for(std::size_t i = 0; i < operands.size(); i++)
+  {
+    exprt op = substitute_let(operands[i]);
+
+    if(&op.read() != &operands[i].read())
+      result.operands()[i] = std::move(op);
   }
 
-  return result;
+  binding.substituted = std::move(result);
+  binding.is_substituted = true;
+
+  return binding.substituted;
 }
 
-exprt letifyt::operator()(const exprt &expr)
+exprt letifyt::substitute_let(const exprt &expr)
 {
-  seen_expressionst map;
-  std::vector<exprt> let_order;
+  if(expr.operands().empty())
+    return expr;
+
+  auto entry = bindings.find(&expr.read());
+  PRECONDITION(entry != bindings.end());
 
-  collect_bindings(expr, map, let_order);
+  // replace subexpression by let symbol if used more than once
+  if(entry->second.count > 1)
+    return entry->second.let_symbol;
 
-  return letify(expr, let_order, map);
+  return substitute_operands(expr);
 }
 
-exprt letifyt::substitute_let(const exprt &expr, const seen_expressionst &map)
+exprt letifyt::operator()(const exprt &expr)
 {
-  if(expr.operands().empty())
-    return expr;
+  collect_bindings(expr);
 
-  exprt tmp = expr;
+  // a let pays off for the nodes that are used more than once
+  for(auto binding : let_order)
+  {
+    if(binding->count > 1)
+    {
+      binding->let_symbol = symbol_exprt(
+        "_let_" + std::to_string(++let_id_count), binding->expr.type());
+    }
+  }
 
-  for(auto &op : tmp.operands())
+  exprt result = substitute_operands(expr);
+
+  // we build inside out, so go backwards in let order
+  for(auto r_it = let_order.rbegin(); r_it != let_order.rend(); r_it++)
   {
-    op.visit_pre([&map](exprt &expr) {
-      seen_expressionst::const_iterator it = map.find(expr);
+    bindingt &binding = **r_it;
 
-      // replace subexpression by let symbol if used more than once
-      if(it != map.end() && it->second.count > 1)
-        expr = it->second.let_symbol;
-    });
+    if(binding.count > 1)
+    {
+      result = let_exprt(
+        to_symbol_expr(binding.let_symbol),
+        substitute_operands(binding.expr),
+        result);
+    }
   }
 
-  return tmp;
+  bindings.clear();
+  let_order.clear();
+
+  return result;
 }
@@ -11,44 +11,67 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/std_expr.h>
 
+#include <unordered_map>
+
 /// Introduce LET for common subexpressions
+///
+/// Sharing is detected by node identity rather than by structural
+/// comparison: a subexpression gets a let binding when the same irep node is
+/// referenced more than once. This takes a single post-order pass that is
+/// linear in the size of the DAG, and does not hash any subtrees.
 class letifyt
 {
 public:
   exprt operator()(const exprt &);
 
+  /// \return the number of let bindings introduced so far
+  std::size_t get_number_of_lets() const
+  {
+    return let_id_count;
+  }
+
 protected:
   // to produce a fresh ID for each new let
   std::size_t let_id_count = 0;
 
-  struct let_count_idt
+  struct bindingt
   {
-    let_count_idt(std::size_t _count, const symbol_exprt &_let_symbol)
-      : count(_count), let_symbol(_let_symbol)
+    explicit bindingt(const exprt &_expr) : expr(_expr)
     {
     }
 
-    std::size_t count;
-    symbol_exprt let_symbol;
+    /// The node, which keeps the key of \ref bindingst alive; const, as
+    /// any non-const access could detach it
+    const exprt expr;
+
+    /// The number of references to the node
+    std::size_t count = 1;
+
+    /// The symbol of the let binding, if the node is shared
+    exprt let_symbol;
+
+    /// The node with its shared operands replaced by their let symbols, once
+    /// computed
+    exprt substituted;
+    bool is_substituted = false;
   };
 
-#if HASH_CODE
-  using seen_expressionst = std::unordered_map<exprt, let_count_idt, irep_hash>;
-#else
-  using seen_expressionst = irep_hash_mapt<exprt, let_count_idt>;
-#endif
+  /// Bindings of the nodes with operands, keyed by the address of the node
+  using bindingst = std::unordered_map<const void *, bindingt>;
+
+  bindingst bindings;
+
+  /// The nodes in post order, so that each comes after its operands
+  std::vector<bindingt *> let_order;
 
-  void collect_bindings(
-    const exprt &expr,
-    seen_expressionst &map,
-    std::vector<exprt> &let_order);
+  void collect_bindings(const exprt &expr);
 
-  static exprt letify(
-    const exprt &expr,
-    const std::vector<exprt> &let_order,
-    const seen_expressionst &map);
+  /// \return \p expr with its shared operands replaced by let symbols
+  exprt substitute_operands(const exprt &expr);
 
-  static exprt substitute_let(const exprt &expr, const seen_expressionst &map);
+  /// \return the let symbol of \p expr if it is shared, and
+  ///   \ref substitute_operands otherwise
+  exprt substitute_let(const exprt &expr);
 };
 
 #endif // CPROVER_SOLVERS_SMT2_LETIFY_H
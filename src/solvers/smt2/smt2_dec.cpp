@@ -47,6 +47,11 @@ decision_proceduret::resultt smt2_dect::dec_solve()
     write_footer(problem_out);
   }
 
+  messaget log{message_handler};
+  log.statistics() << "SMT2 problem of " << stringstream.tellp()
+                   << " characters with " << letify.get_number_of_lets()
+                   << " let bindings" << messaget::eom;
+
   std::vector<std::string> argv;
   std::string stdin_filename;
 
@@ -119,7 +124,6 @@ decision_proceduret::resultt smt2_dect::dec_solve()
 
   if(res<0)
   {
-    messaget log{message_handler};
     log.error() << "error running SMT2 solver" << messaget::eom;
     return decision_proceduret::resultt::D_ERROR;
   }
@@ -139,9 +143,11 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
   typedef std::unordered_map<irep_idt, irept> valuest;
   valuest values;
 
-  while(in)
+  smt2irept parser(in, message_handler);
+
+  while(true)
   {
-    auto parsed_opt = smt2irep(in, message_handler);
+    auto parsed_opt = parser();
 
     if(!parsed_opt.has_value())
       break;
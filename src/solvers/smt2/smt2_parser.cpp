@@ -149,6 +149,9 @@ irep_idt smt2_parsert::add_fresh_id(
                std::forward_as_tuple(kind, expr))
              .second);
 
+  if(additions)
+    additions->ids.push_back(new_id);
+
   // record renaming
   renaming_map[id] = new_id;
 
@@ -167,6 +170,9 @@ void smt2_parsert::add_unique_id(const irep_idt &id, const exprt &expr)
     // id already used
     throw error() << "identifier '" << id << "' defined twice";
   }
+
+  if(additions)
+    additions->ids.push_back(id);
 }
 
 irep_idt smt2_parsert::rename_id(const irep_idt &id) const
@@ -193,7 +199,7 @@ exprt smt2_parsert::let_expression()
     if(next_token() != smt2_tokenizert::SYMBOL)
       throw error("expected symbol in binding");
 
-    irep_idt identifier = smt2_tokenizer.get_buffer();
+    irep_idt identifier = smt2_tokenizer.get_id();
 
     // note that the previous bindings are _not_ visible yet
     exprt value=expression();
@@ -255,7 +261,7 @@ exprt smt2_parsert::quantifier_expression(irep_idt id)
     if(next_token() != smt2_tokenizert::SYMBOL)
       throw error("expected symbol in binding");
 
-    irep_idt identifier = smt2_tokenizer.get_buffer();
+    irep_idt identifier = smt2_tokenizer.get_id();
 
     typet type=sort();
 
@@ -568,8 +574,13 @@ exprt smt2_parsert::function_application()
           {
             const symbol_exprt symbol_expr(
               smt2_tokenizer.get_buffer(), bool_typet());
-            named_terms.emplace(
-              symbol_expr.get_identifier(), named_termt(term, symbol_expr));
+            const bool inserted =
+              named_terms
+                .emplace(
+                  symbol_expr.get_identifier(), named_termt(term, symbol_expr))
+                .second;
+            if(inserted && additions)
+              additions->named_terms.push_back(symbol_expr.get_identifier());
           }
           else
             throw error("invalid name attribute, expected symbol");
@@ -622,7 +633,7 @@ exprt smt2_parsert::function_application()
         if(next_token() != smt2_tokenizert::SYMBOL)
           throw error("expected symbol after '_'");
 
-        irep_idt id = smt2_tokenizer.get_buffer(); // hash it
+        irep_idt id = smt2_tokenizer.get_id(); // hash it
 
         if(id=="extract")
         {
@@ -1383,7 +1394,7 @@ smt2_parsert::function_signature_definition()
     if(next_token() != smt2_tokenizert::SYMBOL)
       throw error("expected symbol in parameter");
 
-    irep_idt id = smt2_tokenizer.get_buffer();
+    irep_idt id = smt2_tokenizer.get_id();
     domain.push_back(sort());
 
     parameters.push_back(
@@ -1444,7 +1455,7 @@ void smt2_parsert::setup_commands()
     if(next_token() != smt2_tokenizert::SYMBOL)
       throw error() << "expected a symbol after " << s;
 
-    irep_idt id = smt2_tokenizer.get_buffer();
+    irep_idt id = smt2_tokenizer.get_id();
     auto type = sort();
 
     add_unique_id(id, exprt(ID_nil, type));
@@ -1458,7 +1469,7 @@ void smt2_parsert::setup_commands()
     if(next_token() != smt2_tokenizert::SYMBOL)
       throw error("expected a symbol after declare-fun");
 
-    irep_idt id = smt2_tokenizer.get_buffer();
+    irep_idt id = smt2_tokenizer.get_id();
     auto type = function_signature_declaration();
 
     add_unique_id(id, exprt(ID_nil, type));
@@ -1468,7 +1479,7 @@ void smt2_parsert::setup_commands()
     if(next_token() != smt2_tokenizert::SYMBOL)
       throw error("expected a symbol after define-const");
 
-    const irep_idt id = smt2_tokenizer.get_buffer();
+    const irep_idt id = smt2_tokenizer.get_id();
 
     const auto type = sort();
     const auto value = expression();
@@ -1492,7 +1503,7 @@ void smt2_parsert::setup_commands()
     // save the renaming map
     renaming_mapt old_renaming_map = renaming_map;
 
-    const irep_idt id = smt2_tokenizer.get_buffer();
+    const irep_idt id = smt2_tokenizer.get_id();
 
     const auto signature = function_signature_definition();
     const auto body = expression();
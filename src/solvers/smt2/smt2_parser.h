@@ -67,6 +67,17 @@ public:
   using named_termst = std::map<irep_idt, named_termt>;
   named_termst named_terms;
 
+  /// The identifiers that have been added to \ref id_map and
+  /// \ref named_terms, for callers that need to remove them again
+  struct additionst
+  {
+    std::vector<irep_idt> ids;
+    std::vector<irep_idt> named_terms;
+  };
+
+  /// Additions are recorded here when set
+  additionst *additions = nullptr;
+
   bool exit;
 
   smt2_tokenizert::smt2_errort error(const std::string &message)
@@ -25,14 +25,14 @@ Author: Daniel Kroening, kroening@kroening.com
 class smt2_solvert:public smt2_parsert
 {
 public:
-  smt2_solvert(std::istream &_in, stack_decision_proceduret &_solver)
+  smt2_solvert(std::istream &_in, prop_conv_solvert &_solver)
     : smt2_parsert(_in), solver(_solver), status(NOT_SOLVED)
   {
     setup_commands();
   }
 
 protected:
-  stack_decision_proceduret &solver;
+  prop_conv_solvert &solver;
 
   void setup_commands();
   void define_constants();
@@ -40,6 +40,31 @@ protected:
 
   std::set<irep_idt> constants_done;
 
+  /// What a `push` frame has added, which the matching `pop` removes again;
+  /// the assertions of a frame are guarded by the context literal of the
+  /// solver
+  struct framet
+  {
+    additionst additions;
+    /// constants whose definition has been asserted within the frame
+    std::vector<irep_idt> constants_done;
+  };
+
+  std::vector<framet> frames;
+
+  /// The sort of each identifier that has been declared or defined, in any
+  /// frame. The solver keeps the encoding of an identifier after a `pop`, so
+  /// it can only be declared again with the same sort.
+  std::map<irep_idt, typet> declared_sorts;
+
+  /// \return the numeral argument of `push` and `pop`, which defaults to 1
+  std::size_t number_of_frames();
+
+  /// Record additions in the innermost frame, if any. Equalities are only
+  /// propagated into the symbol map of the solver outside of frames, as that
+  /// bypasses the context literal and would outlive the frame.
+  void frames_changed();
+
   enum
   {
     NOT_SOLVED,
@@ -65,6 +90,8 @@ void smt2_solvert::define_constants()
       continue;
 
     constants_done.insert(identifier);
+    if(!frames.empty())
+      frames.back().constants_done.push_back(identifier);
 
     exprt def = id.second.definition;
     expand_function_applications(def);
@@ -123,8 +150,48 @@ void smt2_solvert::expand_function_applications(exprt &expr)
   }
 }
 
+std::size_t smt2_solvert::number_of_frames()
+{
+  if(smt2_tokenizer.peek() != smt2_tokenizert::NUMERAL)
+    return 1;
+
+  next_token();
+  return std::stoull(smt2_tokenizer.get_buffer());
+}
+
+void smt2_solvert::frames_changed()
+{
+  additions = frames.empty() ? nullptr : &frames.back().additions;
+  solver.equality_propagation = frames.empty();
+}
+
 void smt2_solvert::setup_commands()
 {
+  // track the sorts of declared identifiers
+  for(const auto &command :
+      {"declare-const", "declare-var", "declare-fun", "define-const",
+       "define-fun"})
+  {
+    auto parser_command = commands.at(command);
+
+    commands[command] = [this, parser_command]() {
+      if(smt2_tokenizer.peek() != smt2_tokenizert::SYMBOL)
+        return parser_command();
+
+      const irep_idt id = smt2_tokenizer.get_id();
+      parser_command();
+
+      const typet &sort = id_map.at(id).type;
+      const auto entry = declared_sorts.emplace(id, sort);
+      if(!entry.second && entry.first->second != sort)
+      {
+        id_map.erase(id);
+        throw error() << "identifier '" << id
+                      << "' declared again with a different sort";
+      }
+    };
+  }
+
   {
     commands["assert"] = [this]() {
       exprt e = expression();
@@ -201,6 +268,44 @@ void smt2_solvert::setup_commands()
       solver.pop();
     };
 
+    commands["push"] = [this]() {
+      for(std::size_t n = number_of_frames(); n != 0; n--)
+      {
+        frames.emplace_back();
+        solver.push();
+      }
+
+      frames_changed();
+
+      status = NOT_SOLVED;
+    };
+
+    commands["pop"] = [this]() {
+      const std::size_t n = number_of_frames();
+
+      if(n > frames.size())
+        throw error("pop without matching push");
+
+      for(std::size_t i = 0; i < n; i++)
+      {
+        solver.pop();
+
+        const framet &frame = frames.back();
+        for(const auto &id : frame.additions.ids)
+          id_map.erase(id);
+        for(const auto &id : frame.additions.named_terms)
+          named_terms.erase(id);
+        for(const auto &id : frame.constants_done)
+          constants_done.erase(id);
+
+        frames.pop_back();
+      }
+
+      frames_changed();
+
+      status = NOT_SOLVED;
+    };
+
     commands["display"] = [this]() {
       // this is a command that Z3 appears to implement
       exprt e = expression();
@@ -373,8 +478,6 @@ void smt2_solvert::setup_commands()
     | ( get-proof )
     | ( get-unsat-assumptions )
     | ( get-unsat-core )
-    | ( pop hnumerali )
-    | ( push hnumerali )
     | ( reset )
     | ( reset-assertions )
     | ( set-info hattributei )
@@ -420,7 +523,8 @@ int solver(std::istream &in)
   // this is our default verbosity
   message_handler.set_verbosity(messaget::M_STATISTICS);
 
-  satcheckt satcheck{message_handler};
+  // no preprocessing, as later commands may refer to any variable
+  satcheck_no_simplifiert satcheck{message_handler};
   boolbvt boolbv{ns, satcheck, message_handler};
 
   smt2_solvert smt2_solver{in, boolbv};
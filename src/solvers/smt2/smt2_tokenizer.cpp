@@ -21,31 +21,55 @@ bool smt2_tokenizert::is_simple_symbol_character(char ch)
      ch=='?' || ch=='/';
 }
 
+bool smt2_tokenizert::refill()
+{
+  if(in == nullptr)
+    return false;
+
+  std::streambuf &streambuf = *in->rdbuf();
+
+  // wait for one character, then take whatever else is available
+  const auto ch = streambuf.sbumpc();
+
+  if(ch == std::char_traits<char>::eof())
+    return false;
+
+  // drop what precedes the current token
+  chunk.erase(0, token_begin);
+  pos -= token_begin;
+  token_begin = 0;
+
+  chunk += std::char_traits<char>::to_char_type(ch);
+
+  const std::streamsize available = streambuf.in_avail();
+  if(available > 0)
+  {
+    const std::size_t old_size = chunk.size();
+    chunk.resize(old_size + available);
+    chunk.resize(old_size + streambuf.sgetn(&chunk[old_size], available));
+  }
+
+  data = chunk.data();
+  size = chunk.size();
+
+  return true;
+}
+
 smt2_tokenizert::tokent smt2_tokenizert::get_simple_symbol()
 {
   // any non-empty sequence of letters, digits and the characters
   // ~ ! @ $ % ^ & * _ - + = < > . ? /
   // that does not start with a digit and is not a reserved word.
 
-  buffer.clear();
+  token_begin = pos;
 
-  char ch;
-  while(in->get(ch))
-  {
-    if(is_simple_symbol_character(ch))
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      quoted_symbol = false;
-      return SYMBOL;
-    }
-  }
+  while(has_char() && is_simple_symbol_character(data[pos]))
+    pos++;
+
+  token_size = pos - token_begin;
 
   // eof -- this is ok here
-  if(buffer.empty())
+  if(token_size == 0 && !has_char())
     return END_OF_FILE;
   else
   {
@@ -58,85 +82,39 @@ smt2_tokenizert::tokent smt2_tokenizert::get_decimal_numeral()
 {
   // we accept any sequence of digits and dots
 
-  buffer.clear();
+  token_begin = pos;
 
-  char ch;
-  while(in->get(ch))
-  {
-    if(isdigit(ch) || ch=='.')
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
-  }
+  while(has_char() && (isdigit(data[pos]) || data[pos] == '.'))
+    pos++;
 
-  // eof -- this is ok here
-  if(buffer.empty())
-    return END_OF_FILE;
-  else
-    return NUMERAL;
+  token_size = pos - token_begin;
+
+  return NUMERAL;
 }
 
 smt2_tokenizert::tokent smt2_tokenizert::get_bin_numeral()
 {
-  // we accept any sequence of '0' or '1'
+  // we accept any sequence of '0' or '1', the token includes the '#b'
 
-  buffer.clear();
-  buffer+='#';
-  buffer+='b';
+  while(has_char() && (data[pos] == '0' || data[pos] == '1'))
+    pos++;
 
-  char ch;
-  while(in->get(ch))
-  {
-    if(ch=='0' || ch=='1')
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
-  }
+  token_size = pos - token_begin;
 
-  // eof -- this is ok here
-  if(buffer.empty())
-    return END_OF_FILE;
-  else
-    return NUMERAL;
+  return NUMERAL;
 }
 
 smt2_tokenizert::tokent smt2_tokenizert::get_hex_numeral()
 {
-  // we accept any sequence of '0'-'9', 'a'-'f', 'A'-'F'
+  // we accept any sequence of '0'-'9', 'a'-'f', 'A'-'F',
+  // the token includes the '#x'
 
-  buffer.clear();
-  buffer+='#';
-  buffer+='x';
+  while(has_char() && isxdigit(data[pos]))
+    pos++;
 
-  char ch;
-  while(in->get(ch))
-  {
-    if(isxdigit(ch))
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
-  }
+  token_size = pos - token_begin;
 
-  // eof -- this is ok here
-  if(buffer.empty())
-    return END_OF_FILE;
-  else
-    return NUMERAL;
+  return NUMERAL;
 }
 
 smt2_tokenizert::tokent smt2_tokenizert::get_quoted_symbol()
@@ -146,21 +124,24 @@ smt2_tokenizert::tokent smt2_tokenizert::get_quoted_symbol()
   // character \, that starts and ends with | and does not otherwise
   // contain |
 
-  buffer.clear();
+  token_begin = pos;
 
-  char ch;
-  while(in->get(ch))
+  while(has_char())
   {
+    const char ch = data[pos];
+
     if(ch=='|')
     {
+      token_size = pos - token_begin;
+      pos++;
       quoted_symbol = true;
       return SYMBOL; // done
     }
 
-    buffer+=ch;
-
     if(ch=='\n')
       line_no++;
+
+    pos++;
   }
 
   // Hmpf. Eof before end of quoted symbol. This is an error.
@@ -169,29 +150,40 @@ smt2_tokenizert::tokent smt2_tokenizert::get_quoted_symbol()
 
 smt2_tokenizert::tokent smt2_tokenizert::get_string_literal()
 {
-  buffer.clear();
+  token_begin = pos;
+  bool escaped_quotes = false;
 
-  char ch;
-  while(in->get(ch))
+  while(has_char())
   {
-    if(ch=='"')
+    if(data[pos] == '"')
     {
+      token_size = pos - token_begin;
+      pos++;
+
       // quotes may be escaped by repeating
-      if(in->get(ch))
+      if(has_char() && data[pos] == '"')
       {
-        if(ch=='"')
-        {
-        }
-        else
+        escaped_quotes = true;
+        pos++;
+        continue;
+      }
+
+      if(escaped_quotes)
+      {
+        buffer.clear();
+        for(std::size_t i = token_begin; i < token_begin + token_size; i++)
         {
-          in->unget();
-          return STRING_LITERAL; // done
+          buffer += data[i];
+          if(data[i] == '"')
+            i++;
         }
+        buffer_valid = true;
       }
-      else
-        return STRING_LITERAL; // done
+
+      return STRING_LITERAL; // done
     }
-    buffer+=ch;
+
+    pos++;
   }
 
   // Hmpf. Eof before end of string literal. This is an error.
@@ -210,10 +202,19 @@ smt2_tokenizert::tokent smt2_tokenizert::next_token()
 
 void smt2_tokenizert::get_token_from_stream()
 {
-  char ch;
+  buffer_valid = false;
 
-  while(in->get(ch))
+  while(true)
   {
+    // don't keep any whitespace or comments when reading more input
+    token_begin = pos;
+    token_size = 0;
+
+    if(!has_char())
+      break;
+
+    const char ch = data[pos++];
+
     switch(ch)
     {
     case '\n':
@@ -229,9 +230,10 @@ void smt2_tokenizert::get_token_from_stream()
 
     case ';': // comment
       // skip until newline
-      while(in->get(ch))
+      while(has_char())
       {
-        if(ch=='\n')
+        token_begin = pos;
+        if(data[pos++] == '\n')
         {
           line_no++;
           break;
@@ -241,11 +243,13 @@ void smt2_tokenizert::get_token_from_stream()
 
     case '(':
       // produce sub-expression
+      token_size = 1;
       token = OPEN;
       return;
 
     case ')':
       // done with sub-expression
+      token_size = 1;
       token = CLOSE;
       return;
 
@@ -268,14 +272,15 @@ void smt2_tokenizert::get_token_from_stream()
         throw error("expecting symbol after colon");
 
     case '#':
-      if(in->get(ch))
+      if(has_char())
       {
-        if(ch=='b')
+        const char base = data[pos++];
+        if(base == 'b')
         {
           token = get_bin_numeral();
           return;
         }
-        else if(ch=='x')
+        else if(base == 'x')
         {
           token = get_hex_numeral();
           return;
@@ -290,13 +295,13 @@ void smt2_tokenizert::get_token_from_stream()
     default: // likely a simple symbol or a numeral
       if(isdigit(ch))
       {
-        in->unget();
+        pos--;
         token = get_decimal_numeral();
         return;
       }
       else if(is_simple_symbol_character(ch))
       {
-        in->unget();
+        pos--;
         token = get_simple_symbol();
         return;
       }
@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_SMT2_SMT2_TOKENIZER_H
 
 #include <util/exception_utils.h>
+#include <util/irep.h>
 
 #include <sstream>
 #include <string>
@@ -17,10 +18,19 @@ Author: Daniel Kroening, kroening@kroening.com
 class smt2_tokenizert
 {
 public:
-  explicit smt2_tokenizert(std::istream &_in) : peeked(false), token(NONE)
+  /// Tokenize the contents of \p _in, which are read in chunks of whatever
+  /// the stream has available, so that interactive input does not block
+  explicit smt2_tokenizert(std::istream &_in)
+    : in(&_in), data(nullptr), size(0), peeked(false), token(NONE)
+  {
+  }
+
+  /// Tokenize the \p _size characters starting at \p _data, for example a
+  /// file that has been read or mapped into memory. The characters are not
+  /// copied and must remain valid while the tokenizer is used.
+  smt2_tokenizert(const char *_data, std::size_t _size)
+    : in(nullptr), data(_data), size(_size), peeked(false), token(NONE)
   {
-    in=&_in;
-    line_no=1;
   }
 
   class smt2_errort : public cprover_exception_baset
@@ -81,11 +91,29 @@ public:
     }
   }
 
+  /// \return the text of the current token, which is only copied into a
+  ///   string when this is called
   const std::string &get_buffer() const
   {
+    if(!buffer_valid)
+    {
+      buffer.assign(data + token_begin, token_size);
+      buffer_valid = true;
+    }
+
     return buffer;
   }
 
+  /// \return the text of the current token as identifier, interned without
+  ///   building a string first
+  irep_idt get_id() const
+  {
+    if(buffer_valid)
+      return buffer;
+    else
+      return irep_idt(data + token_begin, token_size);
+  }
+
   bool token_is_quoted_symbol() const
   {
     return quoted_symbol;
@@ -104,9 +132,29 @@ public:
   }
 
 protected:
+  /// The stream to read from, or nullptr when tokenizing a given buffer
   std::istream *in;
-  unsigned line_no;
-  std::string buffer;
+
+  /// The characters read from \ref in that have not been consumed yet
+  std::string chunk;
+
+  /// The input, which is either the given buffer or \ref chunk
+  const char *data;
+  std::size_t size;
+
+  /// The position of the next character in \ref data
+  std::size_t pos = 0;
+
+  /// The text of the current token in \ref data
+  std::size_t token_begin = 0;
+  std::size_t token_size = 0;
+
+  /// The text of the current token as string, either built on demand or,
+  /// for string literals with escaped quotes, by the tokenizer
+  mutable std::string buffer;
+  mutable bool buffer_valid = false;
+
+  unsigned line_no = 1;
   bool quoted_symbol = false;
   bool peeked;
   tokent token;
@@ -116,6 +164,16 @@ protected:
   void skip_to_end_of_list();
 
 private:
+  /// \return true iff there is another character, reading more input from
+  ///   \ref in if needed
+  bool has_char()
+  {
+    return pos < size || refill();
+  }
+
+  /// Read more input from \ref in, keeping the current token
+  bool refill();
+
   tokent get_decimal_numeral();
   tokent get_hex_numeral();
   tokent get_bin_numeral();
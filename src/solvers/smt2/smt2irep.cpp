@@ -8,26 +8,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "smt2irep.h"
 
-#include <util/message.h>
-
 #include <stack>
 
-#include "smt2_tokenizer.h"
-
-class smt2irept:public smt2_tokenizert
-{
-public:
-  smt2irept(std::istream &_in, message_handlert &message_handler)
-    : smt2_tokenizert(_in), log(message_handler)
-  {
-  }
-
-  optionalt<irept> operator()();
-
-protected:
-  messaget log;
-};
-
 optionalt<irept> smt2irept::operator()()
 {
   try
@@ -48,9 +30,9 @@ optionalt<irept> smt2irept::operator()()
       case NUMERAL:
       case SYMBOL:
         if(stack.empty())
-          return irept(buffer); // all done!
+          return irept(get_id()); // all done!
         else
-          stack.top().get_sub().push_back(irept(buffer));
+          stack.top().get_sub().push_back(irept(get_id()));
         break;
 
       case OPEN: // '('
@@ -64,13 +46,13 @@ optionalt<irept> smt2irept::operator()()
           throw error("unexpected ')'");
         else
         {
-          irept tmp = stack.top();
+          irept tmp = std::move(stack.top());
           stack.pop();
 
           if(stack.empty())
-            return tmp; // all done!
+            return std::move(tmp); // all done!
 
-          stack.top().get_sub().push_back(tmp);
+          stack.top().get_sub().push_back(std::move(tmp));
           break;
         }
 
@@ -12,13 +12,40 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iosfwd>
 
+#include <util/message.h>
 #include <util/optional.h>
 
-class irept;
-class message_handlert;
+#include "smt2_tokenizer.h"
+
+/// Reads SMT-LIB2 expressions as ireps from a stream or a buffer
+class smt2irept : public smt2_tokenizert
+{
+public:
+  smt2irept(std::istream &_in, message_handlert &message_handler)
+    : smt2_tokenizert(_in), log(message_handler)
+  {
+  }
+
+  smt2irept(
+    const char *_data,
+    std::size_t _size,
+    message_handlert &message_handler)
+    : smt2_tokenizert(_data, _size), log(message_handler)
+  {
+  }
+
+  /// returns an irep for the next SMT-LIB2 expression
+  /// returns {} when EOF is encountered before reading non-whitespace input
+  optionalt<irept> operator()();
+
+protected:
+  messaget log;
+};
 
 /// returns an irep for an SMT-LIB2 expression read from a given stream
 /// returns {} when EOF is encountered before reading non-whitespace input
+/// As the input is read in chunks, this may consume characters after the
+/// expression; use \ref smt2irept to read several expressions.
 optionalt<irept> smt2irep(std::istream &, message_handlert &);
 
 #endif // CPROVER_SOLVERS_SMT2_SMT2IREP_H
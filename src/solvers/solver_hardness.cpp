@@ -219,6 +219,17 @@ void solver_hardnesst::produce_report()
   }
 }
 
+void solver_hardnesst::for_each_ssa_hardness(
+  const std::function<void(goto_programt::const_targett, const sat_hardnesst &)>
+    &handler) const
+{
+  for(const auto &ssa_step_hardness : hardness_stats)
+  {
+    for(const auto &key_value_pair : ssa_step_hardness)
+      handler(key_value_pair.first.pc, key_value_pair.second);
+  }
+}
+
 std::string
 solver_hardnesst::goto_instruction2string(goto_programt::const_targett pc)
 {
@@ -12,6 +12,7 @@ Author: Diffblue Ltd.
 #include <solvers/prop/literal.h>
 
 #include <fstream>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -118,6 +119,14 @@ struct solver_hardnesst
   /// Print the statistics to a JSON file (specified via command-line option).
   void produce_report();
 
+  /// Call \p handler for each SSA step that has been registered so far,
+  /// passing the GOTO instruction it originates from and the SAT hardness of
+  /// the solver queries it produced.
+  void for_each_ssa_hardness(
+    const std::function<
+      void(goto_programt::const_targett, const sat_hardnesst &)> &handler)
+    const;
+
   solver_hardnesst() = default;
 
   // copying this isn’t really a meaningful operation
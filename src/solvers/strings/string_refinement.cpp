@@ -19,6 +19,7 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
 
 #include "string_refinement.h"
 
+#include <solvers/prop/literal_expr.h>
 #include <solvers/sat/satcheck.h>
 #include <stack>
 #include <unordered_set>
@@ -46,6 +47,11 @@ static optionalt<exprt> find_counter_example(
   const symbol_exprt &var,
   message_handlert &message_handler);
 
+static std::vector<optionalt<exprt>> find_counter_examples(
+  const namespacet &ns,
+  const std::vector<std::pair<exprt, symbol_exprt>> &formulas,
+  messaget::mstreamt &stream);
+
 /// Check axioms takes the model given by the underlying solver and answers
 /// whether it satisfies the string constraints.
 ///
@@ -56,7 +62,7 @@ static optionalt<exprt> find_counter_example(
 ///     are unknown to get, for details see substitute_array_access;
 ///   * `b` is simplified and array accesses are replaced by expressions
 ///     without arrays;
-///   * we give lemma `b` to a fresh solver;
+///   * we give lemma `b` to a solver, which is shared by all constraints;
 ///   * if no counter-example to `b` is found, this means the constraint `a`
 ///     is satisfied by the valuation given by get.
 /// \return `true` if the current model satisfies all the axioms, `false`
@@ -1374,8 +1380,11 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
     generator.array_pool);
 #endif
 
-  // Maps from indexes of violated universal axiom to a witness of violation
-  std::map<size_t, exprt> violated;
+  // The negated axioms with the variable to find a witness for, universal
+  // axioms first, then the not_contains axioms
+  std::vector<std::pair<exprt, symbol_exprt>> negated_axioms;
+  negated_axioms.reserve(
+    axioms.universal.size() + axioms.not_contains.size());
 
   stream << "string_refinement::check_axioms: " << axioms.universal.size()
          << " universal axioms:" << messaget::eom;
@@ -1397,25 +1406,9 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
     debug_check_axioms_step(
       stream, axiom, axiom_in_model, negaxiom, with_concretized_arrays);
 
-    if(
-      const auto &witness = find_counter_example(
-        ns,
-        with_concretized_arrays,
-        axiom.univ_var,
-        stream.message.get_message_handler()))
-    {
-      stream << std::string(4, ' ')
-             << "- violated_for: " << format(axiom.univ_var) << "="
-             << format(*witness) << messaget::eom;
-      violated[i] = *witness;
-    }
-    else
-      stream << std::string(4, ' ') << "- correct" << messaget::eom;
+    negated_axioms.emplace_back(with_concretized_arrays, axiom.univ_var);
   }
 
-  // Maps from indexes of violated not_contains axiom to a witness of violation
-  std::map<std::size_t, exprt> violated_not_contains;
-
   stream << "there are " << axioms.not_contains.size() << " not_contains axioms"
          << messaget::eom;
   for(std::size_t i = 0; i < axioms.not_contains.size(); i++)
@@ -1432,12 +1425,41 @@ static std::pair<bool, std::vector<exprt>> check_axioms(
     debug_check_axioms_step(
       stream, nc_axiom, nc_axiom, negated_axiom, negated_axiom);
 
-    if(
-      const auto witness = find_counter_example(
-        ns, negated_axiom, univ_var, stream.message.get_message_handler()))
+    negated_axioms.emplace_back(negated_axiom, univ_var);
+  }
+
+  const std::vector<optionalt<exprt>> witnesses =
+    find_counter_examples(ns, negated_axioms, stream);
+
+  // Maps from indexes of violated universal axiom to a witness of violation
+  std::map<size_t, exprt> violated;
+
+  for(size_t i = 0; i < axioms.universal.size(); i++)
+  {
+    stream << std::string(2, ' ') << i << ".\n";
+
+    if(const auto &witness = witnesses[i])
     {
       stream << std::string(4, ' ')
-             << "- violated_for: " << univ_var.get_identifier() << "="
+             << "- violated_for: " << format(axioms.universal[i].univ_var)
+             << "=" << format(*witness) << messaget::eom;
+      violated[i] = *witness;
+    }
+    else
+      stream << std::string(4, ' ') << "- correct" << messaget::eom;
+  }
+
+  // Maps from indexes of violated not_contains axiom to a witness of violation
+  std::map<std::size_t, exprt> violated_not_contains;
+
+  for(std::size_t i = 0; i < axioms.not_contains.size(); i++)
+  {
+    const std::size_t index = axioms.universal.size() + i;
+
+    if(const auto &witness = witnesses[index])
+    {
+      stream << std::string(4, ' ') << "- violated_for: "
+             << negated_axioms[index].second.get_identifier() << "="
              << format(*witness) << messaget::eom;
       violated_not_contains[i] = *witness;
     }
@@ -1917,6 +1939,89 @@ static optionalt<exprt> find_counter_example(
     return {};
 }
 
+/// Looks for models of each of \p formulas using one incremental solver:
+/// the formulas are converted once, and each solver call asks for a model
+/// of any of those for which none has been found yet. A model gives the
+/// witnesses for all the formulas it satisfies, so that there are no more
+/// solver calls than formulas with a model, plus one.
+/// \param ns: namespace
+/// \param formulas: pairs of a formula and the variable whose evaluation is
+///   the witness of a model of the formula
+/// \param stream: output stream for statistics
+/// \return for each formula the witness of a satisfying assignment, if one
+///   exists
+static std::vector<optionalt<exprt>> find_counter_examples(
+  const namespacet &ns,
+  const std::vector<std::pair<exprt, symbol_exprt>> &formulas,
+  messaget::mstreamt &stream)
+{
+  message_handlert &message_handler = stream.message.get_message_handler();
+  std::vector<optionalt<exprt>> witnesses;
+  witnesses.reserve(formulas.size());
+
+  satcheck_no_simplifiert sat_check(message_handler);
+
+  if(!sat_check.has_set_assumptions())
+  {
+    for(const auto &formula : formulas)
+    {
+      witnesses.push_back(find_counter_example(
+        ns, formula.first, formula.second, message_handler));
+    }
+
+    return witnesses;
+  }
+
+  witnesses.resize(formulas.size());
+  boolbvt solver(ns, sat_check, message_handler);
+
+  // all formulas are converted before solving for the first time, which
+  // is when the constraints of the array theory are added
+  std::vector<literalt> literals;
+  literals.reserve(formulas.size());
+  for(const auto &formula : formulas)
+    literals.push_back(solver.convert(formula.first));
+
+  std::vector<std::size_t> unknown;
+  for(std::size_t i = 0; i < formulas.size(); i++)
+    unknown.push_back(i);
+
+  std::size_t solver_calls = 0;
+
+  while(!unknown.empty())
+  {
+    exprt::operandst disjuncts;
+    for(const std::size_t i : unknown)
+      disjuncts.push_back(literal_exprt(literals[i]));
+
+    solver.push({literal_exprt(solver.convert(disjunction(disjuncts)))});
+    ++solver_calls;
+
+    if(solver() != decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      solver.pop();
+      break;
+    }
+
+    std::vector<std::size_t> still_unknown;
+    for(const std::size_t i : unknown)
+    {
+      if(solver.l_get(literals[i]).is_true())
+        witnesses[i] = solver.get(formulas[i].second);
+      else
+        still_unknown.push_back(i);
+    }
+
+    solver.pop();
+    unknown.swap(still_unknown);
+  }
+
+  stream << "checked " << formulas.size() << " axioms with " << solver_calls
+         << " solver calls" << messaget::eom;
+
+  return witnesses;
+}
+
 /// \related string_constraintt
 typedef std::map<exprt, std::vector<exprt>> array_index_mapt;
 
@@ -766,7 +766,8 @@ void configt::set_arch(const irep_idt &arch)
 }
 
 /// \brief Parses the `object_bits` argument from the command line arguments.
-/// \param argument The command line argument to parse the `object_bits` from.
+/// \param argument The command line argument to parse the `object_bits` from,
+///   or "auto" to have the solver choose the number of object bits.
 /// \param pointer_width The width of a pointer in bits. This is used to check
 ///   the value of object_bits is within the valid range.
 /// \return A `bv_encodingt` on successful parsing. In the case where an invalid
@@ -783,6 +784,15 @@ configt::bv_encodingt parse_object_bits_encoding(
         std::to_string(pointer_width) + ") ",
       "--object_bits");
   };
+
+  if(argument == "auto")
+  {
+    // the language default is used until the solver chooses
+    configt::bv_encodingt bv_encoding;
+    bv_encoding.is_object_bits_auto = true;
+    return bv_encoding;
+  }
+
   const auto object_bits = string2optional<unsigned int>(argument);
   if(!object_bits)
     throw_for_reason("not a valid unsigned integer");
@@ -1315,6 +1325,9 @@ void configt::set_object_bits_from_symbol_table(
 
 std::string configt::object_bits_info()
 {
+  if(bv_encoding.is_object_bits_auto)
+    return "Choosing object bits from the number of addressed objects";
+
   return "Running with "+std::to_string(bv_encoding.object_bits)+
     " object bits, "+
     std::to_string(ansi_c.pointer_width-bv_encoding.object_bits)+
@@ -95,7 +95,9 @@ class symbol_tablet;
   "(object-bits):"                                                             \
 
 #define HELP_CONFIG_BACKEND                                                    \
-  " --object-bits n              number of bits used for object addresses\n"
+  " --object-bits n              number of bits used for object addresses\n"   \
+  " --object-bits auto           choose the number of bits used for object\n"  \
+  "                              addresses from the number of objects\n"
 
 // clang-format on
 
@@ -254,6 +256,9 @@ public:
     // number of bits to encode heap object addresses
     std::size_t object_bits = 8;
     bool is_object_bits_default = true;
+    // choose the number of object bits used by the solver from the number
+    // of objects whose address is taken
+    bool is_object_bits_auto = false;
   } bv_encoding;
 
   // this is the function to start executing
@@ -71,6 +71,13 @@ public:
   {
   }
 
+  /// The \p len characters starting at \p s, which need not be
+  /// null-terminated
+  dstringt(const char *s, std::size_t len)
+    : no(get_string_container()[string_ptrt(s, len)])
+  {
+  }
+
   dstringt(const dstringt &) = default;
 
   /// Move constructor. There is no need and no point in actually destroying the
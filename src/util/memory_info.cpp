@@ -16,6 +16,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #ifdef __linux__
 #include <malloc.h>
+#include <unistd.h>
+
+#include <fstream>
 #endif
 
 #ifdef _WIN32
@@ -72,3 +75,34 @@ void memory_info(std::ostream &out)
       << static_cast<double>(t.size_allocated)/1000000 << "m\n";
 #endif
 }
+
+std::size_t resident_set_size()
+{
+#if defined(__linux__)
+  // the second field of statm is the resident set size in pages
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size, resident;
+  if(statm >> size >> resident)
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return 0;
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return pmc.WorkingSetSize;
+  return 0;
+#elif defined(__APPLE__)
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct task_basic_info t_info;
+  mach_msg_type_number_t t_info_count = TASK_BASIC_INFO_COUNT;
+  if(
+    task_info(
+      current_task(), TASK_BASIC_INFO, (task_info_t)&t_info, &t_info_count) !=
+    KERN_SUCCESS)
+  {
+    return 0;
+  }
+  return t_info.resident_size;
+#else
+  return 0;
+#endif
+}
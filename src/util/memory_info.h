@@ -10,8 +10,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_MEMORY_INFO_H
 #define CPROVER_UTIL_MEMORY_INFO_H
 
+#include <cstddef>
 #include <iosfwd>
 
 void memory_info(std::ostream &);
 
+/// Resident set size (physical memory in use) of the current process.
+/// \return size in bytes, or 0 if the platform does not provide it
+std::size_t resident_set_size();
+
 #endif // CPROVER_UTIL_MEMORY_INFO_H
@@ -0,0 +1,201 @@
+/*******************************************************************\
+
+Module: Subprocess Communication via Pipes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Subprocess Communication via Pipes
+
+#include "piped_process.h"
+
+#include "exception_utils.h"
+#include "invariant.h"
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <csignal>
+#  include <cstdio>
+#  include <cstdlib>
+#  include <cstring>
+
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+/// Size of the input that is queued before it is written to the process
+static const std::size_t piped_process_buffer_size = 1 << 16;
+
+#ifdef _WIN32
+
+piped_processt::piped_processt(const std::vector<std::string> &)
+{
+  throw system_exceptiont(
+    "communicating with a process via pipes is not supported on Windows");
+}
+
+piped_processt::~piped_processt()
+{
+}
+
+void piped_processt::send(const std::string &)
+{
+  UNREACHABLE;
+}
+
+bool piped_processt::flush()
+{
+  UNREACHABLE;
+}
+
+bool piped_processt::read_line(std::string &)
+{
+  UNREACHABLE;
+}
+
+#else
+
+piped_processt::piped_processt(const std::vector<std::string> &argv)
+{
+  PRECONDITION(!argv.empty());
+
+  // parent -> child and child -> parent
+  int to_child[2], from_child[2];
+
+  if(pipe(to_child) != 0)
+    throw system_exceptiont("failed to create a pipe");
+
+  if(pipe(from_child) != 0)
+  {
+    close(to_child[0]);
+    close(to_child[1]);
+    throw system_exceptiont("failed to create a pipe");
+  }
+
+  child_pid = fork();
+
+  if(child_pid == 0)
+  {
+    std::vector<char *> _argv(argv.size() + 1);
+    for(std::size_t i = 0; i < argv.size(); i++)
+      _argv[i] = strdup(argv[i].c_str());
+
+    _argv[argv.size()] = nullptr;
+
+    dup2(to_child[0], STDIN_FILENO);
+    dup2(from_child[1], STDOUT_FILENO);
+    close(to_child[0]);
+    close(to_child[1]);
+    close(from_child[0]);
+    close(from_child[1]);
+
+    execvp(argv.front().c_str(), _argv.data());
+
+    /* usually no return */
+    perror(std::string("execvp " + argv.front() + " failed").c_str());
+    exit(1);
+  }
+
+  close(to_child[0]);
+  close(from_child[1]);
+
+  if(child_pid < 0)
+  {
+    close(to_child[1]);
+    close(from_child[0]);
+    throw system_exceptiont("failed to start " + argv.front());
+  }
+
+  input_fd = to_child[1];
+  output_fd = from_child[0];
+}
+
+piped_processt::~piped_processt()
+{
+  flush();
+  close(input_fd);
+  close(output_fd);
+
+  int status;
+  while(waitpid(child_pid, &status, 0) == -1 && errno == EINTR)
+  {
+  }
+}
+
+void piped_processt::send(const std::string &data)
+{
+  input_buffer += data;
+
+  if(input_buffer.size() >= piped_process_buffer_size)
+    flush();
+}
+
+bool piped_processt::flush()
+{
+  if(input_buffer.empty())
+    return true;
+
+  // A process that exits early must not terminate us with SIGPIPE; the write
+  // then fails with EPIPE instead. The previous handler is restored
+  // afterwards, so that callers that rely on SIGPIPE are not affected.
+  struct sigaction ignore, previous;
+  ignore.sa_handler = SIG_IGN;
+  sigemptyset(&ignore.sa_mask);
+  ignore.sa_flags = 0;
+  sigaction(SIGPIPE, &ignore, &previous);
+
+  std::size_t written = 0;
+  bool success = true;
+
+  while(written < input_buffer.size())
+  {
+    const ssize_t result = write(
+      input_fd, input_buffer.data() + written, input_buffer.size() - written);
+
+    if(result < 0)
+    {
+      if(errno == EINTR)
+        continue;
+
+      success = false;
+      break;
+    }
+
+    written += result;
+  }
+
+  sigaction(SIGPIPE, &previous, nullptr);
+
+  input_buffer.clear();
+  return success;
+}
+
+bool piped_processt::read_line(std::string &line)
+{
+  if(!flush())
+    return false;
+
+  std::size_t end;
+
+  while((end = output_buffer.find('\n')) == std::string::npos)
+  {
+    char buffer[4096];
+    const ssize_t result = read(output_fd, buffer, sizeof(buffer));
+
+    if(result < 0 && errno == EINTR)
+      continue;
+
+    if(result <= 0)
+      return false;
+
+    output_buffer.append(buffer, result);
+  }
+
+  line = output_buffer.substr(0, end);
+  output_buffer.erase(0, end + 1);
+  return true;
+}
+
+#endif
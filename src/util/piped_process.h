@@ -0,0 +1,57 @@
+/*******************************************************************\
+
+Module: Subprocess Communication via Pipes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// A child process whose standard input and output are connected to the
+/// caller by pipes, for solvers that stay running across several queries.
+
+#ifndef CPROVER_UTIL_PIPED_PROCESS_H
+#define CPROVER_UTIL_PIPED_PROCESS_H
+
+#include <string>
+#include <vector>
+
+class piped_processt
+{
+public:
+  /// Starts the executable \p argv[0] with the arguments \p argv, which is
+  /// searched for in the PATH as by \ref run.
+  /// \throws system_exceptiont if the process cannot be started
+  explicit piped_processt(const std::vector<std::string> &argv);
+
+  piped_processt(const piped_processt &) = delete;
+  piped_processt &operator=(const piped_processt &) = delete;
+
+  /// Closes the standard input of the process and waits for it to exit
+  ~piped_processt();
+
+  /// Queues \p data to be written to the standard input of the process,
+  /// which happens once enough has been queued, or on \ref flush
+  void send(const std::string &data);
+
+  /// Writes all queued data to the process
+  /// \return false if the process no longer reads its input
+  bool flush();
+
+  /// Flushes the queued input and reads one line of the standard output of
+  /// the process, without the line break
+  /// \return false if the process has closed its output
+  bool read_line(std::string &line);
+
+protected:
+  std::string input_buffer;
+  std::string output_buffer;
+
+#ifndef _WIN32
+  int child_pid = -1;
+  int input_fd = -1;
+  int output_fd = -1;
+#endif
+};
+
+#endif // CPROVER_UTIL_PIPED_PROCESS_H
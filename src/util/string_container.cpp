@@ -77,6 +77,27 @@ unsigned string_containert::get(const std::string &s)
   return r;
 }
 
+unsigned string_containert::get(const string_ptrt &s)
+{
+  hash_tablet::iterator it = hash_table.find(s);
+
+  if(it != hash_table.end())
+    return it->second;
+
+  size_t r = hash_table.size();
+
+  // these are stable
+  string_list.push_back(std::string(s.s, s.len));
+  string_ptrt result(string_list.back());
+
+  hash_table[result] = r;
+
+  // these are not
+  string_vector.push_back(&string_list.back());
+
+  return r;
+}
+
 void string_container_statisticst::dump_on_stream(std::ostream &out) const
 {
   auto total_memory_usage = strings_memory_usage + vector_memory_usage +
@@ -35,6 +35,12 @@ struct string_ptrt
   {
   }
 
+  /// The \p _len characters starting at \p _s, which need not be
+  /// null-terminated
+  string_ptrt(const char *_s, size_t _len) : s(_s), len(_len)
+  {
+  }
+
   bool operator==(const string_ptrt &other) const;
 };
 
@@ -42,7 +48,10 @@ struct string_ptrt
 class string_ptr_hash
 {
 public:
-  size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
+  size_t operator()(const string_ptrt s) const
+  {
+    return hash_string(s.s, s.len);
+  }
 };
 
 /// Has estimated statistics about string container
@@ -73,6 +82,11 @@ public:
     return get(s);
   }
 
+  unsigned operator[](const string_ptrt &s)
+  {
+    return get(s);
+  }
+
   // constructor and destructor
   string_containert();
   ~string_containert();
@@ -99,6 +113,7 @@ protected:
 
   unsigned get(const char *s);
   unsigned get(const std::string &s);
+  unsigned get(const string_ptrt &s);
 
   typedef std::list<std::string> string_listt;
   string_listt string_list;
@@ -31,3 +31,13 @@ size_t hash_string(const char *s)
 
   return h;
 }
+
+size_t hash_string(const char *s, std::size_t len)
+{
+  size_t h=0;
+
+  for(const char *end=s+len; s!=end; s++)
+    h=(h<<5)-h+*s;
+
+  return h;
+}
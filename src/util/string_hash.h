@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 size_t hash_string(const std::string &s);
 size_t hash_string(const char *s);
+size_t hash_string(const char *s, std::size_t len);
 
 // NOLINTNEXTLINE(readability/identifiers)
 struct string_hash
@@ -186,6 +186,16 @@ public:
   }
 };
 
+/// Evaluates \p bdd for the assignment that gives variable `v` the value of
+/// bit `v-1` of \p assignment
+static bool evaluate(const mini_bddt &bdd, unsigned assignment)
+{
+  const mini_bddt *u = &bdd;
+  while(!u->is_constant())
+    u = ((assignment >> (u->var() - 1)) & 1) != 0 ? &u->high() : &u->low();
+  return u->is_true();
+}
+
 SCENARIO("miniBDD", "[core][solver][miniBDD]")
 {
   GIVEN("A bdd for x&!x")
@@ -327,6 +337,129 @@ SCENARIO("miniBDD", "[core][solver][miniBDD]")
     REQUIRE(oss.str() == dot_string);
   }
 
+  GIVEN("BDDs built with ite and with the Boolean operators")
+  {
+    mini_bdd_mgrt mgr;
+    std::vector<mini_bddt> vars;
+    for(unsigned i = 0; i < 5; i++)
+      vars.push_back(mgr.Var("x" + std::to_string(i)));
+
+    // all functions of the form (xi op xj), and their combinations
+    std::vector<mini_bddt> functions{mgr.True(), mgr.False()};
+    for(const auto &x : vars)
+    {
+      for(const auto &y : vars)
+      {
+        functions.push_back(x & !y);
+        functions.push_back(x ^ y);
+        functions.push_back((x | y) == vars[2]);
+      }
+    }
+
+    THEN("ite agrees with its definition")
+    {
+      for(std::size_t i = 0; i < functions.size(); i += 3)
+      {
+        for(std::size_t j = 1; j < functions.size(); j += 5)
+        {
+          for(std::size_t k = 2; k < functions.size(); k += 7)
+          {
+            const mini_bddt &f = functions[i];
+            const mini_bddt &g = functions[j];
+            const mini_bddt &h = functions[k];
+            const mini_bddt result = mgr.ite(f, g, h);
+            const mini_bddt expected = (f & g) | (!f & h);
+            REQUIRE(result.node_number() == expected.node_number());
+            for(unsigned a = 0; a < 32; a++)
+            {
+              REQUIRE(
+                evaluate(result, a) ==
+                (evaluate(f, a) ? evaluate(g, a) : evaluate(h, a)));
+            }
+          }
+        }
+      }
+    }
+
+    THEN("unreferenced nodes are freed and the BDDs stay canonical")
+    {
+      const std::size_t nodes_before = mgr.number_of_nodes();
+      {
+        mini_bddt parity = mgr.False();
+        for(const auto &x : vars)
+          parity = parity ^ x;
+        REQUIRE(mgr.number_of_nodes() > nodes_before);
+      }
+
+      // the nodes of parity are freed when collecting garbage
+      mgr.collect_garbage();
+      REQUIRE(mgr.number_of_nodes() == nodes_before);
+
+      for(const auto &x : vars)
+      {
+        for(const auto &y : vars)
+        {
+          REQUIRE((x ^ y).node_number() == (!(x == y)).node_number());
+          REQUIRE((x & !y).node_number() == (!(!x | y)).node_number());
+        }
+      }
+    }
+  }
+
+  GIVEN("A BDD with a bad variable order")
+  {
+    mini_bdd_mgrt mgr;
+    const unsigned n = 4;
+    std::vector<mini_bddt> a, b;
+    for(unsigned i = 0; i < n; i++)
+      a.push_back(mgr.Var("a" + std::to_string(i)));
+    for(unsigned i = 0; i < n; i++)
+      b.push_back(mgr.Var("b" + std::to_string(i)));
+
+    // (a0 & b0) | (a1 & b1) | ... needs exponentially many nodes when all
+    // a's come before all b's
+    mini_bddt f = mgr.False();
+    for(unsigned i = 0; i < n; i++)
+      f = f | (a[i] & b[i]);
+
+    const std::size_t nodes_before = mgr.number_of_nodes();
+
+    WHEN("the variables are reordered")
+    {
+      mgr.reorder();
+
+      THEN("there are fewer nodes and the function is the same")
+      {
+        // at most the nodes of the variables, of f, and the terminals
+        REQUIRE(mgr.number_of_nodes() < nodes_before);
+        REQUIRE(mgr.number_of_nodes() <= 2 * n + 2 * n + 2);
+
+        for(unsigned assignment = 0; assignment < (1u << (2 * n));
+            assignment++)
+        {
+          bool expected = false;
+          for(unsigned i = 0; i < n; i++)
+          {
+            expected |=
+              ((assignment >> i) & 1) != 0 && ((assignment >> (n + i)) & 1);
+          }
+          REQUIRE(evaluate(f, assignment) == expected);
+        }
+      }
+
+      THEN("the BDDs stay canonical")
+      {
+        mini_bddt g = mgr.False();
+        for(unsigned i = n; i > 0; i--)
+          g = (b[i - 1] & a[i - 1]) | g;
+        REQUIRE(g.node_number() == f.node_number());
+        REQUIRE(
+          mgr.ite(a[0], b[0], mgr.False()).node_number() ==
+          (a[0] & b[0]).node_number());
+      }
+    }
+  }
+
   GIVEN("A bdd for (a&b)|!a")
   {
     symbol_exprt a("a", bool_typet());
@@ -0,0 +1,234 @@
+/*******************************************************************\
+
+Module: Unit tests for the multiplier and divider encodings of bv_utilst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for the multiplier and divider encodings of bv_utilst
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/flattening/bv_utils.h>
+#include <solvers/sat/satcheck.h>
+
+#include <random>
+
+static const std::vector<bv_utilst::multipliert> multipliers = {
+  bv_utilst::multipliert::SHIFT_ADD,
+  bv_utilst::multipliert::WALLACE,
+  bv_utilst::multipliert::DADDA,
+  bv_utilst::multipliert::BOOTH_RADIX4,
+  bv_utilst::multipliert::KARATSUBA};
+
+static const std::vector<bv_utilst::dividert> dividers = {
+  bv_utilst::dividert::CONSTRAINTS,
+  bv_utilst::dividert::NON_RESTORING};
+
+static std::uint64_t value(const propt &prop, const bvt &bv)
+{
+  std::uint64_t result = 0;
+  for(std::size_t i = 0; i < bv.size(); i++)
+    if(prop.l_get(bv[i]).is_true())
+      result |= std::uint64_t(1) << i;
+  return result;
+}
+
+static std::int64_t signed_value(std::uint64_t bits, std::size_t width)
+{
+  const std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+  const bool negative = (bits >> (width - 1)) & 1;
+  return static_cast<std::int64_t>(negative ? bits | ~mask : bits);
+}
+
+SCENARIO("bv_utilst multipliers", "[core][solvers][flattening][bv_utils]")
+{
+  GIVEN("Random values of bit-vector variables")
+  {
+    std::mt19937_64 gen(42);
+
+    THEN("all encodings yield the truncated product")
+    {
+      // 5 bits are below the minimum width for the selected encodings, 17
+      // bits are split unevenly by the Karatsuba multiplier, and 33 bits are
+      // split into halves that are split again
+      for(const std::size_t width : {5, 17, 33})
+      {
+        const std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+
+        for(const auto encoding : multipliers)
+        {
+          for(unsigned i = 0; i < 20; i++)
+          {
+            satcheckt satcheck(null_message_handler);
+            bv_utilst bv_utils(satcheck);
+            bv_utils.set_multiplier(encoding);
+            bv_utils.set_encoding_min_width(8);
+
+            const std::uint64_t x = gen() & mask, y = gen() & mask;
+            const bvt op0 = satcheck.new_variables(width);
+            const bvt op1 = satcheck.new_variables(width);
+            const bvt constant = bv_utilst::build_constant(y, width);
+            bv_utils.set_equal(op0, bv_utilst::build_constant(x, width));
+            bv_utils.set_equal(op1, constant);
+
+            const bvt unsigned_product = bv_utils.multiplier(
+              op0, op1, bv_utilst::representationt::UNSIGNED);
+            const bvt signed_product = bv_utils.multiplier(
+              op0, op1, bv_utilst::representationt::SIGNED);
+            const bvt constant_product = bv_utils.multiplier(
+              op0, constant, bv_utilst::representationt::UNSIGNED);
+
+            REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+            REQUIRE(value(satcheck, unsigned_product) == ((x * y) & mask));
+            REQUIRE(value(satcheck, signed_product) == ((x * y) & mask));
+            REQUIRE(value(satcheck, constant_product) == ((x * y) & mask));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("bv_utilst dividers", "[core][solvers][flattening][bv_utils]")
+{
+  GIVEN("Random values of bit-vector variables")
+  {
+    std::mt19937_64 gen(42);
+    const std::size_t width = 9;
+    const std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+
+    THEN("all encodings yield quotient and remainder")
+    {
+      for(const auto encoding : dividers)
+      {
+        for(unsigned i = 0; i < 20; i++)
+        {
+          satcheckt satcheck(null_message_handler);
+          bv_utilst bv_utils(satcheck);
+          bv_utils.set_divider(encoding);
+
+          // the divisor is odd, and not all ones, which avoids division by
+          // zero as well as INT_MIN / -1
+          const std::uint64_t x = gen() & mask;
+          const std::uint64_t y = ((gen() & mask) | 1) & ~std::uint64_t(2);
+          const bvt op0 = satcheck.new_variables(width);
+          const bvt op1 = satcheck.new_variables(width);
+          bv_utils.set_equal(op0, bv_utilst::build_constant(x, width));
+          bv_utils.set_equal(op1, bv_utilst::build_constant(y, width));
+
+          bvt res, rem, signed_res, signed_rem;
+          bv_utils.divider(
+            op0, op1, res, rem, bv_utilst::representationt::UNSIGNED);
+          bv_utils.divider(
+            op0,
+            op1,
+            signed_res,
+            signed_rem,
+            bv_utilst::representationt::SIGNED);
+
+          const std::int64_t sx = signed_value(x, width);
+          const std::int64_t sy = signed_value(y, width);
+
+          REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+          REQUIRE(value(satcheck, res) == x / y);
+          REQUIRE(value(satcheck, rem) == x % y);
+          REQUIRE(
+            value(satcheck, signed_res) == (std::uint64_t(sx / sy) & mask));
+          REQUIRE(
+            value(satcheck, signed_rem) == (std::uint64_t(sx % sy) & mask));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "bv_utilst constant propagation",
+  "[core][solvers][flattening][bv_utils]")
+{
+  GIVEN("Bit-vectors sharing bits with each other and with constants")
+  {
+    std::mt19937_64 random(42);
+    const std::size_t width = 8;
+    const std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+    const auto rep = bv_utilst::representationt::SIGNED;
+
+    THEN("comparisons and sums are computed correctly")
+    {
+      for(std::size_t trial = 0; trial < 50; trial++)
+      {
+        satcheckt satcheck(null_message_handler);
+        bv_utilst bv_utils(satcheck);
+
+        const bvt op0 = satcheck.new_variables(width);
+        bvt op1 = satcheck.new_variables(width);
+
+        // each bit of op1 is its own, a constant, or a bit of op0
+        for(std::size_t i = 0; i < width; i++)
+        {
+          switch(random() % 4)
+          {
+          case 0:
+            break;
+          case 1:
+            op1[i] = const_literal(random() % 2 == 0);
+            break;
+          case 2:
+            op1[i] = op0[random() % width];
+            break;
+          default:
+            op1[i] = !op0[random() % width];
+          }
+        }
+
+        const literalt lt = bv_utils.rel(op0, ID_lt, op1, rep);
+        const literalt le = bv_utils.rel(op0, ID_le, op1, rep);
+        const literalt ult =
+          bv_utils.rel(op0, ID_lt, op1, bv_utilst::representationt::UNSIGNED);
+        const literalt equal = bv_utils.equal(op0, op1);
+        const bvt sum = bv_utils.add(op0, op1);
+        const bvt difference = bv_utils.sub(op0, op1);
+
+        const std::uint64_t x = random() & mask;
+        for(std::size_t i = 0; i < width; i++)
+          satcheck.l_set_to(op0[i], (x >> i) & 1);
+
+        REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+
+        const std::uint64_t y = value(satcheck, op1);
+        const std::int64_t sx = signed_value(x, width);
+        const std::int64_t sy = signed_value(y, width);
+        REQUIRE(satcheck.l_get(lt).is_true() == (sx < sy));
+        REQUIRE(satcheck.l_get(le).is_true() == (sx <= sy));
+        REQUIRE(satcheck.l_get(ult).is_true() == (x < y));
+        REQUIRE(satcheck.l_get(equal).is_true() == (x == y));
+        REQUIRE(value(satcheck, sum) == ((x + y) & mask));
+        REQUIRE(value(satcheck, difference) == ((x - y) & mask));
+      }
+    }
+  }
+
+  GIVEN("A zero-extended bit-vector and a constant beyond its range")
+  {
+    satcheckt satcheck(null_message_handler);
+    bv_utilst bv_utils(satcheck);
+
+    const bvt op = bv_utils.zero_extension(satcheck.new_variables(8), 32);
+    const bvt constant = bv_utilst::build_constant(256, 32);
+    const auto rep = bv_utilst::representationt::UNSIGNED;
+    const std::size_t variables = satcheck.no_variables();
+
+    THEN("the comparisons are decided without any gates")
+    {
+      REQUIRE(bv_utils.rel(op, ID_lt, constant, rep).is_true());
+      REQUIRE(bv_utils.rel(op, ID_ge, constant, rep).is_false());
+      REQUIRE(bv_utils.equal(op, constant).is_false());
+      REQUIRE(satcheck.no_variables() == variables);
+      REQUIRE(bv_utils.get_avoided_gates().variables > 0);
+    }
+  }
+}
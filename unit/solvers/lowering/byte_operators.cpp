@@ -435,3 +435,84 @@ SCENARIO("byte_update_lowering", "[core][solvers][lowering][byte_update]")
     }
   }
 }
+
+SCENARIO(
+  "aligned_byte_operator_lowering",
+  "[core][solvers][lowering][byte_extract][byte_update]")
+{
+  cmdlinet cmdline;
+  config.set(cmdline);
+
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet u16{16};
+  const struct_typet struct_type{{{"a", u16}, {"b", u16}}};
+  const symbol_exprt x{"x", struct_type};
+  const symbol_exprt y{"y", struct_type};
+
+  GIVEN("A byte_extract of a struct member at its offset")
+  {
+    const byte_extract_exprt be{
+      ID_byte_extract_little_endian, x, from_integer(2, index_type()), u16};
+
+    THEN("byte_extract lowering yields a member expression")
+    {
+      REQUIRE(lower_byte_extract(be, ns) == member_exprt{x, "b", u16});
+    }
+  }
+
+  GIVEN("A byte_extract of an array element as a same-width type")
+  {
+    const symbol_exprt a{"a", array_typet{u16, from_integer(4, size_type())}};
+    const signedbv_typet s16{16};
+    const byte_extract_exprt be{
+      ID_byte_extract_big_endian, a, from_integer(4, index_type()), s16};
+
+    THEN("byte_extract lowering reinterprets the element")
+    {
+      const exprt lower_be = lower_byte_extract(be, ns);
+
+      REQUIRE(!has_subexpr(lower_be, ID_byte_extract_big_endian));
+      REQUIRE(lower_be.type() == s16);
+      const index_exprt element{a, from_integer(2, index_type())};
+      REQUIRE(has_subexpr(
+        lower_be, [&element](const exprt &e) { return e == element; }));
+    }
+  }
+
+  GIVEN("A byte_update of a struct member at its offset")
+  {
+    const symbol_exprt v{"v", u16};
+    const byte_update_exprt bu{
+      ID_byte_update_little_endian, x, from_integer(2, index_type()), v};
+
+    THEN("byte_update lowering yields a with expression")
+    {
+      REQUIRE(
+        lower_byte_update(bu, ns) ==
+        with_exprt{x, member_designatort{"b"}, v});
+    }
+  }
+
+  GIVEN("Byte operators of the same shape on different objects")
+  {
+    const unsignedbv_typet u8{8};
+    const byte_extract_exprt be_x{
+      ID_byte_extract_little_endian, x, from_integer(1, index_type()), u8};
+    const byte_extract_exprt be_y{
+      ID_byte_extract_little_endian, y, from_integer(1, index_type()), u8};
+
+    THEN("The cache reuses the lowering for the second object")
+    {
+      byte_operator_lowering_cachet cache;
+
+      REQUIRE(
+        lower_byte_extract(be_x, ns, cache) == lower_byte_extract(be_x, ns));
+      REQUIRE(
+        lower_byte_extract(be_y, ns, cache) == lower_byte_extract(be_y, ns));
+      REQUIRE(cache.hits == 1);
+      REQUIRE(cache.misses == 1);
+    }
+  }
+}
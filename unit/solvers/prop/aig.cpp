@@ -0,0 +1,189 @@
+/*******************************************************************\
+
+Module: Unit tests for aigt, aig_prop_solvert and aig_sweept
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for aigt, aig_prop_solvert and aig_sweept
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/prop/aig.h>
+#include <solvers/prop/aig_prop.h>
+#include <solvers/prop/aig_sweep.h>
+#include <solvers/sat/satcheck_minisat2.h>
+#include <util/cout_message.h>
+#include <util/make_unique.h>
+
+SCENARIO("aig structural hashing", "[core][solvers][prop][aig]")
+{
+  aigt aig;
+  const literalt x = aig.new_var_node();
+  const literalt y = aig.new_var_node();
+  const literalt z = aig.new_var_node();
+
+  GIVEN("Two conjunctions of the same operands")
+  {
+    const literalt a = aig.new_and_node(x, !y);
+    const literalt b = aig.new_and_node(!y, x);
+
+    THEN("they share a node")
+    {
+      REQUIRE(a == b);
+      REQUIRE(aig.number_of_and_nodes() == 1);
+      REQUIRE(aig.structural_hash_hits() == 1);
+    }
+  }
+
+  GIVEN("Constant and trivial operands")
+  {
+    THEN("no nodes are created")
+    {
+      REQUIRE(aig.new_and_node(x, const_literal(true)) == x);
+      REQUIRE(aig.new_and_node(x, const_literal(false)).is_false());
+      REQUIRE(aig.new_and_node(x, x) == x);
+      REQUIRE(aig.new_and_node(x, !x).is_false());
+      REQUIRE(aig.number_of_and_nodes() == 0);
+    }
+  }
+
+  GIVEN("Operands related through their children")
+  {
+    const literalt xy = aig.new_and_node(x, y);
+
+    THEN("the two-level rules apply")
+    {
+      // contradiction
+      REQUIRE(aig.new_and_node(xy, !x).is_false());
+      // idempotence
+      REQUIRE(aig.new_and_node(xy, y) == xy);
+      // subsumption
+      REQUIRE(aig.new_and_node(!xy, !y) == !y);
+      // substitution
+      REQUIRE(aig.new_and_node(!xy, x) == aig.new_and_node(x, !y));
+      // resolution
+      REQUIRE(aig.new_and_node(!xy, !aig.new_and_node(x, !y)) == !x);
+      // contradiction between two conjunctions
+      REQUIRE(aig.new_and_node(xy, aig.new_and_node(!y, z)).is_false());
+    }
+  }
+}
+
+#ifdef HAVE_MINISAT2
+
+SCENARIO("aig_prop_solvert", "[core][solvers][prop][aig_prop_solvert]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  aig_prop_solvert aig_prop(
+    util_make_unique<satcheck_minisat_no_simplifiert>(message_handler),
+    message_handler);
+
+  const literalt a = aig_prop.new_variable();
+  const literalt b = aig_prop.new_variable();
+  const literalt c = aig_prop.new_variable();
+
+  GIVEN("Equivalent formulas built in different ways")
+  {
+    const literalt f1 = aig_prop.lxor(a, b);
+    const literalt f2 = aig_prop.lor(aig_prop.land(a, !b), aig_prop.land(!a, b));
+
+    THEN("they cannot differ")
+    {
+      aig_prop.l_set_to_true(aig_prop.lxor(f1, f2));
+      REQUIRE(aig_prop.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+    }
+  }
+
+  GIVEN("A satisfiable multiplexer constraint")
+  {
+    aig_prop.l_set_to_true(aig_prop.lselect(a, b, c));
+    aig_prop.l_set_to_true(a);
+    aig_prop.lcnf(!b, c);
+
+    THEN("the model satisfies the constraints")
+    {
+      REQUIRE(aig_prop.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(aig_prop.l_get(a).is_true());
+      REQUIRE(aig_prop.l_get(b).is_true());
+      REQUIRE(aig_prop.l_get(c).is_true());
+      REQUIRE(aig_prop.l_get(aig_prop.lselect(a, b, c)).is_true());
+    }
+
+    THEN("further constraints are added incrementally")
+    {
+      REQUIRE(aig_prop.prop_solve() == propt::resultt::P_SATISFIABLE);
+      aig_prop.l_set_to_false(c);
+      REQUIRE(aig_prop.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+    }
+
+    THEN("assumptions are forwarded")
+    {
+      aig_prop.set_assumptions({!c});
+      REQUIRE(aig_prop.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+      aig_prop.set_assumptions({});
+      REQUIRE(aig_prop.prop_solve() == propt::resultt::P_SATISFIABLE);
+    }
+  }
+}
+
+SCENARIO("aig_sweept", "[core][solvers][prop][aig_sweept]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  aigt aig;
+  aig_sweept sweeper(
+    aig,
+    [](message_handlert &solver_message_handler) {
+      return util_make_unique<satcheck_minisat_no_simplifiert>(
+        solver_message_handler);
+    },
+    std::chrono::seconds(10),
+    message_handler);
+
+  const literalt x = aig.new_var_node();
+  const literalt y = aig.new_var_node();
+
+  GIVEN("Exclusive-or built in two structurally different ways")
+  {
+    // !(x & !y) & !(!x & y) is x == y
+    const literalt f1 =
+      aig.new_and_node(!aig.new_and_node(x, !y), !aig.new_and_node(!x, y));
+    // (x | y) & !(x & y) is x != y
+    const literalt f2 = aig.new_and_node(
+      !aig.new_and_node(!x, !y), !aig.new_and_node(x, y));
+
+    sweeper.sweep({f1, f2}, [](literalt::var_not) { return true; });
+
+    THEN("the later node is replaced by the negation of the earlier one")
+    {
+      REQUIRE(f1.var_no() < f2.var_no());
+      REQUIRE(sweeper.get_replacement(f2.var_no()) == !f1);
+      REQUIRE(sweeper.number_of_merged_nodes() == 1);
+    }
+  }
+
+  GIVEN("A node that is constant")
+  {
+    // (x & y) & z and x & (y & z) are structurally different
+    const literalt xy = aig.new_and_node(x, y);
+    const literalt z = aig.new_var_node();
+    const literalt f = aig.new_and_node(
+      aig.new_and_node(xy, z), !aig.new_and_node(x, aig.new_and_node(y, z)));
+
+    sweeper.sweep({f}, [](literalt::var_not) { return true; });
+
+    THEN("it is replaced by the constant")
+    {
+      REQUIRE(!f.is_constant());
+      REQUIRE(sweeper.get_replacement(f.var_no()).is_false());
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*******************************************************************\
+
+Module: Unit tests for prop_minimizet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for prop_minimizet
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/prop/prop_conv_solver.h>
+#include <solvers/prop/prop_minimize.h>
+#include <solvers/sat/satcheck.h>
+
+#include <random>
+
+static const std::size_t n = 8;
+
+typedef std::vector<bvt> clausest;
+
+/// Random clauses over the variables 1 to n that are satisfied by a random
+/// assignment
+static clausest random_clauses(std::mt19937 &random)
+{
+  clausest clauses;
+  const std::size_t planted = random() % (std::size_t(1) << n);
+
+  for(std::size_t i = 0; i < 2 * n; i++)
+  {
+    bvt clause;
+    bool satisfied = false;
+
+    for(std::size_t j = 0; j < 2 + random() % 2; j++)
+    {
+      const std::size_t v = random() % n;
+      const bool sign = random() % 2 == 0;
+      clause.push_back(literalt(v + 1, sign));
+      satisfied |= ((planted >> v) & 1) != sign;
+    }
+
+    if(satisfied)
+      clauses.push_back(clause);
+  }
+
+  return clauses;
+}
+
+/// \return true iff \p clauses have a model in which the variables in
+///   \p mask are false
+static bool
+satisfiable_with_false(const clausest &clauses, std::size_t mask)
+{
+  for(std::size_t assignment = 0; assignment < (std::size_t(1) << n);
+      assignment++)
+  {
+    if((assignment & mask) != 0)
+      continue;
+
+    bool satisfies = true;
+    for(const auto &clause : clauses)
+    {
+      bool satisfied = false;
+      for(const auto &literal : clause)
+      {
+        const bool value = (assignment >> (literal.var_no() - 1)) & 1;
+        satisfied |= value != literal.sign();
+      }
+      satisfies &= satisfied;
+    }
+
+    if(satisfies)
+      return true;
+  }
+
+  return false;
+}
+
+static std::size_t count_bits(std::size_t mask)
+{
+  std::size_t count = 0;
+  for(; mask != 0; mask >>= 1)
+    count += mask & 1;
+  return count;
+}
+
+/// Minimizes the number of true variables with \p strategy
+/// \return the mask of the variables that are false in the model
+static std::size_t minimize(
+  const clausest &clauses,
+  prop_minimizet::strategyt strategy)
+{
+  satcheck_no_simplifiert satcheck(null_message_handler);
+  const bvt variables = satcheck.new_variables(n);
+  for(const auto &clause : clauses)
+    satcheck.lcnf(clause);
+
+  prop_conv_solvert solver(satcheck, null_message_handler);
+  prop_minimizet prop_minimize(solver, null_message_handler);
+  REQUIRE(
+    prop_minimize.get_strategy() == prop_minimizet::strategyt::CORE_GUIDED);
+  prop_minimize.set_strategy(strategy);
+
+  for(const auto &variable : variables)
+    prop_minimize.objective(variable);
+
+  prop_minimize();
+
+  std::size_t mask = 0;
+  for(std::size_t i = 0; i < n; i++)
+  {
+    if(solver.l_get(variables[i]).is_false())
+      mask |= std::size_t(1) << i;
+  }
+
+  REQUIRE(prop_minimize.number_satisfied() == count_bits(mask));
+  REQUIRE(satisfiable_with_false(clauses, mask));
+
+  return mask;
+}
+
+SCENARIO("prop_minimizet", "[core][solvers][prop][prop_minimize]")
+{
+  GIVEN("Random satisfiable clauses and one objective per variable")
+  {
+    std::mt19937 random(7);
+    std::vector<clausest> problems;
+    for(std::size_t i = 0; i < 20; i++)
+      problems.push_back(random_clauses(random));
+
+    THEN("the core-guided strategy sets the most variables to false")
+    {
+      for(const auto &clauses : problems)
+      {
+        const std::size_t mask =
+          minimize(clauses, prop_minimizet::strategyt::CORE_GUIDED);
+
+        for(std::size_t other = 0; other < (std::size_t(1) << n); other++)
+        {
+          if(count_bits(other) > count_bits(mask))
+            REQUIRE_FALSE(satisfiable_with_false(clauses, other));
+        }
+      }
+    }
+
+    THEN("linear search sets a maximal set of variables to false")
+    {
+      for(const auto &clauses : problems)
+      {
+        const std::size_t mask =
+          minimize(clauses, prop_minimizet::strategyt::LINEAR_SEARCH);
+
+        for(std::size_t i = 0; i < n; i++)
+        {
+          const std::size_t bit = std::size_t(1) << i;
+          if((mask & bit) == 0)
+            REQUIRE_FALSE(satisfiable_with_false(clauses, mask | bit));
+        }
+      }
+    }
+  }
+
+  GIVEN("Objectives with constant conditions")
+  {
+    satcheck_no_simplifiert satcheck(null_message_handler);
+    const literalt variable = satcheck.new_variable();
+
+    prop_conv_solvert solver(satcheck, null_message_handler);
+    prop_minimizet prop_minimize(solver, null_message_handler);
+    prop_minimize.objective(const_literal(false), 2);
+    prop_minimize.objective(const_literal(true), 2);
+    prop_minimize.objective(variable, 1);
+
+    THEN("the core-guided strategy only asks the solver about the variable")
+    {
+      prop_minimize();
+
+      REQUIRE(prop_minimize.number_satisfied() == 2);
+      REQUIRE(prop_minimize.iterations() == 1);
+      REQUIRE(solver.l_get(variable).is_false());
+    }
+  }
+}
@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unit tests for clause_arenat
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for clause_arenat
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/sat/cnf_clause_list.h>
+
+SCENARIO("clause_arenat", "[core][solvers][sat][cnf_clause_list]")
+{
+  GIVEN("Clauses of different lengths")
+  {
+    const std::vector<bvt> clauses = {{literalt(1, false), literalt(2, true)},
+                                      {},
+                                      {literalt(3, false)},
+                                      {literalt(1, true),
+                                       literalt(2, false),
+                                       literalt(4, true)}};
+
+    clause_arenat arena;
+    for(const auto &clause : clauses)
+      arena.push_back(clause);
+
+    THEN("Iterating the arena gives the same clauses")
+    {
+      REQUIRE(arena.size() == clauses.size());
+
+      std::size_t i = 0;
+      for(const auto &clause : arena)
+      {
+        REQUIRE(bvt(clause.begin(), clause.end()) == clauses[i]);
+        REQUIRE(arena[i].size() == clauses[i].size());
+        ++i;
+      }
+      REQUIRE(i == clauses.size());
+    }
+
+    THEN("A clause of the arena itself can be appended to it")
+    {
+      // enough copies to make the buffer grow at least once
+      for(std::size_t copy = 0; copy < 64; ++copy)
+        arena.push_back(arena[3]);
+
+      REQUIRE(arena.size() == clauses.size() + 64);
+      for(std::size_t i = clauses.size(); i < arena.size(); ++i)
+      {
+        REQUIRE(
+          bvt(arena[i].begin(), arena[i].end()) == clauses.back());
+      }
+    }
+
+    THEN("Clearing the arena leaves no clauses")
+    {
+      arena.clear();
+      REQUIRE(arena.empty());
+      REQUIRE(arena.begin() == arena.end());
+    }
+  }
+}
@@ -0,0 +1,132 @@
+/*******************************************************************\
+
+Module: Unit tests for cnf_preprocessort
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for cnf_preprocessort
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/sat/cnf_preprocessor.h>
+#include <solvers/sat/satcheck.h>
+
+#include <util/make_unique.h>
+
+#include <random>
+
+typedef std::vector<bvt> clausest;
+
+/// \return true iff \p clauses over \p n variables have a model that
+///   satisfies \p assumptions
+static bool
+satisfiable(const clausest &clauses, std::size_t n, const bvt &assumptions)
+{
+  for(std::size_t assignment = 0; assignment < (std::size_t(1) << n);
+      assignment++)
+  {
+    const auto value = [assignment](literalt l) {
+      return ((assignment >> (l.var_no() - 1)) & 1) != l.sign();
+    };
+
+    bool satisfies = true;
+    for(const auto &l : assumptions)
+      satisfies &= value(l);
+
+    for(const auto &clause : clauses)
+    {
+      bool satisfied = false;
+      for(const auto &l : clause)
+        satisfied |= value(l);
+      satisfies &= satisfied;
+    }
+
+    if(satisfies)
+      return true;
+  }
+
+  return false;
+}
+
+SCENARIO("cnf_preprocessort", "[core][solvers][sat][cnf_preprocessor]")
+{
+  GIVEN("Random clauses that are added before and between solver calls")
+  {
+    std::mt19937 random(3);
+
+    THEN("the results and models agree with the clauses")
+    {
+      for(std::size_t problem = 0; problem < 200; problem++)
+      {
+        const std::size_t n = 4 + random() % 8;
+        cnf_preprocessort cnf_preprocessor(
+          util_make_unique<satcheck_no_simplifiert>(null_message_handler),
+          null_message_handler);
+        const bvt variables = cnf_preprocessor.new_variables(n);
+        clausest clauses;
+
+        const auto add_clauses = [&](std::size_t number) {
+          for(std::size_t i = 0; i < number; i++)
+          {
+            bvt clause;
+            for(std::size_t j = 1 + random() % 3; j > 0; j--)
+            {
+              clause.push_back(
+                variables[random() % n] ^ (random() % 2 == 0));
+            }
+            clauses.push_back(clause);
+            cnf_preprocessor.lcnf(clause);
+          }
+
+          // equivalences are substituted
+          const literalt a = variables[random() % n];
+          const literalt b = variables[random() % n] ^ (random() % 2 == 0);
+          clauses.push_back({!a, b});
+          clauses.push_back({a, !b});
+          cnf_preprocessor.lcnf({!a, b});
+          cnf_preprocessor.lcnf({a, !b});
+        };
+
+        add_clauses(n + random() % (2 * n));
+        cnf_preprocessor.set_frozen(variables[random() % n]);
+
+        for(std::size_t solve = 0; solve < 3; solve++)
+        {
+          bvt assumptions;
+          if(random() % 2 == 0)
+          {
+            assumptions.push_back(
+              variables[random() % n] ^ (random() % 2 == 0));
+          }
+          cnf_preprocessor.set_assumptions(assumptions);
+
+          const propt::resultt result = cnf_preprocessor.prop_solve();
+          REQUIRE(
+            (result == propt::resultt::P_SATISFIABLE) ==
+            satisfiable(clauses, n, assumptions));
+
+          if(result == propt::resultt::P_SATISFIABLE)
+          {
+            for(const auto &l : assumptions)
+              REQUIRE(cnf_preprocessor.l_get(l).is_true());
+
+            for(const auto &clause : clauses)
+            {
+              bool satisfied = false;
+              for(const auto &l : clause)
+                satisfied |= cnf_preprocessor.l_get(l).is_true();
+              REQUIRE(satisfied);
+            }
+          }
+
+          // these may refer to variables removed by preprocessing
+          add_clauses(1 + random() % 3);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Unit tests for dimacs_cnf_streamt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for dimacs_cnf_streamt
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/sat/dimacs_cnf.h>
+
+#include <sstream>
+
+/// Adds the same clauses to \p cnf as to \p expected
+static void add_clauses(cnft &cnf, dimacs_cnft &expected)
+{
+  for(propt *prop : std::vector<propt *>{&cnf, &expected})
+  {
+    const bvt v = prop->new_variables(4);
+    prop->lcnf({v[0], !v[1]});
+    prop->lcnf({v[1], v[2], !v[3]});
+    // tautologies are dropped
+    prop->lcnf({v[2], !v[2]});
+    prop->lcnf({v[3], !v[0], v[3]});
+  }
+}
+
+/// \return the lines of \p text with trailing white space removed
+static std::string trim_lines(const std::string &text)
+{
+  std::istringstream in(text);
+  std::ostringstream out;
+  for(std::string line; std::getline(in, line);)
+    out << line.substr(0, line.find_last_not_of(' ') + 1) << '\n';
+  return out.str();
+}
+
+SCENARIO("dimacs_cnf_streamt", "[core][solvers][sat][dimacs_cnf]")
+{
+  GIVEN("Clauses written while they are added")
+  {
+    dimacs_cnft expected(null_message_handler);
+    std::ostringstream expected_out;
+
+    std::ostringstream out;
+    out << "c before\n";
+    dimacs_cnf_streamt dimacs_cnf_stream(out, null_message_handler);
+    add_clauses(dimacs_cnf_stream, expected);
+
+    WHEN("The problem line is completed")
+    {
+      dimacs_cnf_stream.write_dimacs_cnf(out);
+      out << "c after\n";
+      expected.write_dimacs_cnf(expected_out);
+
+      THEN("The output is that of dimacs_cnft")
+      {
+        REQUIRE(dimacs_cnf_stream.no_clauses() == expected.no_clauses());
+        REQUIRE(
+          trim_lines(out.str()) ==
+          "c before\n" + expected_out.str() + "c after\n");
+      }
+    }
+  }
+}
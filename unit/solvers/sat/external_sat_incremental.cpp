@@ -0,0 +1,99 @@
+/*******************************************************************\
+
+Module: Unit tests for external_sat_incremental.h
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/cout_message.h>
+#include <util/tempfile.h>
+
+#include <solvers/sat/external_sat_incremental.h>
+
+#ifndef _WIN32
+#  include <csignal>
+#  include <fstream>
+
+/// Writes a shell script that implements the `solve` and `value` commands of
+/// the protocol: `solve` is answered by the next line of \p answers, and
+/// `value` assigns true to all variables.
+static void
+write_fake_solver(const std::string &file_name, const std::string &answers)
+{
+  std::ofstream script(file_name);
+  script << "answers='" << answers << "'\n"
+         << "while read command arguments; do\n"
+         << "  case \"$command\" in\n"
+         << "  solve)\n"
+         << "    answer=\"${answers%%,*}\"\n"
+         << "    answers=\"${answers#*,}\"\n"
+         << "    echo \"s $answer\" ;;\n"
+         << "  value)\n"
+         << "    echo \"v $arguments\" ;;\n"
+         << "  esac\n"
+         << "done\n";
+}
+
+SCENARIO(
+  "external_sat_incrementalt",
+  "[core][solvers][sat][external_sat_incremental]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  temporary_filet script("fake_solver", ".sh");
+
+  GIVEN("A solver that first gives up and then finds a model")
+  {
+    write_fake_solver(script(), "UNKNOWN,SATISFIABLE,");
+    external_sat_incrementalt solver(message_handler, "sh " + script());
+
+    const literalt a = solver.new_variable();
+    const literalt b = solver.new_variable();
+    solver.lcnf({a, b});
+
+    THEN("giving up is reported as unknown, not as an error")
+    {
+      REQUIRE(solver.prop_solve() == propt::resultt::P_UNKNOWN);
+      REQUIRE(solver.l_get(a) == tvt::unknown());
+
+      AND_THEN("the solver can be asked again")
+      {
+        REQUIRE(solver.prop_solve() == propt::resultt::P_SATISFIABLE);
+        REQUIRE(solver.l_get(a) == tvt(true));
+        REQUIRE(solver.l_get(!b) == tvt(false));
+      }
+    }
+  }
+
+  GIVEN("A solver that exits without reading its input")
+  {
+    std::ofstream(script()) << "exit 0\n";
+
+    struct sigaction before;
+    sigaction(SIGPIPE, nullptr, &before);
+
+    external_sat_incrementalt solver(message_handler, "sh " + script());
+
+    // enough clauses to fill the pipe once the solver has exited
+    const literalt a = solver.new_variable();
+    for(std::size_t i = 0; i < 100000; i++)
+      solver.lcnf({a, solver.new_variable()});
+
+    THEN("solving fails without terminating the caller by SIGPIPE")
+    {
+      REQUIRE(solver.prop_solve() == propt::resultt::P_ERROR);
+
+      AND_THEN("the handler of SIGPIPE is left unchanged")
+      {
+        struct sigaction after;
+        sigaction(SIGPIPE, nullptr, &after);
+        REQUIRE(after.sa_handler == before.sa_handler);
+      }
+    }
+  }
+}
+#endif
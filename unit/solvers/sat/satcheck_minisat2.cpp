@@ -82,6 +82,45 @@ SCENARIO("satcheck_minisat2", "[core][solvers][sat][satcheck_minisat2]")
       REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
     }
   }
+
+  GIVEN("A polarity-aware encoding of a & b used only positively")
+  {
+    satcheck_minisat_simplifiert satcheck(message_handler);
+    satcheck.set_polarity_aware_encoding(true);
+    literalt a = satcheck.new_variable();
+    literalt b = satcheck.new_variable();
+    literalt c = satcheck.new_variable();
+    literalt a_and_b = satcheck.land(a, b);
+    satcheck.lcnf(a_and_b, c);
+
+    THEN("the gate has the value of its inputs in a model")
+    {
+      satcheck.l_set_to_true(a);
+      satcheck.l_set_to_true(b);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(satcheck.l_get(a_and_b).is_true());
+    }
+    THEN("the gate can be used negatively after solving if it is frozen")
+    {
+      satcheck.set_frozen(a);
+      satcheck.set_frozen(b);
+      satcheck.set_frozen(a_and_b);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      satcheck.l_set_to_true(a);
+      satcheck.l_set_to_true(b);
+      satcheck.l_set_to_false(a_and_b);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+    }
+    THEN("assumptions are encoded in their polarity")
+    {
+      bvt assumptions;
+      assumptions.push_back(!a_and_b);
+      assumptions.push_back(a);
+      assumptions.push_back(b);
+      satcheck.set_assumptions(assumptions);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+    }
+  }
 }
 
 #endif
@@ -0,0 +1,117 @@
+/*******************************************************************\
+
+Module: Unit tests for letifyt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for letifyt
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/smt2/letify.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+
+/// Replaces the let symbols in \p expr by their values
+static exprt expand_lets(const exprt &expr)
+{
+  if(expr.id() == ID_let)
+  {
+    const let_exprt &let_expr = to_let_expr(expr);
+    exprt where = expand_lets(let_expr.where());
+    const exprt value = expand_lets(let_expr.value());
+    where.visit_pre([&let_expr, &value](exprt &e) {
+      if(e == let_expr.symbol())
+        e = value;
+    });
+    return where;
+  }
+
+  exprt result = expr;
+  for(auto &op : result.operands())
+    op = expand_lets(op);
+  return result;
+}
+
+static std::size_t count_lets(const exprt &expr)
+{
+  std::size_t count = 0;
+  for(const exprt *e = &expr; e->id() == ID_let;
+      e = &to_let_expr(*e).where())
+  {
+    count++;
+  }
+  return count;
+}
+
+SCENARIO("letifyt", "[core][solvers][smt2][letify]")
+{
+  const unsignedbv_typet type(8);
+  const symbol_exprt x("x", type);
+  const symbol_exprt y("y", type);
+
+  GIVEN("An expression without shared nodes")
+  {
+    const exprt expr = plus_exprt(x, mult_exprt(y, from_integer(2, type)));
+
+    THEN("no let is introduced")
+    {
+      letifyt letify;
+      REQUIRE(letify(expr) == expr);
+      REQUIRE(letify.get_number_of_lets() == 0);
+    }
+  }
+
+  GIVEN("An expression that uses a node twice")
+  {
+    const exprt sum = plus_exprt(x, y);
+    const exprt expr = mult_exprt(sum, minus_exprt(sum, x));
+
+    THEN("the node is bound by a let")
+    {
+      letifyt letify;
+      const exprt result = letify(expr);
+      REQUIRE(letify.get_number_of_lets() == 1);
+      REQUIRE(result.id() == ID_let);
+      REQUIRE(to_let_expr(result).value() == sum);
+      REQUIRE(expand_lets(result) == expr);
+    }
+  }
+
+  GIVEN("A deep DAG whose tree unfolding is exponential")
+  {
+    const std::size_t depth = 200;
+    exprt expr = x;
+    for(std::size_t i = 0; i < depth; i++)
+      expr = plus_exprt(expr, expr);
+
+    THEN("each shared level is bound by one let")
+    {
+      letifyt letify;
+      const exprt result = letify(expr);
+      REQUIRE(letify.get_number_of_lets() == depth - 1);
+      REQUIRE(count_lets(result) == depth - 1);
+    }
+  }
+
+  GIVEN("Two letified expressions")
+  {
+    const exprt sum = plus_exprt(x, y);
+    const exprt expr = mult_exprt(sum, sum);
+
+    THEN("their let symbols are distinct")
+    {
+      letifyt letify;
+      const exprt first = letify(expr);
+      const exprt second = letify(expr);
+      REQUIRE(
+        to_let_expr(first).symbol() != to_let_expr(second).symbol());
+      REQUIRE(expand_lets(first) == expr);
+      REQUIRE(expand_lets(second) == expr);
+    }
+  }
+}
@@ -0,0 +1,141 @@
+/*******************************************************************\
+
+Module: Unit tests for smt2irep
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for smt2irep
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/smt2/smt2irep.h>
+
+#include <sstream>
+
+/// A stream buffer that makes at most one character available at a time,
+/// as when reading the output of a solver through a pipe
+class trickle_streambuft : public std::streambuf
+{
+public:
+  explicit trickle_streambuft(const std::string &_text) : text(_text)
+  {
+  }
+
+protected:
+  std::string text;
+  std::size_t pos = 0;
+  char current;
+
+  int_type underflow() override
+  {
+    if(pos == text.size())
+      return traits_type::eof();
+
+    current = text[pos++];
+    setg(&current, &current, &current + 1);
+    return traits_type::to_int_type(current);
+  }
+
+  std::streamsize showmanyc() override
+  {
+    return 0;
+  }
+};
+
+static const std::string model =
+  "sat\n"
+  "; a comment\n"
+  "((x (_ bv5 8))\n"
+  " (|quoted\nsymbol| #b0101)\n"
+  " (s \"say \"\"hi\"\"\")\n"
+  " (:keyword 1.5))\n";
+
+static void check_model(smt2irept &parser)
+{
+  const auto sat = parser();
+  REQUIRE(sat.has_value());
+  REQUIRE(sat->id() == "sat");
+  REQUIRE(sat->get_sub().empty());
+
+  const auto values = parser();
+  REQUIRE(values.has_value());
+  REQUIRE(values->id().empty());
+  REQUIRE(values->get_sub().size() == 3);
+
+  const irept &x = values->get_sub()[0];
+  REQUIRE(x.get_sub()[0].id() == "x");
+  REQUIRE(x.get_sub()[1].get_sub()[0].id() == "_");
+  REQUIRE(x.get_sub()[1].get_sub()[1].id() == "bv5");
+  REQUIRE(x.get_sub()[1].get_sub()[2].id() == "8");
+
+  const irept &quoted = values->get_sub()[1];
+  REQUIRE(quoted.get_sub()[0].id() == "quoted\nsymbol");
+  REQUIRE(quoted.get_sub()[1].id() == "#b0101");
+
+  const irept &s = values->get_sub()[2];
+  REQUIRE(s.get_sub()[1].id() == "say \"hi\"");
+
+  REQUIRE_FALSE(parser().has_value());
+}
+
+TEST_CASE("smt2irep", "[core][solvers][smt2][smt2irep]")
+{
+  null_message_handlert message_handler;
+
+  SECTION("Reading from a buffer")
+  {
+    smt2irept parser(model.data(), model.size(), message_handler);
+    const auto sat = parser();
+    REQUIRE(sat.has_value());
+    REQUIRE(sat->id() == "sat");
+
+    // keywords are not expected in ireps
+    REQUIRE_FALSE(parser().has_value());
+  }
+
+  SECTION("Reading from a buffer that is not null-terminated")
+  {
+    const char text[] = {'(', 'a', 'b', ')'};
+    smt2irept parser(text, sizeof(text), message_handler);
+    const auto ab = parser();
+    REQUIRE(ab.has_value());
+    REQUIRE(ab->get_sub().size() == 1);
+    REQUIRE(ab->get_sub()[0].id() == "ab");
+    REQUIRE_FALSE(parser().has_value());
+  }
+
+  const std::string without_keyword =
+    model.substr(0, model.find(" (:keyword")) + ")\n";
+
+  SECTION("Reading several expressions from a buffer")
+  {
+    smt2irept parser(
+      without_keyword.data(), without_keyword.size(), message_handler);
+    check_model(parser);
+  }
+
+  SECTION("Reading several expressions from a stream")
+  {
+    std::istringstream in(without_keyword);
+    smt2irept parser(in, message_handler);
+    check_model(parser);
+  }
+
+  SECTION("Reading from a stream one character at a time")
+  {
+    trickle_streambuft streambuf(without_keyword);
+    std::istream in(&streambuf);
+    smt2irept parser(in, message_handler);
+    check_model(parser);
+  }
+
+  SECTION("Unterminated quoted symbol")
+  {
+    std::istringstream in("(a |b");
+    REQUIRE_FALSE(smt2irep(in, message_handler).has_value());
+  }
+}
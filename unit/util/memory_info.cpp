@@ -19,3 +19,14 @@ TEST_CASE("memory_info returns some output", "[core][util][memory_info]")
 
   REQUIRE(!oss.str().empty());
 }
+
+TEST_CASE(
+  "resident_set_size reports memory in use",
+  "[core][util][memory_info]")
+{
+#if defined(__linux__) || defined(_WIN32) || defined(__APPLE__)
+  REQUIRE(resident_set_size() > 0);
+#else
+  REQUIRE(resident_set_size() == 0);
+#endif
+}
@@ -0,0 +1,48 @@
+/*******************************************************************\
+
+Module: Unit test for piped_process.h/piped_process.cpp
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/piped_process.h>
+
+#ifndef _WIN32
+SCENARIO("piped_processt", "[core][util][piped_process]")
+{
+  GIVEN("A process that echoes its input")
+  {
+    piped_processt process({"cat"});
+
+    THEN("lines sent to it are read back one by one")
+    {
+      process.send("first line\nsecond");
+      process.send(" line\n");
+
+      std::string line;
+      REQUIRE(process.read_line(line));
+      REQUIRE(line == "first line");
+      REQUIRE(process.read_line(line));
+      REQUIRE(line == "second line");
+
+      process.send(std::string(10000, 'x') + "\n");
+      REQUIRE(process.read_line(line));
+      REQUIRE(line.size() == 10000);
+    }
+  }
+
+  GIVEN("A process that exits without reading its input")
+  {
+    piped_processt process({"true"});
+
+    THEN("reading from it fails")
+    {
+      std::string line;
+      REQUIRE_FALSE(process.read_line(line));
+    }
+  }
+}
+#endif